@@ -106,6 +106,10 @@ if "%rdi_breakpad_from_pdb%"=="1"      %compile%             ..\src\rdi_breakpad
 if "%ryan_scratch%"=="1"               %compile%             ..\src\scratch\ryan_scratch.c                                                %compile_link% %out%ryan_scratch.exe || exit /b 1
 if "%cpp_tests%"=="1"                  %compile%             ..\src\scratch\i_hate_c_plus_plus.cpp                                        %compile_link% %out%cpp_tests.exe || exit /b 1
 if "%look_at_raddbg%"=="1"             %compile%             ..\src\scratch\look_at_raddbg.c                                              %compile_link% %out%look_at_raddbg.exe || exit /b 1
+if "%hash_bench%"=="1"                 %compile%             ..\src\scratch\hash_bench.c                                                  %compile_link% %out%hash_bench.exe || exit /b 1
+if "%hash_map_bench%"=="1"             %compile%             ..\src\scratch\hash_map_bench.c                                              %compile_link% %out%hash_map_bench.exe || exit /b 1
+if "%line_scan_bench%"=="1"            %compile%             ..\src\scratch\line_scan_bench.c                                             %compile_link% %out%line_scan_bench.exe || exit /b 1
+if "%text_bench%"=="1"                 %compile%             ..\src\scratch\text_bench.c                                                  %compile_link% %out%text_bench.exe || exit /b 1
 if "%mule_main%"=="1"                  del vc*.pdb mule*.pdb && %compile_release% %only_compile% ..\src\mule\mule_inline.cpp && %compile_release% %only_compile% ..\src\mule\mule_o2.cpp && %compile_debug% %EHsc% ..\src\mule\mule_main.cpp ..\src\mule\mule_c.c mule_inline.obj mule_o2.obj %compile_link% %no_aslr% %out%mule_main.exe || exit /b 1
 if "%mule_module%"=="1"                %compile%             ..\src\mule\mule_module.cpp                                                  %compile_link% %link_dll% %out%mule_module.dll || exit /b 1
 if "%mule_hotload%"=="1"               %compile% ..\src\mule\mule_hotload_main.c %compile_link% %out%mule_hotload.exe & %compile% ..\src\mule\mule_hotload_module_main.c %compile_link% %link_dll% %out%mule_hotload_module.dll || exit /b 1
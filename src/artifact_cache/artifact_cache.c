@@ -0,0 +1,286 @@
+// Copyright (c) 2024 Epic Games Tools
+// Licensed under the MIT license (https://opensource.org/license/mit/)
+
+////////////////////////////////
+//~ rjf: Main Layer Initialization
+
+internal void
+ac_init(CmdLine *cmdline)
+{
+  Temp scratch = scratch_begin(0, 0);
+  Arena *arena = arena_alloc();
+  ac_shared = push_array(arena, AC_Shared, 1);
+  ac_shared->arena = arena;
+  ac_shared->size_max = GB(1);
+  ac_shared->write_mutex = os_mutex_alloc();
+  ac_shared->rw_mutex = os_rw_mutex_alloc();
+  ac_shared->index_arena = arena_alloc();
+  ac_shared->index = hash_map_alloc(ac_shared->index_arena, 4096);
+  metric_counter_register(str8_lit("ac.hits"), &ac_shared->hit_count);
+  metric_counter_register(str8_lit("ac.misses"), &ac_shared->miss_count);
+  metric_counter_register(str8_lit("ac.submits"), &ac_shared->submit_count);
+  metric_counter_register(str8_lit("ac.full_drops"), &ac_shared->full_drop_count);
+
+  //- rjf: pick pack path - explicitly specified, or in user program data
+  String8 path = cmd_line_string(cmdline, str8_lit("artifact_cache"));
+  if(path.size == 0 && !cmd_line_has_flag(cmdline, str8_lit("no_artifact_cache")))
+  {
+    String8 user_program_data_path = os_string_from_system_path(scratch.arena, OS_SystemPath_UserProgramData);
+    String8 user_data_folder = push_str8f(scratch.arena, "%S/raddbg", user_program_data_path);
+    String8 cache_folder = push_str8f(scratch.arena, "%S/cache", user_data_folder);
+    os_make_directory(user_data_folder);
+    os_make_directory(cache_folder);
+    path = push_str8f(scratch.arena, "%S/artifacts.raddbg_pack", cache_folder);
+  }
+  ac_shared->path = push_str8_copy(arena, path);
+
+  //- rjf: discard packs from other format versions, or which are (nearly)
+  // full - submissions which do not fit are dropped, so a pack at the cap
+  // would otherwise never take another write
+  if(path.size != 0)
+  {
+    FileProperties props = os_properties_from_file_path(path);
+    if(props.size != 0)
+    {
+      AC_PackHeader header = {0};
+      OS_Handle file = os_file_open(OS_AccessFlag_Read|OS_AccessFlag_ShareRead|OS_AccessFlag_ShareWrite, path);
+      os_file_read(file, r1u64(0, sizeof(header)), &header);
+      os_file_close(file);
+      if(header.magic != AC_PACK_MAGIC ||
+         header.version != AC_PACK_VERSION ||
+         header.record_align != AC_RECORD_ALIGN ||
+         props.size + AC_PACK_DISCARD_SLACK >= ac_shared->size_max)
+      {
+        os_delete_file_at_path(path);
+      }
+    }
+  }
+
+  //- rjf: open pack for reading & appending. not shared for writing, so a
+  // second instance using the same pack simply runs without the cache.
+  if(path.size != 0)
+  {
+    ac_shared->file = os_file_open(OS_AccessFlag_Read|OS_AccessFlag_Write|OS_AccessFlag_Append|OS_AccessFlag_ShareRead, path);
+  }
+
+  //- rjf: new pack -> write header
+  U64 file_size = 0;
+  if(!os_handle_match(ac_shared->file, os_handle_zero()))
+  {
+    file_size = os_properties_from_file(ac_shared->file).size;
+    if(file_size < sizeof(AC_PackHeader))
+    {
+      AC_PackHeader header = {AC_PACK_MAGIC, AC_PACK_VERSION, AC_RECORD_ALIGN};
+      os_file_write(ac_shared->file, r1u64(0, sizeof(header)), &header);
+      file_size = 0;
+    }
+    ac_shared->write_off = sizeof(AC_PackHeader);
+  }
+
+  //- rjf: existing pack -> map, & index all complete records. a torn record
+  // at the end (e.g. from a crash mid-write) ends the valid prefix, and is
+  // overwritten by the next submission.
+  if(file_size > sizeof(AC_PackHeader))
+  {
+    ac_shared->file_map = os_file_map_open(OS_AccessFlag_Read, ac_shared->file);
+    ac_shared->view_base = (U8 *)os_file_map_view_open(ac_shared->file_map, OS_AccessFlag_Read, r1u64(0, file_size));
+    if(ac_shared->view_base != 0)
+    {
+      U64 off = sizeof(AC_PackHeader);
+      for(;off + sizeof(AC_RecordHeader) <= file_size;)
+      {
+        AC_RecordHeader *record = (AC_RecordHeader *)(ac_shared->view_base + off);
+        U64 data_off = off + sizeof(AC_RecordHeader);
+        if(record->magic != AC_RECORD_MAGIC ||
+           record->data_size > file_size - data_off ||
+           AlignPow2(record->data_size, AC_RECORD_ALIGN) > file_size - data_off)
+        {
+          break;
+        }
+        if(ac_entry_from_key__index_guarded(record->key) == 0)
+        {
+          AC_Entry *entry = push_array(ac_shared->index_arena, AC_Entry, 1);
+          entry->key        = record->key;
+          entry->data_off   = data_off;
+          entry->data_size  = record->data_size;
+          entry->data_check = record->data_check;
+          ac_entry_insert__index_guarded(entry);
+        }
+        off = data_off + AlignPow2(record->data_size, AC_RECORD_ALIGN);
+      }
+      ac_shared->view_size = off;
+      ac_shared->write_off = off;
+    }
+  }
+
+  scratch_end(scratch);
+}
+
+internal B32
+ac_is_enabled(void)
+{
+  B32 result = (ac_shared != 0 && !os_handle_match(ac_shared->file, os_handle_zero()));
+  return result;
+}
+
+////////////////////////////////
+//~ rjf: Keys
+
+internal U128
+ac_key_from_kind_hash_params(AC_Kind kind, U64 version, U128 hash, String8 params)
+{
+  Temp scratch = scratch_begin(0, 0);
+  U64 key_header[] =
+  {
+    AC_PACK_VERSION,
+    (U64)kind,
+    version,
+    hash.u64[0],
+    hash.u64[1],
+  };
+  String8List parts = {0};
+  str8_list_push(scratch.arena, &parts, str8((U8 *)key_header, sizeof(key_header)));
+  str8_list_push(scratch.arena, &parts, params);
+  String8 key_data = str8_list_join(scratch.arena, &parts, 0);
+  U128 key = hs_hash_from_data(key_data);
+  scratch_end(scratch);
+  return key;
+}
+
+////////////////////////////////
+//~ rjf: Index
+
+internal AC_Entry *
+ac_entry_from_key__index_guarded(U128 key)
+{
+  AC_Entry *entry = 0;
+  HashMapSlot *slot = hash_map_slot_from_hash_key(ac_shared->index, key.u64[0], str8_struct(&key));
+  if(slot != 0)
+  {
+    entry = (AC_Entry *)slot->value;
+  }
+  return entry;
+}
+
+internal void
+ac_entry_insert__index_guarded(AC_Entry *entry)
+{
+  HashMapSlot *slot = hash_map_ensure_hash_key(ac_shared->index_arena, ac_shared->index, entry->key.u64[0], str8_struct(&entry->key), 0);
+  slot->value = (U64)entry;
+}
+
+////////////////////////////////
+//~ rjf: Lookups & Submission
+
+internal String8
+ac_data_from_key(Arena *arena, U128 key)
+{
+  String8 result = {0};
+  if(ac_is_enabled())
+  {
+    //- rjf: key -> entry
+    AC_Entry *entry = 0;
+    OS_MutexScopeR(ac_shared->rw_mutex)
+    {
+      entry = ac_entry_from_key__index_guarded(key);
+    }
+
+    //- rjf: entry in mapped prefix -> check once, then return view
+    if(entry != 0 && entry->data_off + entry->data_size <= ac_shared->view_size)
+    {
+      String8 data = str8(ac_shared->view_base + entry->data_off, entry->data_size);
+      U64 check = ins_atomic_u64_eval(&entry->check);
+      if(check == AC_EntryCheck_Unknown)
+      {
+        check = (hs_hash_from_data(data).u64[0] == entry->data_check) ? AC_EntryCheck_Good : AC_EntryCheck_Bad;
+        ins_atomic_u64_eval_assign(&entry->check, check);
+      }
+      if(check == AC_EntryCheck_Good)
+      {
+        result = data;
+      }
+    }
+
+    //- rjf: entry appended during this run -> read back
+    else if(entry != 0)
+    {
+      Temp restore_point = temp_begin(arena);
+      U8 *buffer = push_array_no_zero(arena, U8, entry->data_size);
+      U64 read_size = os_file_read(ac_shared->file, r1u64(entry->data_off, entry->data_off+entry->data_size), buffer);
+      String8 data = str8(buffer, read_size);
+      if(read_size == entry->data_size && hs_hash_from_data(data).u64[0] == entry->data_check)
+      {
+        result = data;
+      }
+      else
+      {
+        temp_end(restore_point);
+      }
+    }
+
+    //- rjf: bump stats
+    if(result.size != 0)
+    {
+      ins_atomic_u64_inc_eval(&ac_shared->hit_count);
+    }
+    else
+    {
+      ins_atomic_u64_inc_eval(&ac_shared->miss_count);
+    }
+  }
+  return result;
+}
+
+internal B32
+ac_data_is_persistent(String8 data)
+{
+  B32 result = (ac_shared != 0 && ac_shared->view_base != 0 &&
+                ac_shared->view_base <= data.str && data.str + data.size <= ac_shared->view_base + ac_shared->view_size);
+  return result;
+}
+
+internal void
+ac_submit_data(U128 key, String8List *data)
+{
+  if(ac_is_enabled())
+  {
+    Temp scratch = scratch_begin(0, 0);
+    String8 joined = str8_list_join(scratch.arena, data, 0);
+    U64 pad_size = AlignPow2(joined.size, AC_RECORD_ALIGN) - joined.size;
+    U64 record_size = sizeof(AC_RecordHeader) + joined.size + pad_size;
+    AC_RecordHeader record = {AC_RECORD_MAGIC, key, joined.size, hs_hash_from_data(joined).u64[0]};
+    U8 pad[AC_RECORD_ALIGN] = {0};
+
+    //- rjf: write record; writers are serialized by the write mutex, so the
+    // index need only be locked for the insertion itself
+    OS_MutexScope(ac_shared->write_mutex)
+    {
+      B32 is_present = (ac_entry_from_key__index_guarded(key) != 0);
+      B32 fits = (ac_shared->write_off + record_size <= ac_shared->size_max);
+      if(!is_present && !fits)
+      {
+        ins_atomic_u64_inc_eval(&ac_shared->full_drop_count);
+      }
+      if(!is_present && fits)
+      {
+        U64 off = ac_shared->write_off;
+        U64 data_off = off + sizeof(record);
+        os_file_write(ac_shared->file, r1u64(off, data_off), &record);
+        os_file_write(ac_shared->file, r1u64(data_off, data_off+joined.size), joined.str);
+        os_file_write(ac_shared->file, r1u64(data_off+joined.size, data_off+joined.size+pad_size), pad);
+        ac_shared->write_off = off + record_size;
+        OS_MutexScopeW(ac_shared->rw_mutex)
+        {
+          AC_Entry *entry = push_array(ac_shared->index_arena, AC_Entry, 1);
+          entry->key        = key;
+          entry->data_off   = data_off;
+          entry->data_size  = joined.size;
+          entry->data_check = record.data_check;
+          ac_entry_insert__index_guarded(entry);
+        }
+        ins_atomic_u64_inc_eval(&ac_shared->submit_count);
+      }
+    }
+    scratch_end(scratch);
+  }
+}
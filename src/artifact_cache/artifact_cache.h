@@ -0,0 +1,162 @@
+// Copyright (c) 2024 Epic Games Tools
+// Licensed under the MIT license (https://opensource.org/license/mit/)
+
+#ifndef ARTIFACT_CACHE_H
+#define ARTIFACT_CACHE_H
+
+////////////////////////////////
+//~ rjf: Artifact Cache Overview
+//
+// A persistent, on-disk, content-addressed store for artifacts which are
+// derived purely from hash store data (plus some parameters) - e.g. text
+// cache line/token info, or disassembly - so that they need not be
+// recomputed across runs.
+//
+// All artifacts live in a single append-only pack file:
+//
+//   [AC_PackHeader]
+//   [AC_RecordHeader][data][pad to 8 bytes]
+//   [AC_RecordHeader][data][pad to 8 bytes]
+//   ...
+//
+// At startup, the pack's record headers are scanned to build an in-memory
+// index, and the valid prefix of the pack is mapped read-only. Lookups of
+// records in that prefix return views directly into the mapping, which stay
+// valid for the rest of the process, so callers may point artifacts directly
+// into them. Records submitted during this run are appended to the file, and
+// are read back into a caller-provided arena if looked up.
+//
+// Record payloads are checked against a stored hash the first time they are
+// looked up, so a torn or corrupt pack degrades into cache misses. A pack
+// written by a different format version is discarded at startup. Submissions
+// which would grow the pack past its size cap are dropped; a pack within
+// `AC_PACK_DISCARD_SLACK` of the cap is discarded at startup, so that a full
+// pack is replaced by a fresh one on the next run.
+//
+// Keys must capture everything an artifact depends on - kind, input hash,
+// parameters, and a per-kind format version which should be bumped whenever
+// the producing code or the artifact's layout changes.
+
+////////////////////////////////
+//~ rjf: Artifact Kinds
+
+typedef enum AC_Kind
+{
+  AC_Kind_Null,
+  AC_Kind_TextInfo,
+  AC_Kind_DasmInfo,
+  AC_Kind_COUNT
+}
+AC_Kind;
+
+////////////////////////////////
+//~ rjf: Pack File Format Types
+
+#define AC_PACK_MAGIC    0x6b6361705f636172ull // "rac_pack"
+#define AC_RECORD_MAGIC  0x6365725f63615f72ull // "r_ac_rec"
+#define AC_PACK_VERSION  1
+#define AC_RECORD_ALIGN  8
+#define AC_PACK_DISCARD_SLACK MB(64)
+
+typedef struct AC_PackHeader AC_PackHeader;
+struct AC_PackHeader
+{
+  U64 magic;
+  U32 version;
+  U32 record_align;
+};
+
+typedef struct AC_RecordHeader AC_RecordHeader;
+struct AC_RecordHeader
+{
+  U64 magic;
+  U128 key;
+  U64 data_size;
+  U64 data_check;
+};
+
+////////////////////////////////
+//~ rjf: Index Types
+
+typedef enum AC_EntryCheck
+{
+  AC_EntryCheck_Unknown,
+  AC_EntryCheck_Good,
+  AC_EntryCheck_Bad,
+}
+AC_EntryCheck;
+
+typedef struct AC_Entry AC_Entry;
+struct AC_Entry
+{
+  U128 key;
+  U64 data_off;
+  U64 data_size;
+  U64 data_check;
+  U64 check;
+};
+
+////////////////////////////////
+//~ rjf: Shared State
+
+typedef struct AC_Shared AC_Shared;
+struct AC_Shared
+{
+  Arena *arena;
+
+  // rjf: pack file
+  String8 path;
+  OS_Handle file;
+  OS_Handle file_map;
+  U8 *view_base;
+  U64 view_size;
+  U64 write_off;
+  U64 size_max;
+
+  // rjf: index
+  OS_Handle write_mutex;
+  OS_Handle rw_mutex;
+  Arena *index_arena;
+  HashMap *index;
+
+  // rjf: stats
+  U64 hit_count;
+  U64 miss_count;
+  U64 submit_count;
+  U64 full_drop_count;
+};
+
+////////////////////////////////
+//~ rjf: Globals
+
+global AC_Shared *ac_shared = 0;
+
+////////////////////////////////
+//~ rjf: Main Layer Initialization
+
+internal void ac_init(CmdLine *cmdline);
+internal B32 ac_is_enabled(void);
+
+////////////////////////////////
+//~ rjf: Keys
+
+internal U128 ac_key_from_kind_hash_params(AC_Kind kind, U64 version, U128 hash, String8 params);
+
+////////////////////////////////
+//~ rjf: Index
+
+// NOTE(rjf): the index is keyed by the full 128-bit key; entries are hashed
+// by the key's low 64 bits, & point the map at their own copy of the key
+internal AC_Entry *ac_entry_from_key__index_guarded(U128 key);
+internal void ac_entry_insert__index_guarded(AC_Entry *entry);
+
+////////////////////////////////
+//~ rjf: Lookups & Submission
+
+// NOTE(rjf): returns either a view into the mapped pack (valid for the rest
+// of the process), or a copy pushed onto `arena`; empty on a miss
+internal String8 ac_data_from_key(Arena *arena, U128 key);
+internal B32 ac_data_is_persistent(String8 data);
+internal void ac_submit_data(U128 key, String8List *data);
+
+#endif // ARTIFACT_CACHE_H
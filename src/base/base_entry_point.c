@@ -21,6 +21,14 @@ main_thread_base_entry_point(void (*entry_point)(CmdLine *cmdline), char **argum
 #if defined(OS_CORE_H) && !defined(OS_INIT_MANUAL)
   os_init();
 #endif
+  string_intern_init();
+  epoch_init();
+  metrics_init();
+  String8 log_file_path = cmd_line_string(&cmdline, str8_lit("log_file"));
+  if(log_file_path.size != 0)
+  {
+    log_sink_begin(log_file_path, MB(64), 4);
+  }
 #if defined(TASK_SYSTEM_H) && !defined(TS_INIT_MANUAL)
   ts_init();
 #endif
@@ -30,6 +38,12 @@ main_thread_base_entry_point(void (*entry_point)(CmdLine *cmdline), char **argum
 #if defined(FILE_STREAM_H) && !defined(FS_INIT_MANUAL)
   fs_init();
 #endif
+#if defined(ARTIFACT_CACHE_H) && !defined(AC_INIT_MANUAL)
+  ac_init(&cmdline);
+#endif
+#if defined(CACHE_ENGINE_H) && !defined(CE_INIT_MANUAL)
+  ce_init();
+#endif
 #if defined(TEXT_CACHE_H) && !defined(TXT_INIT_MANUAL)
   txt_init();
 #endif
@@ -77,6 +91,7 @@ main_thread_base_entry_point(void (*entry_point)(CmdLine *cmdline), char **argum
   df_gfx_init(update_and_render, df_state_delta_history());
 #endif
   entry_point(&cmdline);
+  log_sink_end();
   if(capture)
   {
     ProfEndCapture();
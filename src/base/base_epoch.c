@@ -0,0 +1,109 @@
+// Copyright (c) 2024 Epic Games Tools
+// Licensed under the MIT license (https://opensource.org/license/mit/)
+
+////////////////////////////////
+//~ rjf: Epoch State Types
+//
+// NOTE(rjf): these refer to OS_Handle, which is not yet defined when base's
+// headers are included, so they live here.
+//
+// Each thread's slot is allocated on its first `epoch_enter`, padded to its
+// own cache line, & never freed - an exited thread's slot just stays idle
+// (zero). A slot's epoch is zero while its thread is outside of any epoch.
+
+typedef struct EpochShared EpochShared;
+struct EpochShared
+{
+  Arena *arena;
+  U64 global_epoch;
+  U8 global_epoch_padding[64 - sizeof(U64)];
+  OS_Handle threads_mutex;
+  EpochThread *first_thread;
+};
+
+////////////////////////////////
+//~ rjf: Globals
+
+global EpochShared *epoch_shared = 0;
+thread_static EpochThread *epoch_thread = 0;
+
+////////////////////////////////
+//~ rjf: Top-Level Layer Initialization
+
+internal void
+epoch_init(void)
+{
+  Arena *arena = arena_alloc();
+  arena_push_align(arena, 64);
+  epoch_shared = push_array(arena, EpochShared, 1);
+  epoch_shared->arena = arena;
+  epoch_shared->global_epoch = 1;
+  epoch_shared->threads_mutex = os_mutex_alloc();
+}
+
+////////////////////////////////
+//~ rjf: Reader Functions
+
+internal void
+epoch_enter(void)
+{
+  if(epoch_thread == 0) OS_MutexScope(epoch_shared->threads_mutex)
+  {
+    arena_push_align(epoch_shared->arena, 64);
+    epoch_thread = push_array(epoch_shared->arena, EpochThread, 1);
+    SLLStackPush(epoch_shared->first_thread, epoch_thread);
+  }
+  if(epoch_thread->depth == 0)
+  {
+    // NOTE(rjf): the exchange is a full barrier, so the published epoch is
+    // visible to writers before any of this thread's subsequent reads
+    U64 global_epoch = *(volatile U64 *)&epoch_shared->global_epoch;
+    ins_atomic_u64_eval_assign(&epoch_thread->epoch, global_epoch);
+  }
+  epoch_thread->depth += 1;
+}
+
+internal void
+epoch_leave(void)
+{
+  epoch_thread->depth -= 1;
+  if(epoch_thread->depth == 0)
+  {
+    ins_atomic_u64_eval_assign(&epoch_thread->epoch, 0);
+  }
+}
+
+////////////////////////////////
+//~ rjf: Writer Functions
+
+internal U64
+epoch_retire(void)
+{
+  U64 retire_epoch = ins_atomic_u64_inc_eval(&epoch_shared->global_epoch);
+  return retire_epoch;
+}
+
+internal U64
+epoch_reclaim_watermark(void)
+{
+  U64 watermark = ins_atomic_u64_eval(&epoch_shared->global_epoch);
+  OS_MutexScope(epoch_shared->threads_mutex)
+  {
+    for(EpochThread *t = epoch_shared->first_thread; t != 0; t = t->next)
+    {
+      U64 thread_epoch = ins_atomic_u64_eval(&t->epoch);
+      if(thread_epoch != 0 && thread_epoch < watermark)
+      {
+        watermark = thread_epoch;
+      }
+    }
+  }
+  return watermark;
+}
+
+internal B32
+epoch_is_reclaimable(U64 retire_epoch)
+{
+  B32 result = (retire_epoch <= epoch_reclaim_watermark());
+  return result;
+}
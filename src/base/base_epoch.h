@@ -0,0 +1,56 @@
+// Copyright (c) 2024 Epic Games Tools
+// Licensed under the MIT license (https://opensource.org/license/mit/)
+
+#ifndef BASE_EPOCH_H
+#define BASE_EPOCH_H
+
+////////////////////////////////
+//~ rjf: Epoch-Based Reclamation Types
+//
+// Lets writers retire values which readers on other threads may still be
+// using, & reclaim them later, without waiting on those readers or tracking
+// per-value reference counts.
+//
+// Readers bracket their accesses with `epoch_enter` / `epoch_leave` (which
+// nest) - typically once per cache scope. Entering publishes the current
+// global epoch into a slot owned by the calling thread; it touches no shared
+// cache line other than reading the global epoch.
+//
+// A writer first unlinks a value so that no new reader can find it, then
+// calls `epoch_retire`, which advances the global epoch & returns a retire
+// epoch for the value. The value may be reclaimed once every thread which is
+// inside an epoch entered it at or after that retire epoch - i.e. once
+// `epoch_is_reclaimable` returns true. Writers with many retired values
+// should compute `epoch_reclaim_watermark` once & compare against it.
+//
+// A thread which stays inside an epoch indefinitely delays reclamation, but
+// never makes it unsafe.
+
+typedef struct EpochThread EpochThread;
+struct EpochThread
+{
+  EpochThread *next;
+  U64 epoch;
+  U64 depth;
+  U8 padding[64 - 3*sizeof(U64)];
+};
+
+////////////////////////////////
+//~ rjf: Top-Level Layer Initialization
+
+internal void epoch_init(void);
+
+////////////////////////////////
+//~ rjf: Reader Functions
+
+internal void epoch_enter(void);
+internal void epoch_leave(void);
+
+////////////////////////////////
+//~ rjf: Writer Functions
+
+internal U64 epoch_retire(void);
+internal U64 epoch_reclaim_watermark(void);
+internal B32 epoch_is_reclaimable(U64 retire_epoch);
+
+#endif // BASE_EPOCH_H
@@ -0,0 +1,304 @@
+// Copyright (c) 2024 Epic Games Tools
+// Licensed under the MIT license (https://opensource.org/license/mit/)
+
+////////////////////////////////
+//~ rjf: Hash Functions
+
+internal U64
+hash_map_hash_from_str8(String8 string)
+{
+  U64 result = 0x9e3779b97f4a7c15ull ^ string.size;
+  U64 off = 0;
+  for(; off+sizeof(U64) <= string.size; off += sizeof(U64))
+  {
+    U64 chunk = 0;
+    MemoryCopy(&chunk, string.str+off, sizeof(chunk));
+    result = (result ^ chunk) * 0xbf58476d1ce4e5b9ull;
+    result ^= result >> 31;
+  }
+  if(off < string.size)
+  {
+    U64 chunk = 0;
+    MemoryCopy(&chunk, string.str+off, string.size-off);
+    result = (result ^ chunk) * 0xbf58476d1ce4e5b9ull;
+    result ^= result >> 31;
+  }
+  result = hash_map_hash_from_u64(result);
+  return result;
+}
+
+internal U64
+hash_map_hash_from_u64(U64 x)
+{
+  // NOTE(rjf): splitmix64 finalizer - this is a bijection, so two distinct U64
+  // keys never produce the same hash. the `_u64` map entry points rely on this.
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9ull;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111ebull;
+  x ^= x >> 31;
+  return x;
+}
+
+////////////////////////////////
+//~ rjf: Control Byte Group Matching
+
+internal U32
+hash_map_group_match(U8 *group_ctrl, U8 ctrl_byte)
+{
+  U32 result = 0;
+#if ARCH_X64
+  __m128i group = _mm_loadu_si128((__m128i *)group_ctrl);
+  result = (U32)_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8((char)ctrl_byte)));
+#else
+  for(U32 idx = 0; idx < HASH_MAP_GROUP_SIZE; idx += 1)
+  {
+    result |= (U32)(group_ctrl[idx] == ctrl_byte) << idx;
+  }
+#endif
+  return result;
+}
+
+internal U32
+hash_map_group_match_empty_or_deleted(U8 *group_ctrl)
+{
+  U32 result = 0;
+#if ARCH_X64
+  __m128i group = _mm_loadu_si128((__m128i *)group_ctrl);
+  result = (U32)_mm_movemask_epi8(group);
+#else
+  for(U32 idx = 0; idx < HASH_MAP_GROUP_SIZE; idx += 1)
+  {
+    result |= (U32)(group_ctrl[idx] >> 7) << idx;
+  }
+#endif
+  return result;
+}
+
+////////////////////////////////
+//~ rjf: Map Creation
+
+internal HashMap *
+hash_map_alloc(Arena *arena, U64 expected_count)
+{
+  HashMap *map = push_array(arena, HashMap, 1);
+  U64 cap = u64_up_to_pow2(expected_count + expected_count/7 + 1);
+  cap = Max(cap, HASH_MAP_GROUP_SIZE);
+  map->cap = cap;
+  map->ctrl = push_array_no_zero(arena, U8, cap);
+  map->slots = push_array_no_zero(arena, HashMapSlot, cap);
+  MemorySet(map->ctrl, HASH_MAP_CTRL_EMPTY, cap);
+  return map;
+}
+
+internal void
+hash_map_clear(HashMap *map)
+{
+  MemorySet(map->ctrl, HASH_MAP_CTRL_EMPTY, map->cap);
+  map->count = 0;
+  map->deleted_count = 0;
+}
+
+internal void
+hash_map_rehash(Arena *arena, HashMap *map, U64 new_cap)
+{
+  new_cap = u64_up_to_pow2(Max(new_cap, HASH_MAP_GROUP_SIZE));
+  U64 old_cap = map->cap;
+  U8 *old_ctrl = map->ctrl;
+  HashMapSlot *old_slots = map->slots;
+  map->cap = new_cap;
+  map->count = 0;
+  map->deleted_count = 0;
+  map->ctrl = push_array_no_zero(arena, U8, new_cap);
+  map->slots = push_array_no_zero(arena, HashMapSlot, new_cap);
+  MemorySet(map->ctrl, HASH_MAP_CTRL_EMPTY, new_cap);
+  U64 group_mask = new_cap/HASH_MAP_GROUP_SIZE - 1;
+  for(U64 old_idx = 0; old_idx < old_cap; old_idx += 1)
+  {
+    if(old_ctrl[old_idx] >= HASH_MAP_CTRL_EMPTY)
+    {
+      continue;
+    }
+    HashMapSlot *old_slot = &old_slots[old_idx];
+    U64 group_idx = (old_slot->hash >> 7) & group_mask;
+    for(U64 probe_idx = 0;; probe_idx += 1)
+    {
+      U8 *group_ctrl = map->ctrl + group_idx*HASH_MAP_GROUP_SIZE;
+      U32 free_mask = hash_map_group_match_empty_or_deleted(group_ctrl);
+      if(free_mask != 0)
+      {
+        U64 new_idx = group_idx*HASH_MAP_GROUP_SIZE + ctz32(free_mask);
+        map->ctrl[new_idx] = (U8)(old_slot->hash & 0x7f);
+        map->slots[new_idx] = *old_slot;
+        map->count += 1;
+        break;
+      }
+      group_idx = (group_idx + probe_idx + 1) & group_mask;
+    }
+  }
+}
+
+////////////////////////////////
+//~ rjf: Lookups/Insertions/Removals
+
+//- rjf: general (pre-hashed) forms
+
+internal HashMapSlot *
+hash_map_slot_from_hash_key(HashMap *map, U64 hash, String8 key)
+{
+  HashMapSlot *result = 0;
+  U64 group_count = map->cap/HASH_MAP_GROUP_SIZE;
+  U64 group_mask = group_count - 1;
+  U64 group_idx = (hash >> 7) & group_mask;
+  U8 h7 = (U8)(hash & 0x7f);
+  for(U64 probe_idx = 0; probe_idx < group_count; probe_idx += 1)
+  {
+    U8 *group_ctrl = map->ctrl + group_idx*HASH_MAP_GROUP_SIZE;
+    for(U32 match_mask = hash_map_group_match(group_ctrl, h7); match_mask != 0; match_mask &= match_mask-1)
+    {
+      HashMapSlot *slot = &map->slots[group_idx*HASH_MAP_GROUP_SIZE + ctz32(match_mask)];
+      if(slot->hash == hash && str8_match(slot->key, key, 0))
+      {
+        result = slot;
+        goto end_lookup;
+      }
+    }
+    if(hash_map_group_match(group_ctrl, HASH_MAP_CTRL_EMPTY) != 0)
+    {
+      break;
+    }
+    group_idx = (group_idx + probe_idx + 1) & group_mask;
+  }
+  end_lookup:;
+  return result;
+}
+
+internal HashMapSlot *
+hash_map_ensure_hash_key(Arena *arena, HashMap *map, U64 hash, String8 key, B32 *is_new_out)
+{
+  HashMapSlot *result = hash_map_slot_from_hash_key(map, hash, key);
+  B32 is_new = (result == 0);
+  if(is_new)
+  {
+    //- rjf: grow (or just flush tombstones) if we're over 7/8 load
+    if((map->count + map->deleted_count + 1)*8 > map->cap*7)
+    {
+      U64 new_cap = (map->count*2 >= map->cap) ? map->cap*2 : map->cap;
+      hash_map_rehash(arena, map, new_cap);
+    }
+
+    //- rjf: find first empty-or-deleted slot along the probe sequence
+    U64 group_mask = map->cap/HASH_MAP_GROUP_SIZE - 1;
+    U64 group_idx = (hash >> 7) & group_mask;
+    for(U64 probe_idx = 0;; probe_idx += 1)
+    {
+      U8 *group_ctrl = map->ctrl + group_idx*HASH_MAP_GROUP_SIZE;
+      U32 free_mask = hash_map_group_match_empty_or_deleted(group_ctrl);
+      if(free_mask != 0)
+      {
+        U64 idx = group_idx*HASH_MAP_GROUP_SIZE + ctz32(free_mask);
+        if(map->ctrl[idx] == HASH_MAP_CTRL_DELETED)
+        {
+          map->deleted_count -= 1;
+        }
+        map->ctrl[idx] = (U8)(hash & 0x7f);
+        result = &map->slots[idx];
+        result->hash = hash;
+        result->key = key;
+        result->value = 0;
+        map->count += 1;
+        break;
+      }
+      group_idx = (group_idx + probe_idx + 1) & group_mask;
+    }
+  }
+  if(is_new_out != 0)
+  {
+    *is_new_out = is_new;
+  }
+  return result;
+}
+
+internal B32
+hash_map_remove_hash_key(HashMap *map, U64 hash, String8 key)
+{
+  B32 result = 0;
+  HashMapSlot *slot = hash_map_slot_from_hash_key(map, hash, key);
+  if(slot != 0)
+  {
+    U64 idx = (U64)(slot - map->slots);
+    U64 group_start_idx = idx - idx%HASH_MAP_GROUP_SIZE;
+
+    // NOTE(rjf): if this slot's group still has an empty slot, no probe
+    // sequence can have continued past it, so the slot can become empty
+    // directly rather than leaving a tombstone.
+    if(hash_map_group_match(map->ctrl + group_start_idx, HASH_MAP_CTRL_EMPTY) != 0)
+    {
+      map->ctrl[idx] = HASH_MAP_CTRL_EMPTY;
+    }
+    else
+    {
+      map->ctrl[idx] = HASH_MAP_CTRL_DELETED;
+      map->deleted_count += 1;
+    }
+    map->count -= 1;
+    result = 1;
+  }
+  return result;
+}
+
+//- rjf: string-keyed helpers
+
+internal HashMapSlot *
+hash_map_slot_from_key(HashMap *map, String8 key)
+{
+  return hash_map_slot_from_hash_key(map, hash_map_hash_from_str8(key), key);
+}
+
+internal HashMapSlot *
+hash_map_ensure(Arena *arena, HashMap *map, String8 key, B32 *is_new_out)
+{
+  return hash_map_ensure_hash_key(arena, map, hash_map_hash_from_str8(key), key, is_new_out);
+}
+
+internal HashMapSlot *
+hash_map_insert(Arena *arena, HashMap *map, String8 key, U64 value)
+{
+  HashMapSlot *slot = hash_map_ensure(arena, map, key, 0);
+  slot->value = value;
+  return slot;
+}
+
+internal B32
+hash_map_remove(HashMap *map, String8 key)
+{
+  return hash_map_remove_hash_key(map, hash_map_hash_from_str8(key), key);
+}
+
+//- rjf: u64-keyed helpers
+
+internal HashMapSlot *
+hash_map_slot_from_u64(HashMap *map, U64 key)
+{
+  return hash_map_slot_from_hash_key(map, hash_map_hash_from_u64(key), str8_zero());
+}
+
+internal HashMapSlot *
+hash_map_ensure_u64(Arena *arena, HashMap *map, U64 key, B32 *is_new_out)
+{
+  return hash_map_ensure_hash_key(arena, map, hash_map_hash_from_u64(key), str8_zero(), is_new_out);
+}
+
+internal HashMapSlot *
+hash_map_insert_u64(Arena *arena, HashMap *map, U64 key, U64 value)
+{
+  HashMapSlot *slot = hash_map_ensure_u64(arena, map, key, 0);
+  slot->value = value;
+  return slot;
+}
+
+internal B32
+hash_map_remove_u64(HashMap *map, U64 key)
+{
+  return hash_map_remove_hash_key(map, hash_map_hash_from_u64(key), str8_zero());
+}
@@ -0,0 +1,97 @@
+// Copyright (c) 2024 Epic Games Tools
+// Licensed under the MIT license (https://opensource.org/license/mit/)
+
+#ifndef BASE_HASH_MAP_H
+#define BASE_HASH_MAP_H
+
+////////////////////////////////
+//~ rjf: Foreign Includes
+
+#if ARCH_X64
+# include <emmintrin.h>
+#endif
+
+////////////////////////////////
+//~ rjf: Open-Addressing Hash Map Types
+//
+// Arena-backed, open-addressing map from byte-string keys to U64 values.
+// Slots are arranged in groups of 16; each slot has one control byte, which
+// is either `HASH_MAP_CTRL_EMPTY`, `HASH_MAP_CTRL_DELETED`, or the low 7 bits
+// of the slot's key hash. A probe compares all 16 control bytes of a group at
+// once (SSE2 on x64), and only touches slot memory on a 7-bit hash match.
+//
+// Key strings are not copied - the caller must keep them alive for as long as
+// the map is used (e.g. by copying them into the same arena). U64 keys may be
+// used via the `_u64` entry points, which store no key bytes at all; string
+// and U64 keys should not be mixed within one map.
+//
+// Growing re-pushes the control & slot arrays onto the arena, so maps which
+// grow many times should be given a good initial capacity.
+
+#define HASH_MAP_GROUP_SIZE    16
+#define HASH_MAP_CTRL_EMPTY    0x80
+#define HASH_MAP_CTRL_DELETED  0xFE
+
+typedef struct HashMapSlot HashMapSlot;
+struct HashMapSlot
+{
+  U64 hash;
+  String8 key;
+  U64 value;
+};
+
+typedef struct HashMap HashMap;
+struct HashMap
+{
+  U64 cap;
+  U64 count;
+  U64 deleted_count;
+  U8 *ctrl;
+  HashMapSlot *slots;
+};
+
+////////////////////////////////
+//~ rjf: Hash Functions
+
+internal U64 hash_map_hash_from_str8(String8 string);
+internal U64 hash_map_hash_from_u64(U64 x);
+
+////////////////////////////////
+//~ rjf: Control Byte Group Matching
+
+internal U32 hash_map_group_match(U8 *group_ctrl, U8 ctrl_byte);
+internal U32 hash_map_group_match_empty_or_deleted(U8 *group_ctrl);
+
+////////////////////////////////
+//~ rjf: Map Creation
+
+internal HashMap *hash_map_alloc(Arena *arena, U64 expected_count);
+internal void hash_map_clear(HashMap *map);
+internal void hash_map_rehash(Arena *arena, HashMap *map, U64 new_cap);
+
+////////////////////////////////
+//~ rjf: Lookups/Insertions/Removals
+
+//- rjf: general (pre-hashed) forms
+internal HashMapSlot *hash_map_slot_from_hash_key(HashMap *map, U64 hash, String8 key);
+internal HashMapSlot *hash_map_ensure_hash_key(Arena *arena, HashMap *map, U64 hash, String8 key, B32 *is_new_out);
+internal B32 hash_map_remove_hash_key(HashMap *map, U64 hash, String8 key);
+
+//- rjf: string-keyed helpers
+internal HashMapSlot *hash_map_slot_from_key(HashMap *map, String8 key);
+internal HashMapSlot *hash_map_ensure(Arena *arena, HashMap *map, String8 key, B32 *is_new_out);
+internal HashMapSlot *hash_map_insert(Arena *arena, HashMap *map, String8 key, U64 value);
+internal B32 hash_map_remove(HashMap *map, String8 key);
+
+//- rjf: u64-keyed helpers
+internal HashMapSlot *hash_map_slot_from_u64(HashMap *map, U64 key);
+internal HashMapSlot *hash_map_ensure_u64(Arena *arena, HashMap *map, U64 key, B32 *is_new_out);
+internal HashMapSlot *hash_map_insert_u64(Arena *arena, HashMap *map, U64 key, U64 value);
+internal B32 hash_map_remove_u64(HashMap *map, U64 key);
+
+////////////////////////////////
+//~ rjf: Iteration
+
+#define hash_map_slot_idx_is_occupied(map, idx) ((map)->ctrl[(idx)] < HASH_MAP_CTRL_EMPTY)
+
+#endif // BASE_HASH_MAP_H
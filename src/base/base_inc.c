@@ -12,6 +12,11 @@
 #include "base_arena.c"
 #include "base_math.c"
 #include "base_strings.c"
+#include "base_hash_map.c"
+#include "base_sort.c"
+#include "base_string_intern.c"
+#include "base_epoch.c"
+#include "base_metrics.c"
 #include "base_thread_context.c"
 #include "base_command_line.c"
 #include "base_markup.c"
@@ -14,6 +14,11 @@
 #include "base_arena.h"
 #include "base_math.h"
 #include "base_strings.h"
+#include "base_hash_map.h"
+#include "base_sort.h"
+#include "base_string_intern.h"
+#include "base_epoch.h"
+#include "base_metrics.h"
 #include "base_thread_context.h"
 #include "base_command_line.h"
 #include "base_markup.h"
@@ -1,6 +1,52 @@
 // Copyright (c) 2024 Epic Games Tools
 // Licensed under the MIT license (https://opensource.org/license/mit/)
 
+////////////////////////////////
+//~ rjf: Async Log Sink Types
+//
+// NOTE(rjf): these refer to OS_Handle, which is not yet defined when base's
+// headers are included, so they live here.
+
+typedef struct LogSinkRecordHeader LogSinkRecordHeader;
+struct LogSinkRecordHeader
+{
+  U64 timestamp_us;
+  U32 kind;
+  U32 size;
+};
+
+typedef struct LogSinkThreadBuffer LogSinkThreadBuffer;
+struct LogSinkThreadBuffer
+{
+  LogSinkThreadBuffer *next;
+  Arena *arena;
+  U32 thread_id;
+  U8 *ring_base;
+  U64 ring_size;
+  U64 write_pos;              // NOTE(rjf): written only by the owning thread
+  U64 dropped_count;          // NOTE(rjf): written only by the owning thread
+  U64 read_pos;               // NOTE(rjf): written only by the writer thread
+  U64 dropped_count_reported; // NOTE(rjf): written only by the writer thread
+  U64 is_released;            // NOTE(rjf): set by the owning thread as it exits, cleared by the next owner
+};
+
+typedef struct LogSink LogSink;
+struct LogSink
+{
+  Arena *arena;
+  String8 path_base;
+  String8 path_ext;
+  U64 max_file_size;
+  U64 max_file_count;
+  U64 start_us;
+  U64 thread_buffers_first; // NOTE(rjf): LogSinkThreadBuffer *, pushed atomically
+  U64 stop;
+  OS_Handle writer_thread;
+  OS_Handle file;
+  U64 file_idx;
+  U64 file_off;
+};
+
 ////////////////////////////////
 //~ rjf: Globals/Thread-Locals
 
@@ -9,6 +55,13 @@ C_LINKAGE thread_static Log *log_active;
 C_LINKAGE thread_static Log *log_active = 0;
 #endif
 
+C_LINKAGE thread_static LogSinkThreadBuffer *log_sink_thread_buffer;
+#if !BUILD_SUPPLEMENTARY_UNIT
+C_LINKAGE thread_static LogSinkThreadBuffer *log_sink_thread_buffer = 0;
+#endif
+
+global LogSink *log_sink = 0;
+
 ////////////////////////////////
 //~ rjf: Log Creation/Selection
 
@@ -39,7 +92,8 @@ log_select(Log *log)
 internal void
 log_msg(LogMsgKind kind, String8 string)
 {
-  if(log_active != 0 && log_active->top_scope != 0)
+  B32 sunk = log_sink_push(kind, string);
+  if(log_active != 0 && log_active->top_scope != 0 && !(sunk && kind == LogMsgKind_Info))
   {
     String8 string_copy = push_str8_copy(log_active->arena, string);
     str8_list_push(log_active->arena, &log_active->top_scope->strings[kind], string_copy);
@@ -49,7 +103,7 @@ log_msg(LogMsgKind kind, String8 string)
 internal void
 log_msgf(LogMsgKind kind, char *fmt, ...)
 {
-  if(log_active != 0)
+  if(log_active != 0 || log_sink_is_running())
   {
     Temp scratch = scratch_begin(0, 0);
     va_list args;
@@ -61,6 +115,248 @@ log_msgf(LogMsgKind kind, char *fmt, ...)
   }
 }
 
+////////////////////////////////
+//~ rjf: Async Log Sink
+
+//- rjf: writer thread
+
+internal void
+log_sink_open_next_file(void)
+{
+  Temp scratch = scratch_begin(0, 0);
+  if(!os_handle_match(log_sink->file, os_handle_zero()))
+  {
+    os_file_close(log_sink->file);
+    log_sink->file_idx += 1;
+  }
+  if(log_sink->file_idx >= log_sink->max_file_count)
+  {
+    String8 old_path = push_str8f(scratch.arena, "%S.%I64u%S", log_sink->path_base, log_sink->file_idx - log_sink->max_file_count, log_sink->path_ext);
+    os_delete_file_at_path(old_path);
+  }
+  String8 path = push_str8f(scratch.arena, "%S.%I64u%S", log_sink->path_base, log_sink->file_idx, log_sink->path_ext);
+  log_sink->file = os_file_open(OS_AccessFlag_Write|OS_AccessFlag_ShareRead, path);
+  log_sink->file_off = 0;
+  scratch_end(scratch);
+}
+
+internal void
+log_sink_write(String8 string)
+{
+  if(log_sink->file_off != 0 && log_sink->file_off + string.size > log_sink->max_file_size)
+  {
+    log_sink_open_next_file();
+  }
+  os_file_write(log_sink->file, r1u64(log_sink->file_off, log_sink->file_off + string.size), string.str);
+  log_sink->file_off += string.size;
+}
+
+internal B32
+log_sink_drain(void)
+{
+  B32 drained_any = 0;
+  Temp scratch = scratch_begin(0, 0);
+  LogSinkThreadBuffer *first_buffer = (LogSinkThreadBuffer *)ins_atomic_u64_eval(&log_sink->thread_buffers_first);
+  for(LogSinkThreadBuffer *buffer = first_buffer; buffer != 0; buffer = buffer->next)
+  {
+    Temp temp = temp_begin(scratch.arena);
+    String8List strings = {0};
+    
+    //- rjf: report drops since last drain
+    U64 dropped_count = ins_atomic_u64_eval(&buffer->dropped_count);
+    if(dropped_count != buffer->dropped_count_reported)
+    {
+      U64 timestamp_us = os_now_microseconds() - log_sink->start_us;
+      str8_list_pushf(temp.arena, &strings, "[%5I64u.%06I64u] [tid %5u] [log] %I64u message(s) dropped - ring buffer full\n",
+                      timestamp_us/1000000, timestamp_us%1000000, buffer->thread_id,
+                      dropped_count - buffer->dropped_count_reported);
+      buffer->dropped_count_reported = dropped_count;
+    }
+    
+    //- rjf: format all complete records
+    U64 write_pos = ins_atomic_u64_eval(&buffer->write_pos);
+    U64 read_pos = buffer->read_pos;
+    for(;read_pos < write_pos;)
+    {
+      LogSinkRecordHeader header = {0};
+      read_pos += ring_read_struct(buffer->ring_base, buffer->ring_size, read_pos, &header);
+      U8 *payload = push_array_no_zero(temp.arena, U8, header.size);
+      read_pos += ring_read(buffer->ring_base, buffer->ring_size, read_pos, payload, header.size);
+      read_pos = AlignPow2(read_pos, 8);
+      String8 message = str8(payload, header.size);
+      B32 needs_newline = (message.size == 0 || message.str[message.size-1] != '\n');
+      U64 timestamp_us = header.timestamp_us - log_sink->start_us;
+      str8_list_pushf(temp.arena, &strings, "[%5I64u.%06I64u] [tid %5u] [%s] %S%s",
+                      timestamp_us/1000000, timestamp_us%1000000, buffer->thread_id,
+                      header.kind == LogMsgKind_UserError ? "error" : "info",
+                      message, needs_newline ? "\n" : "");
+    }
+    ins_atomic_u64_eval_assign(&buffer->read_pos, read_pos);
+    
+    //- rjf: write
+    if(strings.node_count != 0)
+    {
+      drained_any = 1;
+      log_sink_write(str8_list_join(temp.arena, &strings, 0));
+    }
+    temp_end(temp);
+  }
+  scratch_end(scratch);
+  return drained_any;
+}
+
+internal void
+log_sink_writer_thread__entry_point(void *p)
+{
+  ThreadNameF("[log sink writer]");
+  for(;;)
+  {
+    B32 stop = (ins_atomic_u64_eval(&log_sink->stop) != 0);
+    B32 drained_any = log_sink_drain();
+    if(stop)
+    {
+      break;
+    }
+    if(!drained_any)
+    {
+      os_sleep_milliseconds(10);
+    }
+  }
+}
+
+//- rjf: top-level controls
+
+internal void
+log_sink_begin(String8 path, U64 max_file_size, U64 max_file_count)
+{
+  if(log_sink == 0)
+  {
+    Arena *arena = arena_alloc();
+    LogSink *sink = push_array(arena, LogSink, 1);
+    sink->arena = arena;
+    String8 file_name = str8_skip_last_slash(path);
+    String8 file_name_no_ext = str8_chop_last_dot(file_name);
+    sink->path_base = push_str8_copy(arena, str8_prefix(path, path.size - file_name.size + file_name_no_ext.size));
+    sink->path_ext = push_str8_copy(arena, str8_skip(path, sink->path_base.size));
+    sink->max_file_size = Max(max_file_size, KB(64));
+    sink->max_file_count = Max(max_file_count, 1);
+    sink->start_us = os_now_microseconds();
+    log_sink = sink;
+    log_sink_open_next_file();
+    {
+      Temp scratch = scratch_begin(0, 0);
+      DateTime now = os_now_universal_time();
+      String8 now_string = push_date_time_string(scratch.arena, &now);
+      log_sink_write(push_str8f(scratch.arena, "[log sink began at %S UTC, pid %i]\n", now_string, os_get_pid()));
+      scratch_end(scratch);
+    }
+    sink->writer_thread = os_launch_thread(log_sink_writer_thread__entry_point, 0, 0);
+  }
+}
+
+internal void
+log_sink_end(void)
+{
+  if(log_sink != 0 && ins_atomic_u64_eval_assign(&log_sink->stop, 1) == 0)
+  {
+    os_thread_wait(log_sink->writer_thread, max_U64);
+    os_release_thread_handle(log_sink->writer_thread);
+    os_file_close(log_sink->file);
+    log_sink->file = os_handle_zero();
+  }
+}
+
+internal B32
+log_sink_is_running(void)
+{
+  return (log_sink != 0 && ins_atomic_u64_eval(&log_sink->stop) == 0);
+}
+
+//- rjf: pushing messages (from any thread)
+
+internal B32
+log_sink_push(LogMsgKind kind, String8 string)
+{
+  B32 result = log_sink_is_running();
+  if(result)
+  {
+    //- rjf: first message from this thread -> claim a buffer released by an
+    // exited thread, once the writer has drained it
+    LogSinkThreadBuffer *buffer = log_sink_thread_buffer;
+    if(buffer == 0)
+    {
+      LogSinkThreadBuffer *first_buffer = (LogSinkThreadBuffer *)ins_atomic_u64_eval(&log_sink->thread_buffers_first);
+      for(LogSinkThreadBuffer *b = first_buffer; b != 0; b = b->next)
+      {
+        if(ins_atomic_u64_eval(&b->is_released) != 0 &&
+           ins_atomic_u64_eval(&b->read_pos) == b->write_pos &&
+           ins_atomic_u64_eval(&b->dropped_count_reported) == b->dropped_count &&
+           ins_atomic_u64_eval_cond_assign(&b->is_released, 0, 1) == 1)
+        {
+          buffer = b;
+          buffer->thread_id = (U32)os_get_tid();
+          log_sink_thread_buffer = buffer;
+          break;
+        }
+      }
+    }
+    
+    //- rjf: none to claim -> allocate & register a new buffer
+    if(buffer == 0)
+    {
+      Arena *arena = arena_alloc();
+      buffer = push_array(arena, LogSinkThreadBuffer, 1);
+      buffer->arena = arena;
+      buffer->thread_id = (U32)os_get_tid();
+      buffer->ring_size = LOG_SINK_THREAD_RING_SIZE;
+      buffer->ring_base = push_array_no_zero(arena, U8, buffer->ring_size);
+      for(;;)
+      {
+        U64 first = ins_atomic_u64_eval(&log_sink->thread_buffers_first);
+        buffer->next = (LogSinkThreadBuffer *)first;
+        if(ins_atomic_u64_eval_cond_assign(&log_sink->thread_buffers_first, (U64)buffer, first) == first)
+        {
+          break;
+        }
+      }
+      log_sink_thread_buffer = buffer;
+    }
+    
+    //- rjf: write record, if there is room - otherwise drop it
+    LogSinkRecordHeader header = {0};
+    header.timestamp_us = os_now_microseconds();
+    header.kind = (U32)kind;
+    header.size = (U32)Min(string.size, buffer->ring_size/4);
+    U64 record_size = AlignPow2(sizeof(header) + header.size, 8);
+    U64 write_pos = buffer->write_pos;
+    U64 read_pos = ins_atomic_u64_eval(&buffer->read_pos);
+    if(write_pos + record_size - read_pos <= buffer->ring_size)
+    {
+      write_pos += ring_write_struct(buffer->ring_base, buffer->ring_size, write_pos, &header);
+      write_pos += ring_write(buffer->ring_base, buffer->ring_size, write_pos, string.str, header.size);
+      write_pos = AlignPow2(write_pos, 8);
+      ins_atomic_u64_eval_assign(&buffer->write_pos, write_pos);
+    }
+    else
+    {
+      ins_atomic_u64_eval_assign(&buffer->dropped_count, buffer->dropped_count+1);
+    }
+  }
+  return result;
+}
+
+//- rjf: thread teardown
+
+internal void
+log_sink_release_thread_buffer(void)
+{
+  if(log_sink_thread_buffer != 0)
+  {
+    ins_atomic_u64_eval_assign(&log_sink_thread_buffer->is_released, 1);
+    log_sink_thread_buffer = 0;
+  }
+}
+
 ////////////////////////////////
 //~ rjf: Log Scopes
 
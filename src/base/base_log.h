@@ -36,6 +36,29 @@ struct Log
   LogScope *top_scope;
 };
 
+////////////////////////////////
+//~ rjf: Async Log Sink Constants
+//
+// The sink is an optional, process-wide destination for every log message
+// from every thread, independent of `Log`s & their scopes. Each thread that
+// logs gets a fixed-size ring buffer, which it alone writes to, and which one
+// background writer thread alone drains into a log file - so logging never
+// takes a lock, and never grows memory. If a thread outpaces the writer, its
+// messages are dropped (and counted), rather than blocking it. A thread's
+// buffer is handed back as its context is released, and reused by the next
+// thread which logs, once the writer has drained it - so short-lived threads
+// do not accumulate buffers.
+//
+// The writer stamps each message with its time since the sink began and the
+// logging thread's ID. Files are rotated by size: `foo.log` is written as
+// `foo.0.log`, `foo.1.log`, etc., and only the newest `max_file_count` files
+// are kept.
+//
+// While the sink is running, info messages are sent only to the sink, rather
+// than also being retained in the active log scope.
+
+#define LOG_SINK_THREAD_RING_SIZE KB(256)
+
 ////////////////////////////////
 //~ rjf: Log Creation/Selection
 
@@ -53,6 +76,15 @@ internal void log_msgf(LogMsgKind kind, char *fmt, ...);
 #define log_user_error(s)         log_msg(LogMsgKind_UserError, (s))
 #define log_user_errorf(fmt, ...) log_msgf(LogMsgKind_UserError, (fmt), __VA_ARGS__)
 
+////////////////////////////////
+//~ rjf: Async Log Sink
+
+internal void log_sink_begin(String8 path, U64 max_file_size, U64 max_file_count);
+internal void log_sink_end(void);
+internal B32 log_sink_is_running(void);
+internal B32 log_sink_push(LogMsgKind kind, String8 string);
+internal void log_sink_release_thread_buffer(void);
+
 ////////////////////////////////
 //~ rjf: Log Scopes
 
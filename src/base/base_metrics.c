@@ -0,0 +1,250 @@
+// Copyright (c) 2024 Epic Games Tools
+// Licensed under the MIT license (https://opensource.org/license/mit/)
+
+////////////////////////////////
+//~ rjf: Metrics State Types
+//
+// NOTE(rjf): these refer to OS_Handle, which is not yet defined when base's
+// headers are included, so they live here.
+//
+// Metrics are stored in a fixed-size array, which never moves. A metric is
+// fully written before the count is bumped past it, so readers need only an
+// atomic read of the count.
+
+typedef struct MetricsShared MetricsShared;
+struct MetricsShared
+{
+  Arena *arena;
+  OS_Handle register_mutex;
+  Metric *metrics;
+  U64 metrics_count;
+};
+
+////////////////////////////////
+//~ rjf: Globals
+
+global MetricsShared *metrics_shared = 0;
+
+////////////////////////////////
+//~ rjf: Top-Level Layer Initialization
+
+internal void
+metrics_init(void)
+{
+  Arena *arena = arena_alloc();
+  metrics_shared = push_array(arena, MetricsShared, 1);
+  metrics_shared->arena = arena;
+  metrics_shared->register_mutex = os_mutex_alloc();
+  metrics_shared->metrics = push_array(arena, Metric, METRIC_CAP);
+}
+
+////////////////////////////////
+//~ rjf: Registration
+
+internal Metric *
+metric_register__mutex_guarded(String8 name, MetricKind kind)
+{
+  Metric *metric = 0;
+  if(metrics_shared->metrics_count < METRIC_CAP)
+  {
+    metric = &metrics_shared->metrics[metrics_shared->metrics_count];
+    metric->name = push_str8_copy(metrics_shared->arena, name);
+    metric->kind = kind;
+  }
+  return metric;
+}
+
+internal void
+metric_counter_register(String8 name, U64 *value)
+{
+  OS_MutexScope(metrics_shared->register_mutex)
+  {
+    Metric *metric = metric_register__mutex_guarded(name, MetricKind_Counter);
+    if(metric != 0)
+    {
+      metric->value = value;
+      ins_atomic_u64_inc_eval(&metrics_shared->metrics_count);
+    }
+  }
+}
+
+internal void
+metric_gauge_register(String8 name, U64 *value)
+{
+  OS_MutexScope(metrics_shared->register_mutex)
+  {
+    Metric *metric = metric_register__mutex_guarded(name, MetricKind_Gauge);
+    if(metric != 0)
+    {
+      metric->value = value;
+      ins_atomic_u64_inc_eval(&metrics_shared->metrics_count);
+    }
+  }
+}
+
+internal MetricHistogram *
+metric_histogram_alloc(String8 name)
+{
+  MetricHistogram *histogram = 0;
+  OS_MutexScope(metrics_shared->register_mutex)
+  {
+    // NOTE(rjf): past the registry's cap, histograms are still handed out
+    // (so recording needs no checks) - they just aren't listed
+    histogram = push_array(metrics_shared->arena, MetricHistogram, 1);
+    Metric *metric = metric_register__mutex_guarded(name, MetricKind_Histogram);
+    if(metric != 0)
+    {
+      metric->histogram = histogram;
+      ins_atomic_u64_inc_eval(&metrics_shared->metrics_count);
+    }
+  }
+  return histogram;
+}
+
+////////////////////////////////
+//~ rjf: Histograms
+
+internal U64
+metric_histogram_bucket_idx_from_value(U64 value)
+{
+  // NOTE(rjf): values below 2*SUB_BUCKET_COUNT get exact buckets. above
+  // that, `value`'s top SUB_BUCKET_BITS+1 bits pick the bucket - the leading
+  // one selects the power of two, & the bits after it the linear sub-bucket.
+  U64 idx = value;
+  if(value >= METRIC_HISTOGRAM_SUB_BUCKET_COUNT)
+  {
+    U64 top_bit_idx = 63 - clz64(value);
+    U64 shift = top_bit_idx - METRIC_HISTOGRAM_SUB_BUCKET_BITS;
+    idx = shift*METRIC_HISTOGRAM_SUB_BUCKET_COUNT + (value >> shift);
+  }
+  return idx;
+}
+
+internal U64
+metric_histogram_bucket_max_from_idx(U64 idx)
+{
+  U64 result = idx;
+  if(idx >= 2*METRIC_HISTOGRAM_SUB_BUCKET_COUNT)
+  {
+    U64 shift = idx/METRIC_HISTOGRAM_SUB_BUCKET_COUNT - 1;
+    U64 top_bits = idx - shift*METRIC_HISTOGRAM_SUB_BUCKET_COUNT;
+    result = ((top_bits+1) << shift) - 1;
+  }
+  return result;
+}
+
+internal void
+metric_histogram_record(MetricHistogram *histogram, U64 value)
+{
+  U64 bucket_idx = metric_histogram_bucket_idx_from_value(value);
+  ins_atomic_u64_inc_eval(&histogram->buckets[bucket_idx]);
+  ins_atomic_u64_inc_eval(&histogram->count);
+  ins_atomic_u64_add_eval(&histogram->sum, value);
+  for(U64 prev_max = ins_atomic_u64_eval(&histogram->max); prev_max < value;)
+  {
+    U64 actual_prev_max = ins_atomic_u64_eval_cond_assign(&histogram->max, value, prev_max);
+    if(actual_prev_max == prev_max)
+    {
+      break;
+    }
+    prev_max = actual_prev_max;
+  }
+}
+
+internal U64
+metric_histogram_percentile(MetricHistogram *histogram, F64 percentile)
+{
+  // NOTE(rjf): buckets may be bumped while this runs, so the total is taken
+  // from the buckets themselves rather than from `count`
+  U64 result = 0;
+  U64 total = 0;
+  for(U64 idx = 0; idx < METRIC_HISTOGRAM_BUCKET_COUNT; idx += 1)
+  {
+    total += ins_atomic_u64_eval(&histogram->buckets[idx]);
+  }
+  if(total != 0)
+  {
+    U64 rank = (U64)(percentile*total + 0.999999);
+    rank = Clamp(1, rank, total);
+    U64 seen = 0;
+    for(U64 idx = 0; idx < METRIC_HISTOGRAM_BUCKET_COUNT; idx += 1)
+    {
+      seen += ins_atomic_u64_eval(&histogram->buckets[idx]);
+      if(seen >= rank)
+      {
+        result = metric_histogram_bucket_max_from_idx(idx);
+        break;
+      }
+    }
+    result = Min(result, ins_atomic_u64_eval(&histogram->max));
+  }
+  return result;
+}
+
+////////////////////////////////
+//~ rjf: Snapshots & Dumps
+
+internal MetricValueArray
+metric_values_snapshot(Arena *arena)
+{
+  MetricValueArray result = {0};
+  result.count = ins_atomic_u64_eval(&metrics_shared->metrics_count);
+  result.v = push_array(arena, MetricValue, result.count);
+  for(U64 idx = 0; idx < result.count; idx += 1)
+  {
+    Metric *metric = &metrics_shared->metrics[idx];
+    MetricValue *dst = &result.v[idx];
+    dst->name = metric->name;
+    dst->kind = metric->kind;
+    switch(metric->kind)
+    {
+      default:{}break;
+      case MetricKind_Counter:
+      case MetricKind_Gauge:
+      {
+        dst->value = ins_atomic_u64_eval(metric->value);
+      }break;
+      case MetricKind_Histogram:
+      {
+        MetricHistogram *histogram = metric->histogram;
+        dst->count = ins_atomic_u64_eval(&histogram->count);
+        dst->sum   = ins_atomic_u64_eval(&histogram->sum);
+        dst->max   = ins_atomic_u64_eval(&histogram->max);
+        dst->p50   = metric_histogram_percentile(histogram, 0.50);
+        dst->p90   = metric_histogram_percentile(histogram, 0.90);
+        dst->p99   = metric_histogram_percentile(histogram, 0.99);
+      }break;
+    }
+  }
+  return result;
+}
+
+internal String8
+metrics_dump(Arena *arena)
+{
+  Temp scratch = scratch_begin(&arena, 1);
+  String8List strs = {0};
+  MetricValueArray values = metric_values_snapshot(scratch.arena);
+  for(U64 idx = 0; idx < values.count; idx += 1)
+  {
+    MetricValue *v = &values.v[idx];
+    switch(v->kind)
+    {
+      default:{}break;
+      case MetricKind_Counter:
+      case MetricKind_Gauge:
+      {
+        str8_list_pushf(scratch.arena, &strs, "%S: %I64u\n", v->name, v->value);
+      }break;
+      case MetricKind_Histogram:
+      {
+        U64 mean = v->count ? v->sum/v->count : 0;
+        str8_list_pushf(scratch.arena, &strs, "%S: count %I64u, mean %I64u, p50 %I64u, p90 %I64u, p99 %I64u, max %I64u\n",
+                        v->name, v->count, mean, v->p50, v->p90, v->p99, v->max);
+      }break;
+    }
+  }
+  String8 result = str8_list_join(arena, &strs, 0);
+  scratch_end(scratch);
+  return result;
+}
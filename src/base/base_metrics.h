@@ -0,0 +1,114 @@
+// Copyright (c) 2024 Epic Games Tools
+// Licensed under the MIT license (https://opensource.org/license/mit/)
+
+#ifndef BASE_METRICS_H
+#define BASE_METRICS_H
+
+////////////////////////////////
+//~ rjf: Metrics Overview
+//
+// A process-wide registry of named metrics, so that every layer's hit/miss
+// counts & latencies can be inspected in one place - live, in the debugger's
+// developer menu, or as a text dump.
+//
+// Counters & gauges are not owned by the registry: layers keep updating the
+// atomic U64s in their own shared state, & register pointers to them once,
+// at init. Counters only ever grow; gauges (e.g. resident bytes) may shrink.
+//
+// Latency histograms are owned by the registry. They are log-linear (as in
+// HDR histograms): each power of two is split into 2^METRIC_HISTOGRAM_SUB_BUCKET_BITS
+// linear sub-buckets, so any recorded value is reported with a relative error
+// of at most 1/2^METRIC_HISTOGRAM_SUB_BUCKET_BITS, across the whole U64
+// range, in a fixed amount of memory. Recording is a few relaxed atomics -
+// no locks - so it is cheap enough for any per-task path.
+//
+// Metrics are never unregistered. Registration takes a lock; reading the
+// registry does not.
+
+////////////////////////////////
+//~ rjf: Metric Types
+
+#define METRIC_HISTOGRAM_SUB_BUCKET_BITS  3
+#define METRIC_HISTOGRAM_SUB_BUCKET_COUNT (1<<METRIC_HISTOGRAM_SUB_BUCKET_BITS)
+#define METRIC_HISTOGRAM_BUCKET_COUNT     ((64-METRIC_HISTOGRAM_SUB_BUCKET_BITS+1)*METRIC_HISTOGRAM_SUB_BUCKET_COUNT)
+#define METRIC_CAP                        1024
+
+typedef enum MetricKind
+{
+  MetricKind_Null,
+  MetricKind_Counter,
+  MetricKind_Gauge,
+  MetricKind_Histogram,
+  MetricKind_COUNT
+}
+MetricKind;
+
+typedef struct MetricHistogram MetricHistogram;
+struct MetricHistogram
+{
+  U64 count;
+  U64 sum;
+  U64 max;
+  U64 buckets[METRIC_HISTOGRAM_BUCKET_COUNT];
+};
+
+typedef struct Metric Metric;
+struct Metric
+{
+  String8 name;
+  MetricKind kind;
+  U64 *value;
+  MetricHistogram *histogram;
+};
+
+////////////////////////////////
+//~ rjf: Snapshot Types
+
+typedef struct MetricValue MetricValue;
+struct MetricValue
+{
+  String8 name;
+  MetricKind kind;
+  U64 value;
+  U64 count;
+  U64 sum;
+  U64 max;
+  U64 p50;
+  U64 p90;
+  U64 p99;
+};
+
+typedef struct MetricValueArray MetricValueArray;
+struct MetricValueArray
+{
+  MetricValue *v;
+  U64 count;
+};
+
+////////////////////////////////
+//~ rjf: Top-Level Layer Initialization
+
+internal void metrics_init(void);
+
+////////////////////////////////
+//~ rjf: Registration
+
+internal void metric_counter_register(String8 name, U64 *value);
+internal void metric_gauge_register(String8 name, U64 *value);
+internal MetricHistogram *metric_histogram_alloc(String8 name);
+
+////////////////////////////////
+//~ rjf: Histograms
+
+internal U64 metric_histogram_bucket_idx_from_value(U64 value);
+internal U64 metric_histogram_bucket_max_from_idx(U64 idx);
+internal void metric_histogram_record(MetricHistogram *histogram, U64 value);
+internal U64 metric_histogram_percentile(MetricHistogram *histogram, F64 percentile);
+
+////////////////////////////////
+//~ rjf: Snapshots & Dumps
+
+internal MetricValueArray metric_values_snapshot(Arena *arena);
+internal String8 metrics_dump(Arena *arena);
+
+#endif // BASE_METRICS_H
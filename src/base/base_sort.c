@@ -0,0 +1,89 @@
+// Copyright (c) 2024 Epic Games Tools
+// Licensed under the MIT license (https://opensource.org/license/mit/)
+
+////////////////////////////////
+//~ rjf: Radix Sort Building Blocks
+
+internal U64
+sort_key_array_varying_key_bits(SortKey *keys, U64 count)
+{
+  U64 result = 0;
+  if(count != 0)
+  {
+    U64 first_key = keys[0].key;
+    for(U64 idx = 1; idx < count; idx += 1)
+    {
+      result |= keys[idx].key ^ first_key;
+    }
+  }
+  return result;
+}
+
+internal U64
+sort_key_radix_digit_shifts_from_varying_key_bits(U64 varying_key_bits, U64 *shifts_out)
+{
+  U64 digit_count = 0;
+  for(U64 digit_idx = 0; digit_idx < SORT_KEY_RADIX_DIGIT_COUNT; digit_idx += 1)
+  {
+    U64 shift = digit_idx*SORT_KEY_RADIX_DIGIT_BITS;
+    if((varying_key_bits >> shift) & (SORT_KEY_RADIX_BUCKET_COUNT-1))
+    {
+      shifts_out[digit_count] = shift;
+      digit_count += 1;
+    }
+  }
+  return digit_count;
+}
+
+internal void
+sort_key_radix_histogram(SortKey *keys, U64 count, U64 shift, U64 *counts_out)
+{
+  MemoryZero(counts_out, sizeof(counts_out[0])*SORT_KEY_RADIX_BUCKET_COUNT);
+  for(U64 idx = 0; idx < count; idx += 1)
+  {
+    counts_out[(keys[idx].key >> shift) & (SORT_KEY_RADIX_BUCKET_COUNT-1)] += 1;
+  }
+}
+
+internal void
+sort_key_radix_scatter(SortKey *src, U64 count, U64 shift, U64 *offsets, SortKey *dst)
+{
+  for(U64 idx = 0; idx < count; idx += 1)
+  {
+    U64 bucket = (src[idx].key >> shift) & (SORT_KEY_RADIX_BUCKET_COUNT-1);
+    dst[offsets[bucket]] = src[idx];
+    offsets[bucket] += 1;
+  }
+}
+
+////////////////////////////////
+//~ rjf: Single-Threaded Radix Sort
+
+internal SortKey *
+sort_key_array_radix(Arena *arena, SortKey *keys, U64 count)
+{
+  SortKey *result = keys;
+  U64 shifts[SORT_KEY_RADIX_DIGIT_COUNT] = {0};
+  U64 digit_count = sort_key_radix_digit_shifts_from_varying_key_bits(sort_key_array_varying_key_bits(keys, count), shifts);
+  if(digit_count != 0)
+  {
+    SortKey *bufs[2] = {keys, push_array_no_zero(arena, SortKey, count)};
+    U64 counts[SORT_KEY_RADIX_BUCKET_COUNT];
+    for(U64 digit_idx = 0; digit_idx < digit_count; digit_idx += 1)
+    {
+      SortKey *src = bufs[digit_idx%2];
+      SortKey *dst = bufs[(digit_idx+1)%2];
+      sort_key_radix_histogram(src, count, shifts[digit_idx], counts);
+      U64 off = 0;
+      for(U64 bucket = 0; bucket < SORT_KEY_RADIX_BUCKET_COUNT; bucket += 1)
+      {
+        U64 bucket_count = counts[bucket];
+        counts[bucket] = off;
+        off += bucket_count;
+      }
+      sort_key_radix_scatter(src, count, shifts[digit_idx], counts, dst);
+    }
+    result = bufs[digit_count%2];
+  }
+  return result;
+}
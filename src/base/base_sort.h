@@ -0,0 +1,48 @@
+// Copyright (c) 2024 Epic Games Tools
+// Licensed under the MIT license (https://opensource.org/license/mit/)
+
+#ifndef BASE_SORT_H
+#define BASE_SORT_H
+
+////////////////////////////////
+//~ rjf: Sort Key Types
+//
+// A (U64 key, pointer value) pair, sorted by key. Laid out identically to
+// RDIM_SortKey, so rdi_make's key arrays may be passed through directly.
+
+typedef struct SortKey SortKey;
+struct SortKey
+{
+  U64 key;
+  void *val;
+};
+
+////////////////////////////////
+//~ rjf: Radix Sort Constants
+
+#define SORT_KEY_RADIX_DIGIT_BITS   8
+#define SORT_KEY_RADIX_BUCKET_COUNT (1<<SORT_KEY_RADIX_DIGIT_BITS)
+#define SORT_KEY_RADIX_DIGIT_COUNT  (64/SORT_KEY_RADIX_DIGIT_BITS)
+
+////////////////////////////////
+//~ rjf: Radix Sort Building Blocks
+//
+// LSD radix sort, one byte per digit. Digits on which every key agrees are
+// skipped entirely - e.g. 32-bit virtual offsets only need four passes. Each
+// digit pass is a histogram step followed by a scatter step; both operate on
+// a sub-range of the array, so passes may be split across threads so long as
+// each sub-range's scatter offsets come from the prefix sum of all preceding
+// sub-ranges' histograms.
+
+internal U64 sort_key_array_varying_key_bits(SortKey *keys, U64 count);
+internal U64 sort_key_radix_digit_shifts_from_varying_key_bits(U64 varying_key_bits, U64 *shifts_out);
+internal void sort_key_radix_histogram(SortKey *keys, U64 count, U64 shift, U64 *counts_out);
+internal void sort_key_radix_scatter(SortKey *src, U64 count, U64 shift, U64 *offsets, SortKey *dst);
+
+////////////////////////////////
+//~ rjf: Single-Threaded Radix Sort
+
+// NOTE(rjf): stable. returns either `keys` or a new array pushed onto `arena`.
+internal SortKey *sort_key_array_radix(Arena *arena, SortKey *keys, U64 count);
+
+#endif // BASE_SORT_H
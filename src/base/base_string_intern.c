@@ -0,0 +1,187 @@
+// Copyright (c) 2024 Epic Games Tools
+// Licensed under the MIT license (https://opensource.org/license/mit/)
+
+////////////////////////////////
+//~ rjf: String Interning State Types
+//
+// NOTE(rjf): these refer to OS_Handle, which is not yet defined when base's
+// headers are included, so they live here.
+//
+// An ID packs the shard index in its low bits, and the 1-based index of the
+// string within that shard above them. Each shard stores its entries in
+// fixed-size chunks which never move once pushed, found via a fixed-size
+// chunk directory - so ID -> string lookups never race with growth, and need
+// no lock (the caller must have obtained the ID via some synchronized path,
+// which is always true for IDs passed between threads by ordinary means).
+
+#define STRING_INTERN_CHUNK_ENTRY_COUNT     4096
+#define STRING_INTERN_SHARD_CHUNK_COUNT_MAX 1024
+
+typedef struct StringInternEntry StringInternEntry;
+struct StringInternEntry
+{
+  String8 string;
+  U64 hash;
+};
+
+typedef struct StringInternShard StringInternShard;
+struct StringInternShard
+{
+  OS_Handle rw_mutex;
+  Arena *arena;
+  HashMap *map;
+  U64 count;
+  StringInternEntry **chunks;
+};
+
+typedef struct StringInternShared StringInternShared;
+struct StringInternShared
+{
+  Arena *arena;
+  StringInternShard shards[STRING_INTERN_SHARD_COUNT];
+};
+
+////////////////////////////////
+//~ rjf: Globals
+
+global StringInternShared *string_intern_shared = 0;
+
+////////////////////////////////
+//~ rjf: Top-Level Layer Initialization
+
+internal void
+string_intern_init(void)
+{
+  Arena *arena = arena_alloc();
+  string_intern_shared = push_array(arena, StringInternShared, 1);
+  string_intern_shared->arena = arena;
+  for(U64 idx = 0; idx < STRING_INTERN_SHARD_COUNT; idx += 1)
+  {
+    StringInternShard *shard = &string_intern_shared->shards[idx];
+    shard->rw_mutex = os_rw_mutex_alloc();
+    shard->arena = arena_alloc();
+    shard->map = hash_map_alloc(shard->arena, 1024);
+    shard->chunks = push_array(shard->arena, StringInternEntry *, STRING_INTERN_SHARD_CHUNK_COUNT_MAX);
+  }
+}
+
+////////////////////////////////
+//~ rjf: String ID Basics
+
+internal StringID
+string_id_zero(void)
+{
+  StringID id = {0};
+  return id;
+}
+
+internal B32
+string_id_match(StringID a, StringID b)
+{
+  return a.u64[0] == b.u64[0];
+}
+
+////////////////////////////////
+//~ rjf: Interning/Lookups
+
+internal StringID
+string_id_from_str8(String8 string)
+{
+  StringID result = {0};
+  if(string.size != 0)
+  {
+    // rjf: pick shard from the high hash bits - the map uses the low ones
+    U64 hash = hash_map_hash_from_str8(string);
+    U64 shard_idx = hash >> (64 - STRING_INTERN_SHARD_BITS);
+    StringInternShard *shard = &string_intern_shared->shards[shard_idx];
+
+    // rjf: fast path: already interned
+    B32 found = 0;
+    OS_MutexScopeR(shard->rw_mutex)
+    {
+      HashMapSlot *slot = hash_map_slot_from_hash_key(shard->map, hash, string);
+      if(slot != 0)
+      {
+        found = 1;
+        result.u64[0] = slot->value;
+      }
+    }
+
+    // rjf: slow path: intern (re-checking, as another thread may have raced us)
+    if(!found) OS_MutexScopeW(shard->rw_mutex)
+    {
+      B32 is_new = 0;
+      HashMapSlot *slot = hash_map_ensure_hash_key(shard->arena, shard->map, hash, string, &is_new);
+      if(is_new)
+      {
+        U64 entry_idx = shard->count;
+        U64 chunk_idx = entry_idx/STRING_INTERN_CHUNK_ENTRY_COUNT;
+        if(Unlikely(chunk_idx >= STRING_INTERN_SHARD_CHUNK_COUNT_MAX))
+        {
+#if OS_FEATURE_GRAPHICAL
+          os_graphical_message(1, str8_lit("Fatal Allocation Failure"), str8_lit("String interning table is full."));
+#endif
+          os_exit_process(1);
+        }
+        if(shard->chunks[chunk_idx] == 0)
+        {
+          shard->chunks[chunk_idx] = push_array_no_zero(shard->arena, StringInternEntry, STRING_INTERN_CHUNK_ENTRY_COUNT);
+        }
+        StringInternEntry *entry = &shard->chunks[chunk_idx][entry_idx%STRING_INTERN_CHUNK_ENTRY_COUNT];
+        entry->string = push_str8_copy(shard->arena, string);
+        entry->hash = hash;
+        shard->count += 1;
+        slot->key = entry->string;
+        slot->value = ((entry_idx+1) << STRING_INTERN_SHARD_BITS) | shard_idx;
+      }
+      result.u64[0] = slot->value;
+    }
+  }
+  return result;
+}
+
+internal StringID
+string_id_lookup(String8 string)
+{
+  StringID result = {0};
+  if(string.size != 0)
+  {
+    U64 hash = hash_map_hash_from_str8(string);
+    StringInternShard *shard = &string_intern_shared->shards[hash >> (64 - STRING_INTERN_SHARD_BITS)];
+    OS_MutexScopeR(shard->rw_mutex)
+    {
+      HashMapSlot *slot = hash_map_slot_from_hash_key(shard->map, hash, string);
+      if(slot != 0)
+      {
+        result.u64[0] = slot->value;
+      }
+    }
+  }
+  return result;
+}
+
+internal String8
+str8_from_string_id(StringID id)
+{
+  String8 result = {0};
+  if(id.u64[0] != 0)
+  {
+    StringInternShard *shard = &string_intern_shared->shards[id.u64[0] & (STRING_INTERN_SHARD_COUNT-1)];
+    U64 entry_idx = (id.u64[0] >> STRING_INTERN_SHARD_BITS) - 1;
+    result = shard->chunks[entry_idx/STRING_INTERN_CHUNK_ENTRY_COUNT][entry_idx%STRING_INTERN_CHUNK_ENTRY_COUNT].string;
+  }
+  return result;
+}
+
+internal U64
+hash_from_string_id(StringID id)
+{
+  U64 result = 0;
+  if(id.u64[0] != 0)
+  {
+    StringInternShard *shard = &string_intern_shared->shards[id.u64[0] & (STRING_INTERN_SHARD_COUNT-1)];
+    U64 entry_idx = (id.u64[0] >> STRING_INTERN_SHARD_BITS) - 1;
+    result = shard->chunks[entry_idx/STRING_INTERN_CHUNK_ENTRY_COUNT][entry_idx%STRING_INTERN_CHUNK_ENTRY_COUNT].hash;
+  }
+  return result;
+}
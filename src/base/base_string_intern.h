@@ -0,0 +1,58 @@
+// Copyright (c) 2024 Epic Games Tools
+// Licensed under the MIT license (https://opensource.org/license/mit/)
+
+#ifndef BASE_STRING_INTERN_H
+#define BASE_STRING_INTERN_H
+
+////////////////////////////////
+//~ rjf: String Interning Types
+//
+// A process-wide, thread-safe table which maps each distinct byte string to
+// a `StringID`. Interning the same bytes twice (from any thread) produces the
+// same ID, so two interned strings are equal iff their IDs are equal, and an
+// ID's content hash is stored alongside it. The zero ID is the empty string.
+//
+// Interned strings are copied once into the table, null-terminated, and are
+// never freed - the `String8` returned for an ID stays valid for the rest of
+// the process. This makes interning a good fit for bounded sets of strings
+// which are copied & compared often (file path parts, symbol names, type
+// names), and a bad fit for arbitrary user-edited text.
+//
+// The table is split into shards by hash, each with its own lock, so threads
+// interning unrelated strings rarely contend. ID -> string lookups take no
+// lock at all.
+
+#define STRING_INTERN_SHARD_BITS   6
+#define STRING_INTERN_SHARD_COUNT  (1<<STRING_INTERN_SHARD_BITS)
+
+typedef struct StringID StringID;
+struct StringID
+{
+  U64 u64[1];
+};
+
+////////////////////////////////
+//~ rjf: Top-Level Layer Initialization
+
+internal void string_intern_init(void);
+
+////////////////////////////////
+//~ rjf: String ID Basics
+
+internal StringID string_id_zero(void);
+internal B32 string_id_match(StringID a, StringID b);
+
+////////////////////////////////
+//~ rjf: Interning/Lookups
+
+// NOTE(rjf): interns `string` if it is not yet interned
+internal StringID string_id_from_str8(String8 string);
+
+// NOTE(rjf): returns the zero ID if `string` is not interned - since no
+// interned ID can then match it, callers may skip comparisons entirely
+internal StringID string_id_lookup(String8 string);
+
+internal String8 str8_from_string_id(StringID id);
+internal U64 hash_from_string_id(StringID id);
+
+#endif // BASE_STRING_INTERN_H
@@ -22,6 +22,7 @@ tctx_init_and_equip(TCTX *tctx){
 internal void
 tctx_release(void)
 {
+  log_sink_release_thread_buffer();
   for(U64 i = 0; i < ArrayCount(tctx_thread_local->arenas); i += 1)
   {
     arena_release(tctx_thread_local->arenas[i]);
@@ -0,0 +1,1088 @@
+// Copyright (c) 2024 Epic Games Tools
+// Licensed under the MIT license (https://opensource.org/license/mit/)
+
+////////////////////////////////
+//~ rjf: Main Layer Initialization
+
+internal void
+ce_init(void)
+{
+  Arena *arena = arena_alloc();
+  ce_shared = push_array(arena, CE_Shared, 1);
+  ce_shared->arena = arena;
+  ce_shared->evict_threshold_us = 10*1000000;
+  ce_shared->evict_threshold_user_clocks = 10;
+  ce_shared->retry_threshold_us = 1*1000000;
+  ce_shared->retry_threshold_user_clocks = 10;
+  ce_shared->poll_interval_us = 100*1000;
+  ce_shared->caches_mutex = os_mutex_alloc();
+  ce_shared->evictor_mutex = os_mutex_alloc();
+  ce_shared->evictor_cv = os_condition_variable_alloc();
+  ce_shared->evictor_wake_us = max_U64;
+  ce_shared->evictor_thread = os_launch_thread(ce_evictor_thread__entry_point, 0, 0);
+}
+
+////////////////////////////////
+//~ rjf: Thread Context Initialization
+
+internal void
+ce_tctx_ensure_inited(void)
+{
+  if(ce_tctx == 0)
+  {
+    Arena *arena = arena_alloc();
+    ce_tctx = push_array(arena, CE_TCTX, 1);
+    ce_tctx->arena = arena;
+  }
+}
+
+////////////////////////////////
+//~ rjf: Request Priorities & Deadlines
+
+internal void
+ce_push_priority(CE_Priority priority)
+{
+  ce_tctx_ensure_inited();
+  if(ce_tctx->priority_stack_count < CE_PRIORITY_STACK_CAP)
+  {
+    ce_tctx->priority_stack[ce_tctx->priority_stack_count] = priority;
+  }
+  ce_tctx->priority_stack_count += 1;
+}
+
+internal void
+ce_pop_priority(void)
+{
+  ce_tctx_ensure_inited();
+  if(ce_tctx->priority_stack_count > 0)
+  {
+    ce_tctx->priority_stack_count -= 1;
+  }
+}
+
+internal CE_Priority
+ce_top_priority(void)
+{
+  ce_tctx_ensure_inited();
+  CE_Priority result = CE_Priority_Visible;
+  if(ce_tctx->priority_stack_count > 0)
+  {
+    result = ce_tctx->priority_stack[Min(ce_tctx->priority_stack_count, CE_PRIORITY_STACK_CAP)-1];
+  }
+  return result;
+}
+
+internal void
+ce_set_request_deadline(U64 deadline_us)
+{
+  ce_tctx_ensure_inited();
+  ce_tctx->request_deadline_us = deadline_us;
+}
+
+internal U64
+ce_request_deadline(void)
+{
+  ce_tctx_ensure_inited();
+  return ce_tctx->request_deadline_us;
+}
+
+////////////////////////////////
+//~ rjf: Cache Allocation
+
+internal CE_Cache *
+ce_cache_alloc(CE_CacheParams *params)
+{
+  Arena *arena = arena_alloc();
+  CE_Cache *cache = push_array(arena, CE_Cache, 1);
+  cache->arena = arena;
+  cache->name = push_str8_copy(arena, params->name);
+  cache->val_size = params->val_size;
+  cache->compute = params->compute;
+  cache->release = params->release;
+  cache->change_gen = params->change_gen;
+  cache->slots_count = params->slots_count ? params->slots_count : 1024;
+  cache->stripes_count = Min(cache->slots_count, os_logical_core_count());
+  cache->slots = push_array(arena, CE_Slot, cache->slots_count);
+  cache->stripes = push_array(arena, CE_Stripe, cache->stripes_count);
+  for(U64 idx = 0; idx < cache->stripes_count; idx += 1)
+  {
+    cache->stripes[idx].arena = arena_alloc();
+    cache->stripes[idx].rw_mutex = os_rw_mutex_alloc();
+    cache->stripes[idx].cv = os_condition_variable_alloc();
+  }
+  cache->u2w_ring_size = KB(64);
+  for(U64 idx = 0; idx < CE_Priority_COUNT; idx += 1)
+  {
+    cache->u2w_ring_base[idx] = push_array_no_zero(arena, U8, cache->u2w_ring_size);
+  }
+  cache->u2w_ring_cv = os_condition_variable_alloc();
+  cache->u2w_ring_mutex = os_mutex_alloc();
+  cache->retired_mutex = os_mutex_alloc();
+  cache->evict_heap_mutex = os_mutex_alloc();
+  cache->evict_heap_arena = arena_alloc();
+  cache->worker_thread_count = params->worker_thread_count ? params->worker_thread_count : 1;
+  cache->worker_threads = push_array(arena, OS_Handle, cache->worker_thread_count);
+  for(U64 idx = 0; idx < cache->worker_thread_count; idx += 1)
+  {
+    cache->worker_threads[idx] = os_launch_thread(ce_worker_thread__entry_point, cache, 0);
+  }
+
+  //- rjf: register metrics, named after the cache
+  {
+    Temp scratch = scratch_begin(0, 0);
+    struct
+    {
+      char *name;
+      U64 *value;
+    }
+    counters[] =
+    {
+      {"lookups",          &cache->stats.lookup_count},
+      {"hits",             &cache->stats.hit_count},
+      {"misses",           &cache->stats.miss_count},
+      {"requests",         &cache->stats.request_count},
+      {"request_stalls",   &cache->stats.request_stall_count},
+      {"request_upgrades", &cache->stats.request_upgrade_count},
+      {"deadline_misses",  &cache->stats.deadline_miss_count},
+      {"computes",         &cache->stats.compute_count},
+      {"recomputes",       &cache->stats.recompute_count},
+      {"retires",          &cache->stats.retire_count},
+      {"reclaims",         &cache->stats.reclaim_count},
+      {"evictions",        &cache->stats.evict_count},
+    };
+    metric_gauge_register(push_str8f(scratch.arena, "%S.nodes", cache->name), &cache->stats.node_count);
+    for(U64 idx = 0; idx < ArrayCount(counters); idx += 1)
+    {
+      metric_counter_register(push_str8f(scratch.arena, "%S.%s", cache->name, counters[idx].name), counters[idx].value);
+    }
+    cache->queue_us_histogram   = metric_histogram_alloc(push_str8f(scratch.arena, "%S.queue_us", cache->name));
+    cache->compute_us_histogram = metric_histogram_alloc(push_str8f(scratch.arena, "%S.compute_us", cache->name));
+    scratch_end(scratch);
+  }
+  OS_MutexScope(ce_shared->caches_mutex)
+  {
+    SLLQueuePush(ce_shared->first_cache, ce_shared->last_cache, cache);
+    ce_shared->cache_count += 1;
+  }
+  return cache;
+}
+
+////////////////////////////////
+//~ rjf: User Clock
+
+internal void
+ce_cache_user_clock_tick(CE_Cache *cache)
+{
+  ins_atomic_u64_inc_eval(&cache->user_clock_idx);
+}
+
+internal U64
+ce_cache_user_clock_idx(CE_Cache *cache)
+{
+  return ins_atomic_u64_eval(&cache->user_clock_idx);
+}
+
+////////////////////////////////
+//~ rjf: Metrics
+
+internal CE_Stats
+ce_stats_from_cache(CE_Cache *cache)
+{
+  CE_Stats stats = {0};
+  stats.node_count            = ins_atomic_u64_eval(&cache->stats.node_count);
+  stats.lookup_count          = ins_atomic_u64_eval(&cache->stats.lookup_count);
+  stats.hit_count             = ins_atomic_u64_eval(&cache->stats.hit_count);
+  stats.miss_count            = ins_atomic_u64_eval(&cache->stats.miss_count);
+  stats.request_count         = ins_atomic_u64_eval(&cache->stats.request_count);
+  stats.request_stall_count   = ins_atomic_u64_eval(&cache->stats.request_stall_count);
+  stats.request_upgrade_count = ins_atomic_u64_eval(&cache->stats.request_upgrade_count);
+  stats.deadline_miss_count   = ins_atomic_u64_eval(&cache->stats.deadline_miss_count);
+  stats.compute_count         = ins_atomic_u64_eval(&cache->stats.compute_count);
+  stats.compute_us_total      = ins_atomic_u64_eval(&cache->stats.compute_us_total);
+  stats.compute_us_max        = ins_atomic_u64_eval(&cache->stats.compute_us_max);
+  stats.recompute_count       = ins_atomic_u64_eval(&cache->stats.recompute_count);
+  stats.retire_count          = ins_atomic_u64_eval(&cache->stats.retire_count);
+  stats.reclaim_count         = ins_atomic_u64_eval(&cache->stats.reclaim_count);
+  stats.evict_count           = ins_atomic_u64_eval(&cache->stats.evict_count);
+  return stats;
+}
+
+////////////////////////////////
+//~ rjf: Scoped Access
+
+internal CE_Scope *
+ce_scope_open(void)
+{
+  ce_tctx_ensure_inited();
+  CE_Scope *scope = ce_tctx->free_scope;
+  if(scope)
+  {
+    SLLStackPop(ce_tctx->free_scope);
+  }
+  else
+  {
+    scope = push_array_no_zero(ce_tctx->arena, CE_Scope, 1);
+  }
+  MemoryZeroStruct(scope);
+  epoch_enter();
+  return scope;
+}
+
+internal void
+ce_scope_close(CE_Scope *scope)
+{
+  epoch_leave();
+  SLLStackPush(ce_tctx->free_scope, scope);
+}
+
+internal void
+ce_node_touch__stripe_r_guarded(CE_Cache *cache, CE_Node *node)
+{
+  // NOTE(rjf): touches only feed the eviction policy, which works at far
+  // coarser granularity than a frame - so skip the store (& the cache line
+  // ping-pong it causes between readers) unless the touch time has moved.
+  U64 now_us = os_now_microseconds();
+  U64 user_clock_idx = ce_cache_user_clock_idx(cache);
+  if(ins_atomic_u64_eval(&node->last_time_touched_us)+1000 <= now_us)
+  {
+    ins_atomic_u64_eval_assign(&node->last_time_touched_us, now_us);
+  }
+  if(ins_atomic_u64_eval(&node->last_user_clock_idx_touched) != user_clock_idx)
+  {
+    ins_atomic_u64_eval_assign(&node->last_user_clock_idx_touched, user_clock_idx);
+  }
+}
+
+////////////////////////////////
+//~ rjf: Retirement
+
+internal void
+ce_cache_retire_val(CE_Cache *cache, void *val)
+{
+  // NOTE(rjf): the value must already be unreachable from the table, so that
+  // only scopes which were open before this call can still be using it.
+  OS_MutexScope(cache->retired_mutex)
+  {
+    CE_Retired *retired = cache->free_retired;
+    if(retired != 0)
+    {
+      SLLStackPop(cache->free_retired);
+    }
+    else
+    {
+      retired = push_array(cache->arena, CE_Retired, 1);
+      retired->val = push_array_no_zero(cache->arena, U8, cache->val_size);
+    }
+    MemoryCopy(retired->val, val, cache->val_size);
+    retired->retire_epoch = epoch_retire();
+    retired->next = 0;
+    SLLQueuePush(cache->first_retired, cache->last_retired, retired);
+  }
+  ins_atomic_u64_inc_eval(&cache->stats.retire_count);
+  ce_evictor_wake_by(os_now_microseconds() + ce_shared->poll_interval_us);
+}
+
+internal void
+ce_cache_reclaim_retired_vals(CE_Cache *cache, U64 watermark)
+{
+  //- rjf: detach reclaimable prefix - retire epochs only increase along the
+  // queue, so the first unreclaimable value ends it
+  CE_Retired *first = 0;
+  CE_Retired *last = 0;
+  OS_MutexScope(cache->retired_mutex)
+  {
+    for(CE_Retired *r = cache->first_retired; r != 0 && r->retire_epoch <= watermark; r = r->next)
+    {
+      first = cache->first_retired;
+      last = r;
+    }
+    if(last != 0)
+    {
+      cache->first_retired = last->next;
+      if(cache->first_retired == 0)
+      {
+        cache->last_retired = 0;
+      }
+      last->next = 0;
+    }
+  }
+
+  //- rjf: release values outside of the lock, then recycle records
+  U64 count = 0;
+  for(CE_Retired *r = first; r != 0; r = r->next)
+  {
+    cache->release(r->val);
+    count += 1;
+  }
+  if(last != 0) OS_MutexScope(cache->retired_mutex)
+  {
+    last->next = cache->free_retired;
+    cache->free_retired = first;
+  }
+  if(count != 0)
+  {
+    ins_atomic_u64_add_eval(&cache->stats.reclaim_count, count);
+  }
+}
+
+////////////////////////////////
+//~ rjf: Cache Lookups
+
+internal CE_Lookup
+ce_val_from_hash_params(CE_Scope *scope, CE_Cache *cache, U128 hash, String8 params, void *val_out)
+{
+  CE_Lookup result = {0};
+  MemoryZero(val_out, cache->val_size);
+  if(!u128_match(hash, u128_zero()))
+  {
+    CE_Priority priority = ce_top_priority();
+    U64 deadline_us = ce_request_deadline();
+    U64 slot_idx = hash.u64[1]%cache->slots_count;
+    U64 stripe_idx = slot_idx%cache->stripes_count;
+    CE_Slot *slot = &cache->slots[slot_idx];
+    CE_Stripe *stripe = &cache->stripes[stripe_idx];
+    ins_atomic_u64_inc_eval(&cache->stats.lookup_count);
+
+    //- rjf: fast path: node exists -> copy value & touch. if it is not yet
+    // computed, & either its request was dropped, or it was requested at a
+    // less urgent priority, then (re-)request it.
+    B32 found = 0;
+    B32 is_rerequest = 0;
+    B32 is_upgrade = 0;
+    OS_MutexScopeR(stripe->rw_mutex)
+    {
+      for(CE_Node *n = slot->first; n != 0; n = n->next)
+      {
+        if(u128_match(hash, n->hash) && str8_match(params, n->params, 0))
+        {
+          B32 is_requested = n->is_requested;
+          B32 is_working = n->is_working;
+          MemoryCopy(val_out, n->val, cache->val_size);
+          result.is_loaded = (ins_atomic_u64_eval(&n->load_count) != 0);
+          result.progress_done = ins_atomic_u64_eval(&n->progress_done);
+          result.progress_total = ins_atomic_u64_eval(&n->progress_total);
+          found = 1;
+          ce_node_touch__stripe_r_guarded(cache, n);
+          if(!result.is_loaded && !is_working)
+          {
+            U64 request_priority = ins_atomic_u64_eval(&n->request_priority);
+            if(!is_requested && !ins_atomic_u32_eval_cond_assign(&n->is_requested, 1, 0))
+            {
+              ins_atomic_u64_eval_assign(&n->request_priority, (U64)priority);
+              is_rerequest = 1;
+            }
+            else if(is_requested && (U64)priority < request_priority &&
+                    ins_atomic_u64_eval_cond_assign(&n->request_priority, (U64)priority, request_priority) == request_priority)
+            {
+              is_upgrade = 1;
+            }
+          }
+          break;
+        }
+      }
+    }
+
+    //- rjf: slow path: create node (re-checking, as another thread may have raced us)
+    if(!found) OS_MutexScopeW(stripe->rw_mutex)
+    {
+      CE_Node *node = 0;
+      for(CE_Node *n = slot->first; n != 0; n = n->next)
+      {
+        if(u128_match(hash, n->hash) && str8_match(params, n->params, 0))
+        {
+          node = n;
+          break;
+        }
+      }
+      if(node == 0)
+      {
+        // rjf: allocate, or reuse a freed node along with its buffers - all
+        // nodes in a cache have the same value size
+        node = stripe->free_node;
+        if(node)
+        {
+          SLLStackPop(stripe->free_node);
+        }
+        else
+        {
+          node = push_array(stripe->arena, CE_Node, 1);
+          node->val = push_array_no_zero(stripe->arena, U8, cache->val_size);
+        }
+        void *val = node->val;
+        U64 alloc_gen = node->alloc_gen + 1;
+        U8 *params_buffer = node->params.str;
+        U64 params_cap = node->params_cap;
+        if(params.size > params_cap)
+        {
+          params_buffer = push_array_no_zero(stripe->arena, U8, params.size);
+          params_cap = params.size;
+        }
+        MemoryCopy(params_buffer, params.str, params.size);
+        MemoryZeroStruct(node);
+        MemoryZero(val, cache->val_size);
+        node->val = val;
+        node->alloc_gen = alloc_gen;
+        node->hash = hash;
+        node->params = str8(params_buffer, params.size);
+        node->params_cap = params_cap;
+        node->is_requested = 1;
+        node->request_priority = (U64)priority;
+        node->last_time_touched_us = os_now_microseconds();
+        node->last_user_clock_idx_touched = ce_cache_user_clock_idx(cache);
+        DLLPushBack(slot->first, slot->last, node);
+        result.is_new = 1;
+        
+        // rjf: schedule the first eviction check now, rather than once loaded
+        // - a node whose request is dropped, & which is never looked up again,
+        // would otherwise never be checked
+        ce_cache_schedule_evict_check__stripe_w_guarded(cache, node, node->last_time_touched_us + ce_shared->evict_threshold_us);
+      }
+    }
+
+    //- rjf: bump stats
+    if(result.is_new)
+    {
+      ins_atomic_u64_inc_eval(&cache->stats.node_count);
+      ins_atomic_u64_inc_eval(&cache->stats.miss_count);
+    }
+    else if(result.is_loaded)
+    {
+      ins_atomic_u64_inc_eval(&cache->stats.hit_count);
+    }
+    if(is_upgrade)
+    {
+      ins_atomic_u64_inc_eval(&cache->stats.request_upgrade_count);
+    }
+
+    //- rjf: send request. prefetches never wait for room; others wait until
+    // the deadline at most. a dropped request is un-marked, so that a later
+    // lookup sends it again. (a dropped upgrade needs nothing - the less
+    // urgent request is still queued.)
+    if(result.is_new || is_rerequest || is_upgrade)
+    {
+      U64 endt_us = (priority == CE_Priority_Prefetch ? 0 : deadline_us != 0 ? deadline_us : max_U64);
+      B32 sent = ce_u2w_enqueue_req(cache, priority, hash, params, deadline_us, endt_us);
+      if(!sent && !is_upgrade) OS_MutexScopeR(stripe->rw_mutex)
+      {
+        for(CE_Node *n = slot->first; n != 0; n = n->next)
+        {
+          if(u128_match(hash, n->hash) && str8_match(params, n->params, 0))
+          {
+            ins_atomic_u32_eval_assign(&n->is_requested, 0);
+            break;
+          }
+        }
+      }
+    }
+  }
+  return result;
+}
+
+internal B32
+ce_peek_val_from_hash_params(CE_Scope *scope, CE_Cache *cache, U128 hash, String8 params, void *val_out)
+{
+  B32 result = 0;
+  MemoryZero(val_out, cache->val_size);
+  if(!u128_match(hash, u128_zero()))
+  {
+    U64 slot_idx = hash.u64[1]%cache->slots_count;
+    U64 stripe_idx = slot_idx%cache->stripes_count;
+    CE_Slot *slot = &cache->slots[slot_idx];
+    CE_Stripe *stripe = &cache->stripes[stripe_idx];
+    OS_MutexScopeR(stripe->rw_mutex)
+    {
+      for(CE_Node *n = slot->first; n != 0; n = n->next)
+      {
+        if(u128_match(hash, n->hash) && str8_match(params, n->params, 0))
+        {
+          if(ins_atomic_u64_eval(&n->load_count) != 0)
+          {
+            MemoryCopy(val_out, n->val, cache->val_size);
+            ce_node_touch__stripe_r_guarded(cache, n);
+            result = 1;
+          }
+          break;
+        }
+      }
+    }
+  }
+  return result;
+}
+
+////////////////////////////////
+//~ rjf: Worker Threads
+
+internal B32
+ce_u2w_enqueue_req(CE_Cache *cache, CE_Priority priority, U128 hash, String8 params, U64 deadline_us, U64 endt_us)
+{
+  B32 good = 0;
+  B32 stalled = 0;
+  U8 *ring_base = cache->u2w_ring_base[priority];
+  U64 *ring_write_pos = &cache->u2w_ring_write_pos[priority];
+  U64 *ring_read_pos = &cache->u2w_ring_read_pos[priority];
+  OS_MutexScope(cache->u2w_ring_mutex) for(;;)
+  {
+    U64 unconsumed_size = *ring_write_pos - *ring_read_pos;
+    U64 available_size = cache->u2w_ring_size - unconsumed_size;
+    if(available_size >= sizeof(hash)+sizeof(deadline_us)+sizeof(U64)+sizeof(params.size)+params.size+7)
+    {
+      good = 1;
+      U64 request_us = os_now_microseconds();
+      *ring_write_pos += ring_write_struct(ring_base, cache->u2w_ring_size, *ring_write_pos, &hash);
+      *ring_write_pos += ring_write_struct(ring_base, cache->u2w_ring_size, *ring_write_pos, &deadline_us);
+      *ring_write_pos += ring_write_struct(ring_base, cache->u2w_ring_size, *ring_write_pos, &request_us);
+      *ring_write_pos += ring_write_struct(ring_base, cache->u2w_ring_size, *ring_write_pos, &params.size);
+      *ring_write_pos += ring_write(ring_base, cache->u2w_ring_size, *ring_write_pos, params.str, params.size);
+      *ring_write_pos += 7;
+      *ring_write_pos -= *ring_write_pos%8;
+      break;
+    }
+    if(os_now_microseconds() >= endt_us)
+    {
+      break;
+    }
+    stalled = 1;
+    os_condition_variable_wait(cache->u2w_ring_cv, cache->u2w_ring_mutex, endt_us);
+  }
+  if(good)
+  {
+    os_condition_variable_broadcast(cache->u2w_ring_cv);
+    ins_atomic_u64_inc_eval(&cache->stats.request_count);
+  }
+  if(stalled)
+  {
+    ins_atomic_u64_inc_eval(&cache->stats.request_stall_count);
+  }
+  return good;
+}
+
+internal void
+ce_u2w_dequeue_req(Arena *arena, CE_Cache *cache, U128 *hash_out, String8 *params_out, U64 *deadline_us_out, U64 *request_us_out)
+{
+  OS_MutexScope(cache->u2w_ring_mutex) for(;;)
+  {
+    //- rjf: take from the most urgent non-empty ring
+    B32 got_req = 0;
+    for(U64 priority = 0; priority < CE_Priority_COUNT; priority += 1)
+    {
+      U8 *ring_base = cache->u2w_ring_base[priority];
+      U64 *ring_read_pos = &cache->u2w_ring_read_pos[priority];
+      U64 unconsumed_size = cache->u2w_ring_write_pos[priority] - *ring_read_pos;
+      if(unconsumed_size >= sizeof(*hash_out)+sizeof(*deadline_us_out)+sizeof(*request_us_out)+sizeof(params_out->size))
+      {
+        *ring_read_pos += ring_read_struct(ring_base, cache->u2w_ring_size, *ring_read_pos, hash_out);
+        *ring_read_pos += ring_read_struct(ring_base, cache->u2w_ring_size, *ring_read_pos, deadline_us_out);
+        *ring_read_pos += ring_read_struct(ring_base, cache->u2w_ring_size, *ring_read_pos, request_us_out);
+        *ring_read_pos += ring_read_struct(ring_base, cache->u2w_ring_size, *ring_read_pos, &params_out->size);
+        params_out->str = push_array_no_zero(arena, U8, params_out->size);
+        *ring_read_pos += ring_read(ring_base, cache->u2w_ring_size, *ring_read_pos, params_out->str, params_out->size);
+        *ring_read_pos += 7;
+        *ring_read_pos -= *ring_read_pos%8;
+        got_req = 1;
+        break;
+      }
+    }
+    if(got_req)
+    {
+      break;
+    }
+    os_condition_variable_wait(cache->u2w_ring_cv, cache->u2w_ring_mutex, max_U64);
+  }
+  os_condition_variable_broadcast(cache->u2w_ring_cv);
+}
+
+internal void
+ce_task_publish_val(CE_Task *task, void *val)
+{
+  CE_Cache *cache = task->cache;
+  CE_Node *node = task->node;
+  U64 slot_idx = task->hash.u64[1]%cache->slots_count;
+  U64 stripe_idx = slot_idx%cache->stripes_count;
+  CE_Stripe *stripe = &cache->stripes[stripe_idx];
+  OS_MutexScopeW(stripe->rw_mutex)
+  {
+    if(node->load_count != 0)
+    {
+      ce_cache_retire_val(cache, node->val);
+    }
+    MemoryCopy(node->val, val, cache->val_size);
+    ins_atomic_u64_inc_eval(&node->load_count);
+  }
+  task->publish_count += 1;
+}
+
+internal void
+ce_worker_thread__entry_point(void *p)
+{
+  CE_Cache *cache = (CE_Cache *)p;
+  ThreadNameF("[%S] worker thread", cache->name);
+  for(;;)
+  {
+    Temp scratch = scratch_begin(0, 0);
+
+    //- rjf: get next request
+    U128 hash = {0};
+    String8 params = {0};
+    U64 deadline_us = 0;
+    U64 request_us = 0;
+    ce_u2w_dequeue_req(scratch.arena, cache, &hash, &params, &deadline_us, &request_us);
+    U64 change_gen = cache->change_gen ? cache->change_gen() : 0;
+
+    //- rjf: unpack hash
+    U64 slot_idx = hash.u64[1]%cache->slots_count;
+    U64 stripe_idx = slot_idx%cache->stripes_count;
+    CE_Slot *slot = &cache->slots[slot_idx];
+    CE_Stripe *stripe = &cache->stripes[stripe_idx];
+
+    //- rjf: take task. a working node is never evicted, so it may be referred
+    // to directly until the task is committed. a node may be queued more than
+    // once (e.g. at several priorities) - only the first dequeue takes it.
+    CE_Node *node = 0;
+    OS_MutexScopeR(stripe->rw_mutex)
+    {
+      for(CE_Node *n = slot->first; n != 0; n = n->next)
+      {
+        if(u128_match(n->hash, hash) && str8_match(n->params, params, 0))
+        {
+          if(!ins_atomic_u32_eval_cond_assign(&n->is_working, 1, 0))
+          {
+            if(ins_atomic_u32_eval_cond_assign(&n->is_requested, 0, 1))
+            {
+              node = n;
+            }
+            else
+            {
+              ins_atomic_u32_eval_assign(&n->is_working, 0);
+            }
+          }
+          break;
+        }
+      }
+    }
+
+    //- rjf: compute value
+    void *val = 0;
+    CE_Task task = {0};
+    U64 queue_us = 0;
+    U64 compute_us = 0;
+    if(node != 0)
+    {
+      val = push_array(scratch.arena, U8, cache->val_size);
+      task.cache          = cache;
+      task.hash           = hash;
+      task.params         = params;
+      task.change_gen     = change_gen;
+      task.progress_done  = &node->progress_done;
+      task.progress_total = &node->progress_total;
+      task.node           = node;
+      U64 start_us = os_now_microseconds();
+      queue_us = start_us - Min(start_us, request_us);
+      cache->compute(&task, val);
+      compute_us = os_now_microseconds() - start_us;
+    }
+
+    //- rjf: commit value. a value being replaced - a previous one, or one
+    // published by this task - may still be in use by open scopes, so it is
+    // retired rather than released.
+    B32 is_recompute = 0;
+    if(node != 0) OS_MutexScopeW(stripe->rw_mutex)
+    {
+      is_recompute = (node->load_count > task.publish_count);
+      if(node->load_count != 0)
+      {
+        ce_cache_retire_val(cache, node->val);
+      }
+      MemoryCopy(node->val, val, cache->val_size);
+      B32 was_dependent = (node->change_gen != 0);
+      node->change_gen = task.depends_on_change_gen ? change_gen : 0;
+      if(!was_dependent && node->change_gen != 0)
+      {
+        ins_atomic_u64_inc_eval(&cache->change_gen_dependent_count);
+        ce_evictor_wake_by(os_now_microseconds() + ce_shared->poll_interval_us);
+      }
+      else if(was_dependent && node->change_gen == 0)
+      {
+        ins_atomic_u64_dec_eval(&cache->change_gen_dependent_count);
+      }
+      if(!node->is_scheduled)
+      {
+        ce_cache_schedule_evict_check__stripe_w_guarded(cache, node, os_now_microseconds() + ce_shared->evict_threshold_us);
+      }
+      ins_atomic_u32_eval_assign(&node->is_retrying, 0);
+      ins_atomic_u64_inc_eval(&node->load_count);
+      ins_atomic_u32_eval_assign(&node->is_working, 0);
+    }
+
+    //- rjf: bump stats
+    if(node != 0)
+    {
+      ins_atomic_u64_inc_eval(&cache->stats.compute_count);
+      ins_atomic_u64_add_eval(&cache->stats.compute_us_total, compute_us);
+      metric_histogram_record(cache->queue_us_histogram, queue_us);
+      metric_histogram_record(cache->compute_us_histogram, compute_us);
+      for(U64 prev_max = ins_atomic_u64_eval(&cache->stats.compute_us_max); prev_max < compute_us;)
+      {
+        U64 actual_prev_max = ins_atomic_u64_eval_cond_assign(&cache->stats.compute_us_max, compute_us, prev_max);
+        if(actual_prev_max == prev_max)
+        {
+          break;
+        }
+        prev_max = actual_prev_max;
+      }
+      if(is_recompute)
+      {
+        ins_atomic_u64_inc_eval(&cache->stats.recompute_count);
+      }
+      if(deadline_us != 0 && os_now_microseconds() > deadline_us)
+      {
+        ins_atomic_u64_inc_eval(&cache->stats.deadline_miss_count);
+      }
+    }
+
+    scratch_end(scratch);
+  }
+}
+
+////////////////////////////////
+//~ rjf: Evictor/Detector Thread
+
+internal void
+ce_evictor_wake_by(U64 time_us)
+{
+  B32 wake = 0;
+  OS_MutexScope(ce_shared->evictor_mutex)
+  {
+    if(time_us < ce_shared->evictor_wake_us)
+    {
+      ce_shared->evictor_wake_us = time_us;
+      wake = 1;
+    }
+  }
+  if(wake)
+  {
+    os_condition_variable_broadcast(ce_shared->evictor_cv);
+  }
+}
+
+internal void
+ce_cache_schedule_evict_check__stripe_w_guarded(CE_Cache *cache, CE_Node *node, U64 due_us)
+{
+  // NOTE(rjf): due times are rounded up to the poll interval, so that checks
+  // for nodes loaded around the same time are batched into one wakeup
+  U64 granularity_us = Max(ce_shared->poll_interval_us, 1);
+  due_us = ((due_us + granularity_us - 1)/granularity_us)*granularity_us;
+  node->is_scheduled = 1;
+  CE_EvictCheck check = {due_us, node, node->alloc_gen};
+  OS_MutexScope(cache->evict_heap_mutex)
+  {
+    //- rjf: grow. old heaps are left in the arena - at most as large as the
+    // final heap, in total.
+    if(cache->evict_heap_count == cache->evict_heap_cap)
+    {
+      U64 new_cap = Max(256, cache->evict_heap_cap*2);
+      CE_EvictCheck *new_heap = push_array_no_zero(cache->evict_heap_arena, CE_EvictCheck, new_cap);
+      MemoryCopy(new_heap, cache->evict_heap, sizeof(CE_EvictCheck)*cache->evict_heap_count);
+      cache->evict_heap = new_heap;
+      cache->evict_heap_cap = new_cap;
+    }
+
+    //- rjf: sift up
+    U64 idx = cache->evict_heap_count;
+    cache->evict_heap_count += 1;
+    for(;idx > 0;)
+    {
+      U64 parent_idx = (idx-1)/2;
+      if(cache->evict_heap[parent_idx].due_us <= due_us)
+      {
+        break;
+      }
+      cache->evict_heap[idx] = cache->evict_heap[parent_idx];
+      idx = parent_idx;
+    }
+    cache->evict_heap[idx] = check;
+  }
+  ce_evictor_wake_by(due_us);
+}
+
+internal U64
+ce_cache_pop_due_evict_checks(Arena *arena, CE_Cache *cache, U64 now_us, CE_EvictCheck **checks_out)
+{
+  U64 count = 0;
+  OS_MutexScope(cache->evict_heap_mutex)
+  {
+    CE_EvictCheck *checks = push_array_no_zero(arena, CE_EvictCheck, cache->evict_heap_count);
+    for(;cache->evict_heap_count != 0 && cache->evict_heap[0].due_us <= now_us;)
+    {
+      //- rjf: take root
+      checks[count] = cache->evict_heap[0];
+      count += 1;
+
+      //- rjf: move last to root, sift down
+      cache->evict_heap_count -= 1;
+      U64 heap_count = cache->evict_heap_count;
+      if(heap_count != 0)
+      {
+        CE_EvictCheck last = cache->evict_heap[heap_count];
+        U64 idx = 0;
+        for(;;)
+        {
+          U64 child_idx = idx*2 + 1;
+          if(child_idx >= heap_count)
+          {
+            break;
+          }
+          if(child_idx+1 < heap_count && cache->evict_heap[child_idx+1].due_us < cache->evict_heap[child_idx].due_us)
+          {
+            child_idx += 1;
+          }
+          if(last.due_us <= cache->evict_heap[child_idx].due_us)
+          {
+            break;
+          }
+          cache->evict_heap[idx] = cache->evict_heap[child_idx];
+          idx = child_idx;
+        }
+        cache->evict_heap[idx] = last;
+      }
+    }
+    *checks_out = checks;
+  }
+  return count;
+}
+
+internal U64
+ce_cache_next_evictor_time_us(CE_Cache *cache, U64 now_us)
+{
+  U64 result = max_U64;
+  OS_MutexScope(cache->evict_heap_mutex)
+  {
+    if(cache->evict_heap_count != 0)
+    {
+      result = cache->evict_heap[0].due_us;
+    }
+  }
+  if(cache->change_gen != 0 && ins_atomic_u64_eval(&cache->change_gen_dependent_count) != 0)
+  {
+    result = Min(result, cache->last_change_gen_poll_us + ce_shared->poll_interval_us);
+  }
+  if(cache->stale_rescan_us != 0)
+  {
+    result = Min(result, cache->stale_rescan_us);
+  }
+  OS_MutexScope(cache->retired_mutex)
+  {
+    if(cache->first_retired != 0)
+    {
+      result = Min(result, now_us + ce_shared->poll_interval_us);
+    }
+  }
+  return result;
+}
+
+internal B32
+ce_node_is_evictable(CE_Node *node, U64 check_time_us, U64 check_time_user_clocks)
+{
+  B32 result = (node->last_time_touched_us+ce_shared->evict_threshold_us <= check_time_us &&
+                node->last_user_clock_idx_touched+ce_shared->evict_threshold_user_clocks <= check_time_user_clocks &&
+                (node->load_count != 0 || node->is_requested == 0) &&
+                node->is_working == 0);
+  return result;
+}
+
+internal B32
+ce_node_is_stale(CE_Node *node, U64 change_gen, U64 check_time_us, U64 check_time_user_clocks)
+{
+  // NOTE(rjf): only one recompute may be in flight per node.
+  B32 result = (node->change_gen != 0 && node->change_gen != change_gen &&
+                node->is_working == 0 &&
+                node->is_retrying == 0 &&
+                node->last_time_requested_us+ce_shared->retry_threshold_us <= check_time_us &&
+                node->last_user_clock_idx_requested+ce_shared->retry_threshold_user_clocks <= check_time_user_clocks);
+  return result;
+}
+
+internal void
+ce_evictor_thread__entry_point(void *p)
+{
+  ThreadNameF("[ce] evictor/detector thread");
+  for(;;)
+  {
+    //- rjf: from here on, newly scheduled work lowers the wake time, so that
+    // none is missed while this pass runs
+    OS_MutexScope(ce_shared->evictor_mutex)
+    {
+      ce_shared->evictor_wake_us = max_U64;
+    }
+    Temp scratch = scratch_begin(0, 0);
+    U64 pass_start_us = os_now_microseconds();
+
+    //- rjf: gather caches
+    U64 caches_count = 0;
+    CE_Cache **caches = 0;
+    OS_MutexScope(ce_shared->caches_mutex)
+    {
+      caches = push_array(scratch.arena, CE_Cache *, ce_shared->cache_count);
+      for(CE_Cache *c = ce_shared->first_cache; c != 0; c = c->next)
+      {
+        caches[caches_count] = c;
+        caches_count += 1;
+      }
+    }
+
+    //- rjf: do all due work in each cache
+    U64 wake_us = max_U64;
+    for(U64 cache_idx = 0; cache_idx < caches_count; cache_idx += 1)
+    {
+      CE_Cache *cache = caches[cache_idx];
+      U64 check_time_us = os_now_microseconds();
+      U64 check_time_user_clocks = ce_cache_user_clock_idx(cache);
+
+      //- rjf: due eviction checks -> evict, or re-schedule for when the node's
+      // latest touch expires. only this thread evicts nodes, so a checked node
+      // cannot be freed from under us before its stripe is locked.
+      CE_EvictCheck *checks = 0;
+      U64 checks_count = ce_cache_pop_due_evict_checks(scratch.arena, cache, check_time_us, &checks);
+      for(U64 check_idx = 0; check_idx < checks_count; check_idx += 1)
+      {
+        CE_Node *node = checks[check_idx].node;
+        U64 slot_idx = node->hash.u64[1]%cache->slots_count;
+        U64 stripe_idx = slot_idx%cache->stripes_count;
+        CE_Slot *slot = &cache->slots[slot_idx];
+        CE_Stripe *stripe = &cache->stripes[stripe_idx];
+        OS_MutexScopeW(stripe->rw_mutex)
+        {
+          if(node->alloc_gen != checks[check_idx].node_alloc_gen || !node->is_scheduled)
+          {
+            // rjf: node was reused; check is obsolete
+          }
+          else if(ce_node_is_evictable(node, check_time_us, check_time_user_clocks))
+          {
+            node->is_scheduled = 0;
+            if(node->change_gen != 0)
+            {
+              ins_atomic_u64_dec_eval(&cache->change_gen_dependent_count);
+            }
+            DLLRemove(slot->first, slot->last, node);
+            if(node->load_count != 0)
+            {
+              ce_cache_retire_val(cache, node->val);
+            }
+            SLLStackPush(stripe->free_node, node);
+            ins_atomic_u64_dec_eval(&cache->stats.node_count);
+            ins_atomic_u64_inc_eval(&cache->stats.evict_count);
+          }
+          else
+          {
+            // NOTE(rjf): if the time threshold has passed, the node is held
+            // by its user clock, or by a running task - check again a full
+            // threshold later.
+            U64 due_us = ins_atomic_u64_eval(&node->last_time_touched_us) + ce_shared->evict_threshold_us;
+            if(due_us <= check_time_us)
+            {
+              due_us = check_time_us + ce_shared->evict_threshold_us;
+            }
+            ce_cache_schedule_evict_check__stripe_w_guarded(cache, node, due_us);
+          }
+        }
+      }
+
+      //- rjf: poll change generation, while any value depends on it; on
+      // change, re-request stale values. stripes are scanned under a read
+      // lock, & only taken for writing if they have work. stale values which
+      // can't be re-requested yet are picked up by a later re-scan.
+      if(cache->change_gen != 0 && ins_atomic_u64_eval(&cache->change_gen_dependent_count) != 0 &&
+         (cache->last_change_gen_poll_us + ce_shared->poll_interval_us <= check_time_us ||
+          (cache->stale_rescan_us != 0 && cache->stale_rescan_us <= check_time_us)))
+      {
+        U64 change_gen = cache->change_gen();
+        B32 is_rescan = (cache->stale_rescan_us != 0 && cache->stale_rescan_us <= check_time_us);
+        cache->last_change_gen_poll_us = check_time_us;
+        if(change_gen != cache->last_seen_change_gen || is_rescan)
+        {
+          B32 any_deferred = 0;
+          cache->last_seen_change_gen = change_gen;
+          cache->stale_rescan_us = 0;
+          for(U64 stripe_idx = 0; stripe_idx < cache->stripes_count; stripe_idx += 1)
+          {
+            CE_Stripe *stripe = &cache->stripes[stripe_idx];
+            B32 stripe_has_work = 0;
+            OS_MutexScopeR(stripe->rw_mutex)
+            {
+              for(U64 slot_idx = stripe_idx; slot_idx < cache->slots_count && !stripe_has_work; slot_idx += cache->stripes_count)
+              {
+                for(CE_Node *n = cache->slots[slot_idx].first; n != 0; n = n->next)
+                {
+                  if(n->change_gen != 0 && n->change_gen != change_gen && !n->is_retrying)
+                  {
+                    stripe_has_work = 1;
+                    break;
+                  }
+                }
+              }
+            }
+            if(stripe_has_work) OS_MutexScopeW(stripe->rw_mutex)
+            {
+              for(U64 slot_idx = stripe_idx; slot_idx < cache->slots_count; slot_idx += cache->stripes_count)
+              {
+                for(CE_Node *n = cache->slots[slot_idx].first; n != 0; n = n->next)
+                {
+                  if(ce_node_is_stale(n, change_gen, check_time_us, check_time_user_clocks))
+                  {
+                    // NOTE(rjf): never wait on the ring here - workers need
+                    // this stripe's lock to commit, & so to make room in the
+                    // ring. stale values are still usable, so refreshing them
+                    // is background work.
+                    n->is_requested = 1;
+                    n->request_priority = CE_Priority_Prefetch;
+                    if(ce_u2w_enqueue_req(cache, CE_Priority_Prefetch, n->hash, n->params, 0, 0))
+                    {
+                      n->is_retrying = 1;
+                      n->last_time_requested_us = os_now_microseconds();
+                      n->last_user_clock_idx_requested = check_time_user_clocks;
+                    }
+                    else
+                    {
+                      n->is_requested = 0;
+                      any_deferred = 1;
+                    }
+                  }
+                  else if(n->change_gen != 0 && n->change_gen != change_gen && !n->is_retrying)
+                  {
+                    any_deferred = 1;
+                  }
+                }
+              }
+            }
+          }
+          if(any_deferred)
+          {
+            cache->stale_rescan_us = check_time_us + Max(ce_shared->retry_threshold_us, ce_shared->poll_interval_us);
+          }
+        }
+      }
+
+      //- rjf: release retired values which no open scope can still see
+      ce_cache_reclaim_retired_vals(cache, epoch_reclaim_watermark());
+
+      //- rjf: fold in this cache's next due work
+      wake_us = Min(wake_us, ce_cache_next_evictor_time_us(cache, os_now_microseconds()));
+    }
+
+    //- rjf: bump stats
+    ins_atomic_u64_inc_eval(&ce_shared->evict_pass_count);
+    ins_atomic_u64_add_eval(&ce_shared->evict_pass_us_total, os_now_microseconds()-pass_start_us);
+    scratch_end(scratch);
+
+    //- rjf: sleep until the earliest due work, or until woken by new work
+    OS_MutexScope(ce_shared->evictor_mutex) for(;;)
+    {
+      wake_us = Min(wake_us, ce_shared->evictor_wake_us);
+      ce_shared->evictor_wake_us = wake_us;
+      if(os_now_microseconds() >= wake_us)
+      {
+        break;
+      }
+      os_condition_variable_wait(ce_shared->evictor_cv, ce_shared->evictor_mutex, wake_us);
+    }
+  }
+}
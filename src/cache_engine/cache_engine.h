@@ -0,0 +1,420 @@
+// Copyright (c) 2024 Epic Games Tools
+// Licensed under the MIT license (https://opensource.org/license/mit/)
+
+#ifndef CACHE_ENGINE_H
+#define CACHE_ENGINE_H
+
+////////////////////////////////
+//~ rjf: Cache Engine Overview
+//
+// A generic cache of values which are computed asynchronously from a hash
+// store content hash plus a parameter blob. This is the machinery shared by
+// the text, disassembly, geometry, and texture caches - each is described by
+// a fixed value size, and by callbacks which compute a value (on the cache's
+// own worker threads), and release one.
+//
+// Lookups never block. A miss creates a node and sends a request to the
+// cache's workers; until the computed value is committed, lookups produce a
+// zeroed value. Any value obtained within a scope stays valid until that
+// scope is closed - scopes are epochs (see base_epoch.h), so opening one
+// costs a store to a thread-local slot, rather than atomics on shared nodes.
+//
+// All caches share one evictor thread & one policy: a node is evicted once
+// it has gone untouched for both a time threshold and a number of ticks of
+// its cache's user clock. Caches whose values depend on state outside of
+// their key may also provide a change generation - values computed against a
+// stale generation are recomputed. Evicted or replaced values are retired,
+// & released once no scope which might have seen them remains open.
+//
+// The evictor does not scan on a timer. Each cache keeps a min-heap of
+// eviction checks, ordered by due time; a node is checked once its eviction
+// threshold could first have passed, & is re-scheduled if it was touched
+// meanwhile. Nodes are scheduled when created, so a node whose request was
+// dropped, & which is never looked up again, is evicted without a value.
+// Change generations are only polled while some value depends on one, &
+// retired values only while some are queued - otherwise, the evictor sleeps
+// until woken by new work.
+//
+// Requests carry a priority & a deadline, both taken from the requesting
+// thread. The UI sets the deadline to the end of the frame being built, &
+// raises the priority of what is on screen over hovered & prefetched content
+// (e.g. the disassembly of regions next to the one in view); workers always
+// take the most urgent request first. A lookup for a value which is still
+// queued at a lower priority re-sends its request at the higher one.
+//
+// A compute callback which can produce a useful partial value well before it
+// finishes (e.g. line ranges before tokens) may publish it early, with
+// `ce_task_publish_val`. Lookups see a published value as loaded; it is
+// replaced, & retired, by the next one published or by the final value.
+
+////////////////////////////////
+//~ rjf: Request Priorities
+
+typedef enum CE_Priority
+{
+  CE_Priority_Visible,
+  CE_Priority_Hover,
+  CE_Priority_Prefetch,
+  CE_Priority_COUNT
+}
+CE_Priority;
+
+////////////////////////////////
+//~ rjf: Callback Types
+
+typedef struct CE_Cache CE_Cache;
+typedef struct CE_Node CE_Node;
+
+typedef struct CE_Task CE_Task;
+struct CE_Task
+{
+  CE_Cache *cache;
+  U128 hash;
+  String8 params;
+  U64 change_gen;
+
+  // rjf: progress counters, readable by lookups while the task is running
+  U64 *progress_done;
+  U64 *progress_total;
+
+  // rjf: set by `compute` if the value must be recomputed when the cache's
+  // change generation moves past `change_gen`
+  B32 depends_on_change_gen;
+
+  // rjf: node being computed, & # of values published to it so far
+  CE_Node *node;
+  U64 publish_count;
+};
+
+#define CE_COMPUTE_FUNCTION_DEF(name) void name(CE_Task *task, void *val_out)
+typedef CE_COMPUTE_FUNCTION_DEF(CE_ComputeFunctionType);
+
+#define CE_RELEASE_FUNCTION_DEF(name) void name(void *val)
+typedef CE_RELEASE_FUNCTION_DEF(CE_ReleaseFunctionType);
+
+typedef U64 CE_ChangeGenFunctionType(void);
+
+////////////////////////////////
+//~ rjf: Cache Description
+
+typedef struct CE_CacheParams CE_CacheParams;
+struct CE_CacheParams
+{
+  String8 name;
+  U64 val_size;
+  U64 slots_count;
+  U64 worker_thread_count;
+  CE_ComputeFunctionType *compute;
+  CE_ReleaseFunctionType *release;
+  CE_ChangeGenFunctionType *change_gen;
+};
+
+////////////////////////////////
+//~ rjf: Cache Types
+
+struct CE_Node
+{
+  // rjf: links
+  CE_Node *next;
+  CE_Node *prev;
+
+  // rjf: key
+  U128 hash;
+  String8 params;
+  U64 params_cap;
+
+  // rjf: value
+  void *val;
+
+  // rjf: generations
+  U64 change_gen;
+
+  // rjf: eviction scheduling
+  U64 alloc_gen;
+  B32 is_scheduled;
+
+  // rjf: metadata
+  B32 is_requested;
+  B32 is_working;
+  B32 is_retrying;
+  U64 request_priority;
+  U64 last_time_touched_us;
+  U64 last_user_clock_idx_touched;
+  U64 load_count;
+  U64 last_time_requested_us;
+  U64 last_user_clock_idx_requested;
+  U64 progress_done;
+  U64 progress_total;
+};
+
+typedef struct CE_Slot CE_Slot;
+struct CE_Slot
+{
+  CE_Node *first;
+  CE_Node *last;
+};
+
+typedef struct CE_Stripe CE_Stripe;
+struct CE_Stripe
+{
+  Arena *arena;
+  OS_Handle rw_mutex;
+  OS_Handle cv;
+  CE_Node *free_node;
+};
+
+typedef struct CE_EvictCheck CE_EvictCheck;
+struct CE_EvictCheck
+{
+  U64 due_us;
+  CE_Node *node;
+  U64 node_alloc_gen;
+};
+
+typedef struct CE_Retired CE_Retired;
+struct CE_Retired
+{
+  CE_Retired *next;
+  U64 retire_epoch;
+  void *val;
+};
+
+////////////////////////////////
+//~ rjf: Metrics
+
+typedef struct CE_Stats CE_Stats;
+struct CE_Stats
+{
+  U64 node_count;
+  U64 lookup_count;
+  U64 hit_count;
+  U64 miss_count;
+  U64 request_count;
+  U64 request_stall_count;
+  U64 request_upgrade_count;
+  U64 deadline_miss_count;
+  U64 compute_count;
+  U64 compute_us_total;
+  U64 compute_us_max;
+  U64 recompute_count;
+  U64 retire_count;
+  U64 reclaim_count;
+  U64 evict_count;
+};
+
+////////////////////////////////
+//~ rjf: Cache
+
+struct CE_Cache
+{
+  CE_Cache *next;
+  Arena *arena;
+
+  // rjf: description
+  String8 name;
+  U64 val_size;
+  CE_ComputeFunctionType *compute;
+  CE_ReleaseFunctionType *release;
+  CE_ChangeGenFunctionType *change_gen;
+
+  // rjf: user clock
+  U64 user_clock_idx;
+
+  // rjf: table
+  U64 slots_count;
+  U64 stripes_count;
+  CE_Slot *slots;
+  CE_Stripe *stripes;
+
+  // rjf: user -> worker thread (one ring per priority)
+  U64 u2w_ring_size;
+  U8 *u2w_ring_base[CE_Priority_COUNT];
+  U64 u2w_ring_write_pos[CE_Priority_COUNT];
+  U64 u2w_ring_read_pos[CE_Priority_COUNT];
+  OS_Handle u2w_ring_cv;
+  OS_Handle u2w_ring_mutex;
+
+  // rjf: worker threads
+  U64 worker_thread_count;
+  OS_Handle *worker_threads;
+
+  // rjf: retired values
+  OS_Handle retired_mutex;
+  CE_Retired *first_retired;
+  CE_Retired *last_retired;
+  CE_Retired *free_retired;
+
+  // rjf: eviction check schedule (min-heap on due time)
+  OS_Handle evict_heap_mutex;
+  Arena *evict_heap_arena;
+  CE_EvictCheck *evict_heap;
+  U64 evict_heap_count;
+  U64 evict_heap_cap;
+
+  // rjf: change generation detection
+  U64 change_gen_dependent_count;
+  U64 last_seen_change_gen;
+  U64 last_change_gen_poll_us;
+  U64 stale_rescan_us;
+
+  // rjf: metrics
+  CE_Stats stats;
+  MetricHistogram *queue_us_histogram;
+  MetricHistogram *compute_us_histogram;
+};
+
+////////////////////////////////
+//~ rjf: Lookup Results
+
+typedef struct CE_Lookup CE_Lookup;
+struct CE_Lookup
+{
+  B32 is_new;
+  B32 is_loaded;
+  U64 progress_done;
+  U64 progress_total;
+};
+
+////////////////////////////////
+//~ rjf: Scoped Access
+
+typedef struct CE_Scope CE_Scope;
+struct CE_Scope
+{
+  CE_Scope *next;
+};
+
+////////////////////////////////
+//~ rjf: Thread Context
+
+#define CE_PRIORITY_STACK_CAP 16
+
+typedef struct CE_TCTX CE_TCTX;
+struct CE_TCTX
+{
+  Arena *arena;
+  CE_Scope *free_scope;
+  CE_Priority priority_stack[CE_PRIORITY_STACK_CAP];
+  U64 priority_stack_count;
+  U64 request_deadline_us;
+};
+
+////////////////////////////////
+//~ rjf: Shared State
+
+typedef struct CE_Shared CE_Shared;
+struct CE_Shared
+{
+  Arena *arena;
+
+  // rjf: eviction policy
+  U64 evict_threshold_us;
+  U64 evict_threshold_user_clocks;
+  U64 retry_threshold_us;
+  U64 retry_threshold_user_clocks;
+  U64 poll_interval_us;
+
+  // rjf: registered caches
+  OS_Handle caches_mutex;
+  CE_Cache *first_cache;
+  CE_Cache *last_cache;
+  U64 cache_count;
+
+  // rjf: evictor/detector thread
+  OS_Handle evictor_mutex;
+  OS_Handle evictor_cv;
+  U64 evictor_wake_us;
+  OS_Handle evictor_thread;
+  U64 evict_pass_count;
+  U64 evict_pass_us_total;
+};
+
+////////////////////////////////
+//~ rjf: Globals
+
+thread_static CE_TCTX *ce_tctx = 0;
+global CE_Shared *ce_shared = 0;
+
+////////////////////////////////
+//~ rjf: Main Layer Initialization
+
+internal void ce_init(void);
+
+////////////////////////////////
+//~ rjf: Thread Context Initialization
+
+internal void ce_tctx_ensure_inited(void);
+
+////////////////////////////////
+//~ rjf: Request Priorities & Deadlines
+
+internal void ce_push_priority(CE_Priority priority);
+internal void ce_pop_priority(void);
+internal CE_Priority ce_top_priority(void);
+#define CE_PriorityScope(priority) DeferLoop(ce_push_priority(priority), ce_pop_priority())
+
+// NOTE(rjf): 0 -> no deadline; requests may wait indefinitely for room
+internal void ce_set_request_deadline(U64 deadline_us);
+internal U64 ce_request_deadline(void);
+
+////////////////////////////////
+//~ rjf: Cache Allocation
+
+internal CE_Cache *ce_cache_alloc(CE_CacheParams *params);
+
+////////////////////////////////
+//~ rjf: User Clock
+
+internal void ce_cache_user_clock_tick(CE_Cache *cache);
+internal U64 ce_cache_user_clock_idx(CE_Cache *cache);
+
+////////////////////////////////
+//~ rjf: Metrics
+
+internal CE_Stats ce_stats_from_cache(CE_Cache *cache);
+
+////////////////////////////////
+//~ rjf: Scoped Access
+
+internal CE_Scope *ce_scope_open(void);
+internal void ce_scope_close(CE_Scope *scope);
+internal void ce_node_touch__stripe_r_guarded(CE_Cache *cache, CE_Node *node);
+
+////////////////////////////////
+//~ rjf: Retirement
+
+internal void ce_cache_retire_val(CE_Cache *cache, void *val);
+internal void ce_cache_reclaim_retired_vals(CE_Cache *cache, U64 watermark);
+
+////////////////////////////////
+//~ rjf: Cache Lookups
+
+// NOTE(rjf): copies the node's value into `val_out` (zeroed if not yet
+// computed), and requests it be computed - at the calling thread's priority -
+// if the node is new, or is still waiting on a less urgent request
+internal CE_Lookup ce_val_from_hash_params(CE_Scope *scope, CE_Cache *cache, U128 hash, String8 params, void *val_out);
+
+// NOTE(rjf): copies the node's value into `val_out` only if it has already
+// been computed - never creates nodes, nor sends requests
+internal B32 ce_peek_val_from_hash_params(CE_Scope *scope, CE_Cache *cache, U128 hash, String8 params, void *val_out);
+
+////////////////////////////////
+//~ rjf: Worker Threads
+
+internal B32 ce_u2w_enqueue_req(CE_Cache *cache, CE_Priority priority, U128 hash, String8 params, U64 deadline_us, U64 endt_us);
+internal void ce_u2w_dequeue_req(Arena *arena, CE_Cache *cache, U128 *hash_out, String8 *params_out, U64 *deadline_us_out, U64 *request_us_out);
+internal void ce_task_publish_val(CE_Task *task, void *val);
+internal void ce_worker_thread__entry_point(void *p);
+
+////////////////////////////////
+//~ rjf: Evictor/Detector Thread
+
+internal void ce_evictor_wake_by(U64 time_us);
+internal void ce_cache_schedule_evict_check__stripe_w_guarded(CE_Cache *cache, CE_Node *node, U64 due_us);
+internal U64 ce_cache_pop_due_evict_checks(Arena *arena, CE_Cache *cache, U64 now_us, CE_EvictCheck **checks_out);
+internal U64 ce_cache_next_evictor_time_us(CE_Cache *cache, U64 now_us);
+internal B32 ce_node_is_evictable(CE_Node *node, U64 check_time_us, U64 check_time_user_clocks);
+internal B32 ce_node_is_stale(CE_Node *node, U64 change_gen, U64 check_time_us, U64 check_time_user_clocks);
+internal void ce_evictor_thread__entry_point(void *p);
+
+#endif // CACHE_ENGINE_H
@@ -41,6 +41,12 @@ struct DASM_Params
 
 ////////////////////////////////
 //~ rjf: Instruction Types
+//
+// Instructions are stored in code order, so `code_off`s never decrease.
+// Annotation lines (source file names & source lines) are stored as
+// instructions with no address, sharing the `code_off` of the instruction
+// which they precede - so an instruction is always the last entry with its
+// `code_off`, & can be found by binary search.
 
 typedef struct DASM_Inst DASM_Inst;
 struct DASM_Inst
@@ -86,79 +92,37 @@ struct DASM_Info
 };
 
 ////////////////////////////////
-//~ rjf: Cache Types
+//~ rjf: Artifact Cache Types
+//
+// Disassembly is persisted in the artifact cache as this header, followed by
+// the instructions, followed by the text. Disassembly which includes source
+// lines depends on source files, rather than just hash store data & debug
+// info, so it is never persisted. Bump the version whenever decoding,
+// stringization, or any of these layouts change.
 
-typedef struct DASM_Node DASM_Node;
-struct DASM_Node
-{
-  // rjf: links
-  DASM_Node *next;
-  DASM_Node *prev;
-  
-  // rjf: key
-  U128 hash;
-  DASM_Params params;
-  
-  // rjf: generations
-  U64 change_gen;
-  
-  // rjf: value
-  Arena *info_arena;
-  DASM_Info info;
-  
-  // rjf: metadata
-  B32 is_working;
-  U64 scope_ref_count;
-  U64 last_time_touched_us;
-  U64 last_user_clock_idx_touched;
-  U64 load_count;
-  U64 last_time_requested_us;
-  U64 last_user_clock_idx_requested;
-};
+#define DASM_ARTIFACT_VERSION 2
 
-typedef struct DASM_Slot DASM_Slot;
-struct DASM_Slot
+typedef struct DASM_InfoArtifactHeader DASM_InfoArtifactHeader;
+struct DASM_InfoArtifactHeader
 {
-  DASM_Node *first;
-  DASM_Node *last;
-};
-
-typedef struct DASM_Stripe DASM_Stripe;
-struct DASM_Stripe
-{
-  Arena *arena;
-  OS_Handle rw_mutex;
-  OS_Handle cv;
-  DASM_Node *free_node;
+  U64 insts_count;
+  U64 text_size;
 };
 
 ////////////////////////////////
-//~ rjf: Scoped Access Types
+//~ rjf: Cache Value Type
 
-typedef struct DASM_Touch DASM_Touch;
-struct DASM_Touch
+typedef struct DASM_Value DASM_Value;
+struct DASM_Value
 {
-  DASM_Touch *next;
-  U128 hash;
-  DASM_Params params;
-};
-
-typedef struct DASM_Scope DASM_Scope;
-struct DASM_Scope
-{
-  DASM_Scope *next;
-  DASM_Touch *top_touch;
-  U64 base_pos;
+  Arena *arena;
+  DASM_Info info;
 };
 
 ////////////////////////////////
-//~ rjf: Thread Context
+//~ rjf: Scoped Access
 
-typedef struct DASM_TCTX DASM_TCTX;
-struct DASM_TCTX
-{
-  Arena *arena;
-};
+typedef CE_Scope DASM_Scope;
 
 ////////////////////////////////
 //~ rjf: Shared State
@@ -168,50 +132,37 @@ struct DASM_Shared
 {
   Arena *arena;
   
-  // rjf: user clock
-  U64 user_clock_idx;
-  
-  // rjf: cache
-  U64 slots_count;
-  U64 stripes_count;
-  DASM_Slot *slots;
-  DASM_Stripe *stripes;
-  
-  // rjf: user -> parse thread
-  U64 u2p_ring_size;
-  U8 *u2p_ring_base;
-  U64 u2p_ring_write_pos;
-  U64 u2p_ring_read_pos;
-  OS_Handle u2p_ring_cv;
-  OS_Handle u2p_ring_mutex;
-  
-  // rjf: parse threads
-  U64 parse_thread_count;
-  OS_Handle *parse_threads;
-  
-  // rjf: evictor/detector thread
-  OS_Handle evictor_detector_thread;
+  // rjf: hash * params -> disassembly cache
+  CE_Cache *cache;
 };
 
 ////////////////////////////////
 //~ rjf: Globals
 
-thread_static DASM_TCTX *dasm_tctx = 0;
 global DASM_Shared *dasm_shared = 0;
 
 ////////////////////////////////
 //~ rjf: Parameter Type Functions
 
 internal B32 dasm_params_match(DASM_Params *a, DASM_Params *b);
+internal String8 dasm_blob_from_params(Arena *arena, DASM_Params *params);
+internal DASM_Params dasm_params_from_blob(String8 blob);
 
 ////////////////////////////////
 //~ rjf: Instruction Type Functions
 
 internal void dasm_inst_chunk_list_push(Arena *arena, DASM_InstChunkList *list, U64 cap, DASM_Inst *inst);
 internal DASM_InstArray dasm_inst_array_from_chunk_list(Arena *arena, DASM_InstChunkList *list);
-internal U64 dasm_inst_array_idx_from_code_off__linear_scan(DASM_InstArray *array, U64 off);
+internal U64 dasm_inst_array_idx_from_code_off(DASM_InstArray *array, U64 off);
 internal U64 dasm_inst_array_code_off_from_idx(DASM_InstArray *array, U64 idx);
 
+////////////////////////////////
+//~ rjf: Artifact Cache Helpers
+
+internal U128 dasm_artifact_key_from_hash_params_rdi(U128 hash, DASM_Params *params, RDI_Parsed *rdi);
+internal B32 dasm_insts_text_from_artifact(String8 artifact, DASM_InstArray *insts_out, String8 *text_out);
+internal void dasm_artifact_submit(U128 key, DASM_InstArray *insts, String8 text);
+
 ////////////////////////////////
 //~ rjf: Main Layer Initialization
 
@@ -228,7 +179,6 @@ internal U64 dasm_user_clock_idx(void);
 
 internal DASM_Scope *dasm_scope_open(void);
 internal void dasm_scope_close(DASM_Scope *scope);
-internal void dasm_scope_touch_node__stripe_r_guarded(DASM_Scope *scope, DASM_Node *node);
 
 ////////////////////////////////
 //~ rjf: Cache Lookups
@@ -237,15 +187,9 @@ internal DASM_Info dasm_info_from_hash_params(DASM_Scope *scope, U128 hash, DASM
 internal DASM_Info dasm_info_from_key_params(DASM_Scope *scope, U128 key, DASM_Params *params, U128 *hash_out);
 
 ////////////////////////////////
-//~ rjf: Parse Threads
-
-internal B32 dasm_u2p_enqueue_req(U128 hash, DASM_Params *params, U64 endt_us);
-internal void dasm_u2p_dequeue_req(Arena *arena, U128 *hash_out, DASM_Params *params_out);
-internal void dasm_parse_thread__entry_point(void *p);
-
-////////////////////////////////
-//~ rjf: Evictor/Detector Thread
+//~ rjf: Cache Callbacks
 
-internal void dasm_evictor_detector_thread__entry_point(void *p);
+internal CE_COMPUTE_FUNCTION_DEF(dasm_info_compute);
+internal CE_RELEASE_FUNCTION_DEF(dasm_info_release);
 
 #endif // DASM_CACHE_H
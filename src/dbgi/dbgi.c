@@ -94,6 +94,15 @@ di_init(void)
   di_shared->p2u_ring_cv = os_condition_variable_alloc();
   di_shared->p2u_ring_size = KB(64);
   di_shared->p2u_ring_base = push_array_no_zero(arena, U8, di_shared->p2u_ring_size);
+  metric_counter_register(str8_lit("di.lookups"), &di_shared->lookup_count);
+  metric_counter_register(str8_lit("di.hits"), &di_shared->hit_count);
+  metric_counter_register(str8_lit("di.misses"), &di_shared->miss_count);
+  metric_counter_register(str8_lit("di.requests"), &di_shared->request_count);
+  metric_counter_register(str8_lit("di.parses"), &di_shared->parse_count);
+  metric_counter_register(str8_lit("di.conversions"), &di_shared->conversion_count);
+  di_shared->lookup_wait_us_histogram = metric_histogram_alloc(str8_lit("di.lookup_wait_us"));
+  di_shared->parse_us_histogram       = metric_histogram_alloc(str8_lit("di.parse_us"));
+  di_shared->conversion_us_histogram  = metric_histogram_alloc(str8_lit("di.conversion_us"));
   di_shared->parse_thread_count = Max(2, os_logical_core_count()/2);
   di_shared->parse_threads = push_array(arena, OS_Handle, di_shared->parse_thread_count);
   for(U64 idx = 0; idx < di_shared->parse_thread_count; idx += 1)
@@ -411,6 +420,7 @@ di_rdi_from_key(DI_Scope *scope, DI_Key *key, U64 endt_us)
   if(key->path.size != 0)
   {
     Temp scratch = scratch_begin(0, 0);
+    U64 start_us = os_now_microseconds();
     DI_Key key_normalized = di_normalized_key_from_key(scratch.arena, key);
     U64 hash = di_hash_from_key(&key_normalized);
     U64 slot_idx = hash%di_shared->slots_count;
@@ -444,6 +454,7 @@ di_rdi_from_key(DI_Scope *scope, DI_Key *key, U64 endt_us)
         if(sent)
         {
           ins_atomic_u64_eval_assign(&node->last_time_requested_us, os_now_microseconds());
+          ins_atomic_u64_inc_eval(&di_shared->request_count);
         }
       }
       
@@ -458,6 +469,11 @@ di_rdi_from_key(DI_Scope *scope, DI_Key *key, U64 endt_us)
         os_condition_variable_wait_rw_r(stripe->cv, stripe->rw_mutex, endt_us);
       }
     }
+    
+    //- rjf: bump stats
+    ins_atomic_u64_inc_eval(&di_shared->lookup_count);
+    ins_atomic_u64_inc_eval(result != &di_rdi_parsed_nil ? &di_shared->hit_count : &di_shared->miss_count);
+    metric_histogram_record(di_shared->lookup_wait_us_histogram, os_now_microseconds()-start_us);
     scratch_end(scratch);
   }
   return result;
@@ -598,6 +614,7 @@ di_parse_thread__entry_point(void *p)
     //- rjf: take task
     //
     B32 got_task = 0;
+    U64 task_start_us = os_now_microseconds();
     OS_MutexScopeR(stripe->rw_mutex)
     {
       DI_Node *node = di_node_from_key_slot__stripe_mutex_r_guarded(slot, &key);
@@ -787,6 +804,8 @@ di_parse_thread__entry_point(void *p)
               break;
             }
           }
+          ins_atomic_u64_inc_eval(&di_shared->conversion_count);
+          metric_histogram_record(di_shared->conversion_us_histogram, os_now_microseconds()-start_wait_t);
         }
         
         //- rjf: push conversion task end event
@@ -916,6 +935,11 @@ di_parse_thread__entry_point(void *p)
         node->parse_done = 1;
       }
     }
+    if(got_task)
+    {
+      ins_atomic_u64_inc_eval(&di_shared->parse_count);
+      metric_histogram_record(di_shared->parse_us_histogram, os_now_microseconds()-task_start_us);
+    }
     os_condition_variable_broadcast(stripe->cv);
     
     scratch_end(scratch);
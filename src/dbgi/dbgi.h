@@ -185,6 +185,17 @@ struct DI_Shared
   // rjf: threads
   U64 parse_thread_count;
   OS_Handle *parse_threads;
+  
+  // rjf: metrics
+  U64 lookup_count;
+  U64 hit_count;
+  U64 miss_count;
+  U64 request_count;
+  U64 parse_count;
+  U64 conversion_count;
+  MetricHistogram *lookup_wait_us_histogram;
+  MetricHistogram *parse_us_histogram;
+  MetricHistogram *conversion_us_histogram;
 };
 
 ////////////////////////////////
@@ -2109,6 +2109,11 @@ df_entity_equip_name(DF_StateDeltaHistory *hist, DF_Entity *entity, String8 name
     entity->name = str8_zero();
   }
   entity->name_generation += 1;
+  entity->name_path_part_id = string_id_zero();
+  if(entity->kind == DF_EntityKind_File || entity->kind == DF_EntityKind_OverrideFileLink)
+  {
+    entity->name_path_part_id = df_path_part_id_from_string(entity->name, 1);
+  }
   df_entity_notify_mutation(entity);
 }
 
@@ -2126,13 +2131,29 @@ df_entity_equip_namef(DF_StateDeltaHistory *hist, DF_Entity *entity, char *fmt,
 
 //- rjf: opening folders/files & maintaining the entity model of the filesystem
 
+internal StringID
+df_path_part_id_from_string(String8 string, B32 intern)
+{
+  // rjf: path parts are compared case-insensitively on some OSes, so intern
+  // the case-folded form there - then path part equality is ID equality
+  Temp scratch = scratch_begin(0, 0);
+  StringMatchFlags path_match_flags = path_match_flags_from_os(operating_system_from_context());
+  String8 string_folded = string;
+  if(path_match_flags & StringMatchFlag_CaseInsensitive)
+  {
+    string_folded = lower_from_str8(scratch.arena, string);
+  }
+  StringID result = intern ? string_id_from_str8(string_folded) : string_id_lookup(string_folded);
+  scratch_end(scratch);
+  return result;
+}
+
 internal DF_Entity *
 df_entity_from_path(String8 path, DF_EntityFromPathFlags flags)
 {
   Temp scratch = scratch_begin(0, 0);
   PathStyle path_style = PathStyle_Relative;
   String8List path_parts = path_normalized_list_from_string(scratch.arena, path, &path_style);
-  StringMatchFlags path_match_flags = path_match_flags_from_os(operating_system_from_context());
   
   //- rjf: pass 1: open parts, ignore overrides
   DF_Entity *file_no_override = &df_g_nil_entity;
@@ -2142,11 +2163,15 @@ df_entity_from_path(String8 path, DF_EntityFromPathFlags flags)
         path_part_n != 0;
         path_part_n = path_part_n->next)
     {
-      // rjf: find next child
+      // rjf: find next child - if this part was never interned, no entity
+      // can have it as its name, so there is nothing to search
       DF_Entity *next_parent = &df_g_nil_entity;
-      for(DF_Entity *child = parent->first; !df_entity_is_nil(child); child = child->next)
+      StringID path_part_id = df_path_part_id_from_string(path_part_n->string, 0);
+      for(DF_Entity *child = parent->first;
+          !df_entity_is_nil(child) && !string_id_match(path_part_id, string_id_zero());
+          child = child->next)
       {
-        B32 name_matches = str8_match(child->name, path_part_n->string, path_match_flags);
+        B32 name_matches = string_id_match(child->name_path_part_id, path_part_id);
         if(name_matches && child->kind == DF_EntityKind_File)
         {
           next_parent = child;
@@ -2197,11 +2222,15 @@ df_entity_from_path(String8 path, DF_EntityFromPathFlags flags)
         path_part_n != 0;
         path_part_n = path_part_n->next)
     {
-      // rjf: find next child
+      // rjf: find next child - if this part was never interned, no entity
+      // can have it as its name, so there is nothing to search
       DF_Entity *next_parent = &df_g_nil_entity;
-      for(DF_Entity *child = parent->first; !df_entity_is_nil(child); child = child->next)
+      StringID path_part_id = df_path_part_id_from_string(path_part_n->string, 0);
+      for(DF_Entity *child = parent->first;
+          !df_entity_is_nil(child) && !string_id_match(path_part_id, string_id_zero());
+          child = child->next)
       {
-        B32 name_matches = str8_match(child->name, path_part_n->string, path_match_flags);
+        B32 name_matches = string_id_match(child->name_path_part_id, path_part_id);
         if(name_matches && child->kind == DF_EntityKind_File)
         {
           next_parent = child;
@@ -2298,7 +2327,7 @@ df_possible_overrides_from_entity(Arena *arena, DF_Entity *entity)
             !df_entity_is_nil(child);
             child = child->next)
         {
-          B32 name_matches = str8_match(child->name, link_src->name, path_match_flags);
+          B32 name_matches = string_id_match(child->name_path_part_id, link_src->name_path_part_id);
           if(name_matches && child->kind == DF_EntityKind_File)
           {
             link_overridden_sibling = child;
@@ -3156,6 +3185,9 @@ df_vaddr_range_from_voff_range(DF_Entity *module, Rng1U64 voff_rng)
 
 //- rjf: symbol lookups
 
+// NOTE(rjf): symbol names are interned rather than copied onto `arena` - they
+// are requested for the same few symbols every frame (call stacks, disassembly
+// annotations), and interned strings stay valid for the rest of the process.
 internal String8
 df_symbol_name_from_dbgi_key_voff(Arena *arena, DI_Key *dbgi_key, U64 voff)
 {
@@ -3172,7 +3204,7 @@ df_symbol_name_from_dbgi_key_voff(Arena *arena, DI_Key *dbgi_key, U64 voff)
       RDI_Procedure *procedure = &rdi->procedures[proc_idx];
       U64 name_size = 0;
       U8 *name_ptr = rdi_string_from_idx(rdi, procedure->name_string_idx, &name_size);
-      result = push_str8_copy(arena, str8(name_ptr, name_size));
+      result = str8_from_string_id(string_id_from_str8(str8(name_ptr, name_size)));
     }
     if(result.size == 0 && rdi->global_vmap != 0)
     {
@@ -3180,7 +3212,7 @@ df_symbol_name_from_dbgi_key_voff(Arena *arena, DI_Key *dbgi_key, U64 voff)
       RDI_GlobalVariable *global_var = rdi_element_from_idx(rdi, global_variables, global_idx);
       U64 name_size = 0;
       U8 *name_ptr = rdi_string_from_idx(rdi, global_var->name_string_idx, &name_size);
-      result = push_str8_copy(arena, str8(name_ptr, name_size));
+      result = str8_from_string_id(string_id_from_str8(str8(name_ptr, name_size)));
     }
     di_scope_close(scope);
     scratch_end(scratch);
@@ -3687,7 +3719,11 @@ df_log_from_entity(DF_Entity *entity)
   String8 user_data_folder = push_str8f(scratch.arena, "%S/%S", user_program_data_path, str8_lit("raddbg/logs"));
   String8 log_path = push_str8f(scratch.arena, "%S/log%s%S.txt", user_data_folder, log_name.size != 0 ? "_" : "", log_name);
   DF_Entity *log = df_entity_from_path(log_path, DF_EntityFromPathFlag_OpenAsNeeded|DF_EntityFromPathFlag_OpenMissing);
-  log->flags |= DF_EntityFlag_Output;
+  if(!(log->flags & DF_EntityFlag_Output))
+  {
+    log->flags |= DF_EntityFlag_Output;
+    txti_set_buffer_bounds(df_txti_handle_from_entity(log), DF_LOG_MAX_SIZE, 0);
+  }
   scratch_end(scratch);
   return log;
 }
@@ -378,6 +378,10 @@ struct DF_CoreViewRuleSpec
 ////////////////////////////////
 //~ rjf: Entity Types
 
+// NOTE(rjf): output log buffers are bounded, so that long sessions against
+// processes which log heavily stay fast - the oldest output is trimmed first.
+#define DF_LOG_MAX_SIZE MB(64)
+
 typedef U32 DF_EntitySubKind;
 
 typedef U32 DF_EntityFlags;
@@ -459,6 +463,7 @@ struct DF_Entity
   // rjf: name equipment
   String8 name;
   U64 name_generation;
+  StringID name_path_part_id;
   
   // rjf: timestamp
   U64 timestamp;
@@ -1477,6 +1482,7 @@ internal void df_entity_equip_name(DF_StateDeltaHistory *hist, DF_Entity *entity
 internal void df_entity_equip_namef(DF_StateDeltaHistory *hist, DF_Entity *entity, char *fmt, ...);
 
 //- rjf: opening folders/files & maintaining the entity model of the filesystem
+internal StringID df_path_part_id_from_string(String8 string, B32 intern);
 internal DF_Entity *df_entity_from_path(String8 path, DF_EntityFromPathFlags flags);
 internal DF_EntityList df_possible_overrides_from_entity(Arena *arena, DF_Entity *entity);
 
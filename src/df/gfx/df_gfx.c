@@ -3529,6 +3529,34 @@ df_window_update_and_render(Arena *arena, DF_Window *ws, DF_CmdList *cmds)
           }
         }
         
+        //- rjf: draw metrics from all layers
+        {
+          Temp scratch = scratch_begin(&arena, 1);
+          if(ui_clicked(df_icon_buttonf(DF_IconKind_Clipboard, 0, "Copy Metrics")))
+          {
+            os_set_clipboard_text(metrics_dump(scratch.arena));
+          }
+          MetricValueArray metrics = metric_values_snapshot(scratch.arena);
+          for(U64 idx = 0; idx < metrics.count; idx += 1)
+          {
+            MetricValue *m = &metrics.v[idx];
+            switch(m->kind)
+            {
+              default:{}break;
+              case MetricKind_Counter:
+              case MetricKind_Gauge:
+              {
+                ui_labelf("%S: %I64u", m->name, m->value);
+              }break;
+              case MetricKind_Histogram:
+              {
+                ui_labelf("%S: n=%I64u p50=%I64u p90=%I64u p99=%I64u max=%I64u", m->name, m->count, m->p50, m->p90, m->p99, m->max);
+              }break;
+            }
+          }
+          scratch_end(scratch);
+        }
+
         //- rjf: draw entity file tree
 #if 0
         DF_EntityRec rec = {0};
@@ -5679,9 +5707,10 @@ df_window_update_and_render(Arena *arena, DF_Window *ws, DF_CmdList *cmds)
     }
     
     ////////////////////////////
-    //- rjf: build hover eval
+    //- rjf: build hover eval - its content is wanted after what is already
+    // on screen, but before anything prefetched
     //
-    ProfScope("build hover eval")
+    ProfScope("build hover eval") CE_PriorityScope(CE_Priority_Hover)
     {
       B32 build_hover_eval = hover_eval_is_open;
       
@@ -11433,7 +11462,7 @@ df_code_slice(DF_Window *ws, DF_CtrlCtx *ctrl_ctx, EVAL_ParseCtx *parse_ctx, DF_
         // rjf: build line num box
         ui_set_next_text_color(text_color);
         ui_set_next_background_color(bg_color);
-        ui_build_box_from_stringf(UI_BoxFlag_DrawText|(UI_BoxFlag_DrawBackground*!!has_line_info), "%I64u##line_num", line_num);
+        ui_build_box_from_stringf(UI_BoxFlag_DrawText|(UI_BoxFlag_DrawBackground*!!has_line_info), "%I64u##line_num", line_num + params->line_num_display_off);
       }
     }
   }
@@ -11602,12 +11631,33 @@ df_code_slice(DF_Window *ws, DF_CtrlCtx *ctrl_ctx, EVAL_ParseCtx *parse_ctx, DF_
         // rjf: equip fancy strings to line box
         ui_box_equip_display_fancy_strings(line_box, &line_fancy_strings);
         
-        // rjf: extra rendering for strings that are currently being searched for
+        // rjf: extra rendering for strings that are currently being searched for -
+        // taken from the cached search results, once they cover this line, or
+        // otherwise found by searching the line
         if(params->search_query.size != 0)
         {
+          TXT_SearchResults *search_results = &params->search_results;
+          B32 line_is_searched = (search_results->is_complete || (search_results->bytes_searched != 0 && search_results->bytes_searched >= line_range.max));
+          U64 match_idx = 0;
+          if(line_is_searched && line_range.min != 0)
+          {
+            match_idx = txt_search_match_idx_upper_bound_from_results_off(search_results, line_range.min-1);
+          }
           for(U64 needle_pos = 0; needle_pos < line_string.size;)
           {
-            needle_pos = str8_find_needle(line_string, needle_pos, params->search_query, StringMatchFlag_CaseInsensitive);
+            if(line_is_searched)
+            {
+              needle_pos = line_string.size;
+              if(match_idx < search_results->matches_count && search_results->matches[match_idx].min < line_range.max)
+              {
+                needle_pos = search_results->matches[match_idx].min - line_range.min;
+                match_idx += 1;
+              }
+            }
+            else
+            {
+              needle_pos = str8_find_needle(line_string, needle_pos, params->search_query, StringMatchFlag_CaseInsensitive);
+            }
             if(needle_pos < line_string.size)
             {
               Rng1U64 match_range = r1u64(needle_pos, needle_pos+params->search_query.size);
@@ -11923,7 +11973,7 @@ df_do_txt_controls(TXT_TextInfo *info, String8 data, U64 line_count_per_page, Tx
       //- rjf: movement to endpoint (+)
       if(n->v.delta_unit == UI_EventDeltaUnit_Whole && (delta.y > 0 || delta.x > 0))
       {
-        *cursor = txt_pt(line_count, info->lines_count ? dim_1u64(info->lines_ranges[info->lines_count-1])+1 : 1);
+        *cursor = txt_pt(line_count, info->lines_count ? dim_1u64(txt_line_range_from_info_line_num(info, info->lines_count))+1 : 1);
         change = 1;
         taken = 1;
       }
@@ -397,6 +397,7 @@ struct DF_CodeSliceParams
   // rjf: content
   DF_CodeSliceFlags flags;
   Rng1S64 line_num_range;
+  U64 line_num_display_off;
   String8 *line_text;
   Rng1U64 *line_ranges;
   TXT_TokenArray *line_tokens;
@@ -411,6 +412,7 @@ struct DF_CodeSliceParams
   F_Tag font;
   F32 font_size;
   String8 search_query;
+  TXT_SearchResults search_results;
   F32 line_height_px;
   F32 margin_width_px;
   F32 line_num_width_px;
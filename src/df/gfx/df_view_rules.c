@@ -562,8 +562,9 @@ DF_GFX_VIEW_RULE_BLOCK_UI_FUNCTION_DEF(text)
     code_slice_params.line_src2dasm = push_array(scratch.arena, DF_TextLineSrc2DasmInfoList, info.lines_count);
     for(U64 line_idx = 0; line_idx < info.lines_count; line_idx += 1)
     {
-      code_slice_params.line_text[line_idx] = str8_substr(data, info.lines_ranges[line_idx]);
-      code_slice_params.line_ranges[line_idx] = info.lines_ranges[line_idx];
+      Rng1U64 line_range = txt_line_range_from_info_line_num(&info, (S64)line_idx+1);
+      code_slice_params.line_text[line_idx] = str8_substr(data, line_range);
+      code_slice_params.line_ranges[line_idx] = line_range;
       code_slice_params.line_tokens[line_idx] = line_tokens_slice.line_tokens[line_idx];
     }
     code_slice_params.font = df_font_from_slot(DF_FontSlot_Code);
@@ -5768,7 +5768,11 @@ DF_VIEW_UI_FUNCTION_DEF(Code)
   U128 key = fs_key_from_path(path);
   TXT_LangKind lang_kind = txt_lang_kind_from_extension(str8_skip_last_dot(path));
   U128 hash = {0};
-  TXT_TextInfo text_info = txt_text_info_from_key_lang(txt_scope, key, lang_kind, &hash);
+  TXT_TextInfo text_info = {0};
+  TXT_VisibleLineRangeScope(r1s64(view->scroll_pos.y.idx + 1, view->scroll_pos.y.idx + 1 + num_possible_visible_lines))
+  {
+    text_info = txt_text_info_from_key_lang(txt_scope, key, lang_kind, &hash);
+  }
   String8 data = hs_data_from_hash(hs_scope, hash);
   B32 text_info_is_ready = (text_info.lines_count != 0);
   
@@ -5868,14 +5872,21 @@ DF_VIEW_UI_FUNCTION_DEF(Code)
       code_slice_params.margin_float_off_px = 0;
     }
     
+    // rjf: fill cached matches of the search query, for highlighting
+    if(search_query.size != 0)
+    {
+      code_slice_params.search_results = txt_search_results_from_hash_needle_flags(txt_scope, hash, search_query, TXT_SearchFlag_CaseInsensitive);
+    }
+    
     // rjf: fill text info
     {
       S64 line_num = visible_line_num_range.min;
       U64 line_idx = visible_line_num_range.min-1;
       for(U64 visible_line_idx = 0; visible_line_idx < visible_line_count; visible_line_idx += 1, line_idx += 1, line_num += 1)
       {
-        code_slice_params.line_text[visible_line_idx]   = str8_substr(data, text_info.lines_ranges[line_idx]);
-        code_slice_params.line_ranges[visible_line_idx] = text_info.lines_ranges[line_idx];
+        Rng1U64 line_range = txt_line_range_from_info_line_num(&text_info, line_num);
+        code_slice_params.line_text[visible_line_idx]   = str8_substr(data, line_range);
+        code_slice_params.line_ranges[visible_line_idx] = line_range;
         code_slice_params.line_tokens[visible_line_idx] = slice.line_tokens[visible_line_idx];
       }
     }
@@ -6017,16 +6028,43 @@ DF_VIEW_UI_FUNCTION_DEF(Code)
     {
       Temp scratch = scratch_begin(0, 0);
       B32 found = 0;
+      B32 searched = 0;
+      
+      // rjf: try search cache - usable once it has searched up to the first
+      // match after the cursor, or everything, if it must wrap around
+      {
+        TXT_SearchResults search_results = txt_search_results_from_hash_needle_flags(txt_scope, hash, tv->find_text_fwd, TXT_SearchFlag_CaseInsensitive);
+        U64 cursor_off = txt_off_from_info_pt(&text_info, tv->cursor);
+        U64 match_idx = txt_search_match_idx_upper_bound_from_results_off(&search_results, cursor_off);
+        if(match_idx == search_results.matches_count && search_results.is_complete)
+        {
+          match_idx = 0;
+          searched = (search_results.matches_count == 0);
+        }
+        if(match_idx < search_results.matches_count)
+        {
+          TxtPt match_pt = txt_pt_from_info_off(&text_info, search_results.matches[match_idx].min);
+          if(match_pt.line != 0)
+          {
+            tv->cursor = match_pt;
+            tv->mark = tv->cursor;
+            found = 1;
+            searched = 1;
+          }
+        }
+      }
+      
+      // rjf: otherwise, search line-by-line
       B32 first = 1;
       S64 line_num_start = tv->cursor.line;
       S64 line_num_last = (S64)text_info.lines_count;
-      for(S64 line_num = line_num_start;; first = 0)
+      for(S64 line_num = line_num_start; !searched; first = 0)
       {
         // rjf: pop scratch
         temp_end(scratch);
         
         // rjf: gather line info
-        String8 line_string = str8_substr(data, text_info.lines_ranges[line_num-1]);
+        String8 line_string = str8_substr(data, txt_line_range_from_info_line_num(&text_info, line_num));
         U64 search_start = 0;
         if(tv->cursor.line == line_num && first)
         {
@@ -6073,16 +6111,47 @@ DF_VIEW_UI_FUNCTION_DEF(Code)
     {
       Temp scratch = scratch_begin(0, 0);
       B32 found = 0;
+      B32 searched = 0;
+      
+      // rjf: try search cache - usable once it has searched up to the cursor,
+      // or everything, if it must wrap around
+      {
+        TXT_SearchResults search_results = txt_search_results_from_hash_needle_flags(txt_scope, hash, tv->find_text_bwd, TXT_SearchFlag_CaseInsensitive);
+        U64 cursor_off = txt_off_from_info_pt(&text_info, tv->cursor);
+        U64 match_idx = 0;
+        if(cursor_off >= tv->find_text_bwd.size)
+        {
+          match_idx = txt_search_match_idx_upper_bound_from_results_off(&search_results, cursor_off - tv->find_text_bwd.size);
+        }
+        if(match_idx == 0 && search_results.is_complete)
+        {
+          match_idx = search_results.matches_count;
+          searched = (search_results.matches_count == 0);
+        }
+        if(0 < match_idx && (cursor_off <= search_results.bytes_searched || search_results.is_complete))
+        {
+          TxtPt match_pt = txt_pt_from_info_off(&text_info, search_results.matches[match_idx-1].min);
+          if(match_pt.line != 0)
+          {
+            tv->cursor = match_pt;
+            tv->mark = tv->cursor;
+            found = 1;
+            searched = 1;
+          }
+        }
+      }
+      
+      // rjf: otherwise, search line-by-line
       B32 first = 1;
       S64 line_num_start = tv->cursor.line;
       S64 line_num_last = (S64)text_info.lines_count;
-      for(S64 line_num = line_num_start;; first = 0)
+      for(S64 line_num = line_num_start; !searched; first = 0)
       {
         // rjf: pop scratch
         temp_end(scratch);
         
         // rjf: gather line info
-        String8 line_string = str8_substr(data, text_info.lines_ranges[line_num-1]);
+        String8 line_string = str8_substr(data, txt_line_range_from_info_line_num(&text_info, line_num));
         if(tv->cursor.line == line_num && first)
         {
           line_string = str8_prefix(line_string, tv->cursor.column-1);
@@ -6354,7 +6423,7 @@ DF_VIEW_UI_FUNCTION_DEF(Code)
     if(tv->center_cursor)
     {
       tv->center_cursor = 0;
-      String8 cursor_line = str8_substr(data, text_info.lines_ranges[tv->cursor.line-1]);
+      String8 cursor_line = str8_substr(data, txt_line_range_from_info_line_num(&text_info, tv->cursor.line));
       F32 cursor_advance = f_dim_from_tag_size_string(code_font, code_font_size, str8_prefix(cursor_line, tv->cursor.column-1)).x;
       
       // rjf: scroll x
@@ -6377,7 +6446,7 @@ DF_VIEW_UI_FUNCTION_DEF(Code)
     // rjf: snap in X
     if(snap[Axis2_X])
     {
-      String8 cursor_line = str8_substr(data, text_info.lines_ranges[tv->cursor.line-1]);
+      String8 cursor_line = str8_substr(data, txt_line_range_from_info_line_num(&text_info, tv->cursor.line));
       S64 cursor_off = (S64)(f_dim_from_tag_size_string(code_font, code_font_size, str8_prefix(cursor_line, tv->cursor.column-1)).x + margin_width_px + line_num_width_px);
       Rng1S64 visible_pixel_range =
       {
@@ -6875,6 +6944,41 @@ DF_VIEW_UI_FUNCTION_DEF(Disassembly)
     df_view_equip_loading_info(view, is_loading, 0, 0);
   }
   
+  //////////////////////////////
+  //- rjf: prefetch the disassembly (& its text) of the regions on either
+  // side of this one, behind all visible requests, so that scrolling or
+  // stepping out of this region finds its neighbor ready
+  //
+  if(has_disasm) CE_PriorityScope(CE_Priority_Prefetch)
+  {
+    U64 region_size = dim_1u64(dasm_vaddr_range);
+    Rng1U64 neighbor_vaddr_ranges[] =
+    {
+      r1u64(dasm_vaddr_range.min - region_size, dasm_vaddr_range.min),
+      r1u64(dasm_vaddr_range.max, dasm_vaddr_range.max + region_size),
+    };
+    for(U64 idx = 0; idx < ArrayCount(neighbor_vaddr_ranges); idx += 1)
+    {
+      Rng1U64 neighbor_vaddr_range = neighbor_vaddr_ranges[idx];
+      if(neighbor_vaddr_range.min >= neighbor_vaddr_range.max)
+      {
+        continue;
+      }
+      DF_Entity *neighbor_module = df_module_from_process_vaddr(process, neighbor_vaddr_range.min);
+      U128 neighbor_key = ctrl_hash_store_key_from_process_vaddr_range(process->ctrl_machine_id, process->ctrl_handle, neighbor_vaddr_range, 0);
+      U128 neighbor_data_hash = {0};
+      DASM_Params neighbor_params = dasm_params;
+      {
+        neighbor_params.vaddr = neighbor_vaddr_range.min;
+        neighbor_params.base_vaddr = neighbor_module->vaddr_rng.min;
+        neighbor_params.dbgi_key = df_dbgi_key_from_module(neighbor_module);
+      }
+      DASM_Info neighbor_info = dasm_info_from_key_params(dasm_scope, neighbor_key, &neighbor_params, &neighbor_data_hash);
+      U128 neighbor_text_hash = {0};
+      txt_text_info_from_key_lang(txt_scope, neighbor_info.text_key, txt_lang_kind_from_architecture(arch), &neighbor_text_hash);
+    }
+  }
+  
   //////////////////////////////
   //- rjf: determine visible line range / count
   //
@@ -6962,8 +7066,9 @@ DF_VIEW_UI_FUNCTION_DEF(Disassembly)
       U64 line_idx = visible_line_num_range.min-1;
       for(U64 visible_line_idx = 0; visible_line_idx < visible_line_count; visible_line_idx += 1, line_idx += 1, line_num += 1)
       {
-        code_slice_params.line_text[visible_line_idx]   = str8_substr(dasm_text_data, dasm_text_info.lines_ranges[line_idx]);
-        code_slice_params.line_ranges[visible_line_idx] = dasm_text_info.lines_ranges[line_idx];
+        Rng1U64 line_range = txt_line_range_from_info_line_num(&dasm_text_info, line_num);
+        code_slice_params.line_text[visible_line_idx]   = str8_substr(dasm_text_data, line_range);
+        code_slice_params.line_ranges[visible_line_idx] = line_range;
         code_slice_params.line_tokens[visible_line_idx] = slice.line_tokens[visible_line_idx];
       }
     }
@@ -6981,7 +7086,7 @@ DF_VIEW_UI_FUNCTION_DEF(Disassembly)
         if(df_entity_ancestor_from_kind(thread, DF_EntityKind_Process) == process && contains_1u64(dasm_vaddr_range, rip_vaddr))
         {
           U64 rip_off = rip_vaddr - dasm_vaddr_range.min;
-          S64 line_num = dasm_inst_array_idx_from_code_off__linear_scan(&dasm_info.insts, rip_off)+1;
+          S64 line_num = dasm_inst_array_idx_from_code_off(&dasm_info.insts, rip_off)+1;
           if(contains_1s64(visible_line_num_range, line_num))
           {
             U64 slice_line_idx = (line_num-visible_line_num_range.min);
@@ -7001,7 +7106,7 @@ DF_VIEW_UI_FUNCTION_DEF(Disassembly)
         if(bp->flags & DF_EntityFlag_HasVAddr && contains_1u64(dasm_vaddr_range, bp->vaddr))
         {
           U64 off = bp->vaddr-dasm_vaddr_range.min;
-          U64 idx = dasm_inst_array_idx_from_code_off__linear_scan(&dasm_info.insts, off);
+          U64 idx = dasm_inst_array_idx_from_code_off(&dasm_info.insts, off);
           S64 line_num = (S64)(idx+1);
           if(contains_1s64(visible_line_num_range, line_num))
           {
@@ -7022,7 +7127,7 @@ DF_VIEW_UI_FUNCTION_DEF(Disassembly)
         if(pin->flags & DF_EntityFlag_HasVAddr && contains_1u64(dasm_vaddr_range, pin->vaddr))
         {
           U64 off = pin->vaddr-dasm_vaddr_range.min;
-          U64 idx = dasm_inst_array_idx_from_code_off__linear_scan(&dasm_info.insts, off);
+          U64 idx = dasm_inst_array_idx_from_code_off(&dasm_info.insts, off);
           S64 line_num = (S64)(idx+1);
           if(contains_1s64(visible_line_num_range, line_num))
           {
@@ -7069,7 +7174,7 @@ DF_VIEW_UI_FUNCTION_DEF(Disassembly)
   {
     U64 vaddr = dv->goto_vaddr;
     dv->goto_vaddr = 0;
-    U64 line_idx = dasm_inst_array_idx_from_code_off__linear_scan(&dasm_info.insts, vaddr-dasm_vaddr_range.min);
+    U64 line_idx = dasm_inst_array_idx_from_code_off(&dasm_info.insts, vaddr-dasm_vaddr_range.min);
     S64 line_num = (S64)(line_idx+1);
     dv->cursor = dv->mark = txt_pt(line_num, 1);
     dv->center_cursor = !dv->contain_cursor || (line_num < visible_line_num_range.min+8 || visible_line_num_range.max-8 < line_num);
@@ -7708,14 +7813,23 @@ DF_VIEW_UI_FUNCTION_DEF(Output)
   }
   
   //////////////////////////////
-  //- rjf: determine visible line range / count
+  //- rjf: determine visible line range / count, & grab the slice of text for
+  // it. the slice carries its own trim count, taken under the same lock, so
+  // line numbering always matches its text. if lines were trimmed from the
+  // head of the log since the last frame, shift cursor & scroll position so
+  // that they stay on the same text - or reset them, if the count went down,
+  // as the log was cleared - & grab the slice again.
   //
-  Rng1S64 visible_line_num_range = r1s64(view->scroll_pos.y.idx + (S64)(view->scroll_pos.y.off) + 1 - !!(view->scroll_pos.y.off < 0),
-                                         view->scroll_pos.y.idx + (S64)(view->scroll_pos.y.off) + 1 + num_possible_visible_lines);
-  Rng1S64 target_visible_line_num_range = r1s64(view->scroll_pos.y.idx + 1,
-                                                view->scroll_pos.y.idx + 1 + num_possible_visible_lines);
+  Rng1S64 visible_line_num_range = {0};
+  Rng1S64 target_visible_line_num_range = {0};
   U64 visible_line_count = 0;
+  TXTI_Slice slice = {0};
+  for(;;)
   {
+    visible_line_num_range = r1s64(view->scroll_pos.y.idx + (S64)(view->scroll_pos.y.off) + 1 - !!(view->scroll_pos.y.off < 0),
+                                   view->scroll_pos.y.idx + (S64)(view->scroll_pos.y.off) + 1 + num_possible_visible_lines);
+    target_visible_line_num_range = r1s64(view->scroll_pos.y.idx + 1,
+                                          view->scroll_pos.y.idx + 1 + num_possible_visible_lines);
     visible_line_num_range.min = Clamp(1, visible_line_num_range.min, (S64)txti_buffer_info.total_line_count);
     visible_line_num_range.max = Clamp(1, visible_line_num_range.max, (S64)txti_buffer_info.total_line_count);
     visible_line_num_range.min = Max(1, visible_line_num_range.min);
@@ -7724,7 +7838,31 @@ DF_VIEW_UI_FUNCTION_DEF(Output)
     target_visible_line_num_range.max = Clamp(1, target_visible_line_num_range.max, (S64)txti_buffer_info.total_line_count);
     target_visible_line_num_range.min = Max(1, target_visible_line_num_range.min);
     target_visible_line_num_range.max = Max(1, target_visible_line_num_range.max);
+    slice = txti_slice_from_handle_line_range(scratch.arena, txti_handle, visible_line_num_range);
+    if(slice.line_count != 0)
+    {
+      visible_line_num_range.max = Min(visible_line_num_range.max, visible_line_num_range.min + (S64)slice.line_count - 1);
+    }
     visible_line_count = (U64)dim_1s64(visible_line_num_range)+1;
+    if(slice.trimmed_line_count == tv->trimmed_line_count)
+    {
+      break;
+    }
+    if(slice.trimmed_line_count < tv->trimmed_line_count)
+    {
+      tv->cursor = tv->mark = txt_pt(1, 1);
+      tv->preferred_column = 1;
+      view->scroll_pos.y.idx = 0;
+      view->scroll_pos.y.off = 0;
+    }
+    else
+    {
+      S64 trimmed_delta = (S64)(slice.trimmed_line_count - tv->trimmed_line_count);
+      tv->cursor.line = ClampBot(1, tv->cursor.line - trimmed_delta);
+      tv->mark.line = ClampBot(1, tv->mark.line - trimmed_delta);
+      view->scroll_pos.y.idx = ClampBot(0, view->scroll_pos.y.idx - trimmed_delta);
+    }
+    tv->trimmed_line_count = slice.trimmed_line_count;
   }
   
   //////////////////////////////
@@ -7745,7 +7883,6 @@ DF_VIEW_UI_FUNCTION_DEF(Output)
   //
   F32 margin_width_px = big_glyph_advance*3.5f;
   F32 line_num_width_px = big_glyph_advance * (log10(visible_line_num_range.max) + 3);
-  TXTI_Slice slice = txti_slice_from_handle_line_range(scratch.arena, txti_handle, visible_line_num_range);
   
   //////////////////////////////
   //- rjf: get active search query
@@ -7773,6 +7910,7 @@ DF_VIEW_UI_FUNCTION_DEF(Output)
     // rjf: fill basics
     code_slice_params.flags                     = DF_CodeSliceFlag_LineNums|DF_CodeSliceFlag_Clickable;
     code_slice_params.line_num_range            = visible_line_num_range;
+    code_slice_params.line_num_display_off      = slice.trimmed_line_count;
     code_slice_params.line_text                 = slice.line_text;
     code_slice_params.line_ranges               = slice.line_ranges;
     code_slice_params.line_tokens               = slice.line_tokens;
@@ -7827,124 +7965,31 @@ DF_VIEW_UI_FUNCTION_DEF(Output)
   //
   if(txti_buffer_is_ready)
   {
-    //- rjf: find text (forward)
-    if(tv->find_text_fwd.size != 0)
+    //- rjf: find text - searched within the buffer's chunks, from the
+    // cursor, wrapping around the buffer
+    for(Side side = Side_Min; side < Side_COUNT; side = (Side)(side+1))
     {
-      Temp scratch = scratch_begin(0, 0);
-      B32 found = 0;
-      B32 first = 1;
-      S64 line_num_start = tv->cursor.line;
-      S64 line_num_last = (S64)txti_buffer_info.total_line_count;
-      for(S64 line_num = line_num_start;; first = 0)
+      String8 needle = (side == Side_Max) ? tv->find_text_fwd : tv->find_text_bwd;
+      if(needle.size != 0)
       {
-        // rjf: pop scratch
-        temp_end(scratch);
-        
-        // rjf: gather line info
-        String8 line_string = txti_string_from_handle_line_num(scratch.arena, txti_handle, line_num);
-        U64 search_start = 0;
-        if(tv->cursor.line == line_num && first)
-        {
-          search_start = tv->cursor.column;
-        }
-        
-        // rjf: search string
-        U64 needle_pos = str8_find_needle(line_string, search_start, tv->find_text_fwd, StringMatchFlag_CaseInsensitive);
-        if(needle_pos < line_string.size)
-        {
-          tv->cursor.line = line_num;
-          tv->cursor.column = needle_pos+1;
-          tv->mark = tv->cursor;
-          found = 1;
-          break;
-        }
-        
-        // rjf: break if circled back around to cursor
-        else if(line_num == line_num_start && !first)
-        {
-          break;
-        }
-        
-        // rjf: increment
-        line_num += 1;
-        if(line_num > line_num_last)
-        {
-          line_num = 1;
-        }
-      }
-      tv->center_cursor = found;
-      if(found == 0)
-      {
-        DF_CmdParams params = df_cmd_params_from_view(ws, panel, view);
-        params.string = push_str8f(scratch.arena, "Could not find \"%S\"", tv->find_text_fwd);
-        df_cmd_params_mark_slot(&params, DF_CmdParamSlot_String);
-        df_push_cmd__root(&params, df_cmd_spec_from_core_cmd_kind(DF_CoreCmdKind_Error));
-      }
-      scratch_end(scratch);
-    }
-    
-    //- rjf: find text (backward)
-    if(tv->find_text_bwd.size != 0)
-    {
-      Temp scratch = scratch_begin(0, 0);
-      B32 found = 0;
-      B32 first = 1;
-      S64 line_num_start = tv->cursor.line;
-      S64 line_num_last = (S64)txti_buffer_info.total_line_count;
-      for(S64 line_num = line_num_start;; first = 0)
-      {
-        // rjf: pop scratch
-        temp_end(scratch);
-        
-        // rjf: gather line info
-        String8 line_string = txti_string_from_handle_line_num(scratch.arena, txti_handle, line_num);
-        if(tv->cursor.line == line_num && first)
-        {
-          line_string = str8_prefix(line_string, tv->cursor.column-1);
-        }
-        
-        // rjf: search string
-        U64 next_needle_pos = line_string.size;
-        for(U64 needle_pos = 0; needle_pos < line_string.size;)
-        {
-          needle_pos = str8_find_needle(line_string, needle_pos, tv->find_text_bwd, StringMatchFlag_CaseInsensitive);
-          if(needle_pos < line_string.size)
-          {
-            next_needle_pos = needle_pos;
-            needle_pos += 1;
-          }
-        }
-        if(next_needle_pos < line_string.size)
+        Temp scratch = scratch_begin(0, 0);
+        TxtPt match_pt = txti_match_pt_from_handle_pt_needle_flags(txti_handle, tv->trimmed_line_count, tv->cursor, side, needle, TXT_SearchFlag_CaseInsensitive);
+        B32 found = (match_pt.line != 0);
+        if(found)
         {
-          tv->cursor.line = line_num;
-          tv->cursor.column = next_needle_pos+1;
+          tv->cursor = match_pt;
           tv->mark = tv->cursor;
-          found = 1;
-          break;
-        }
-        
-        // rjf: break if circled back around to cursor line
-        else if(line_num == line_num_start && !first)
-        {
-          break;
         }
-        
-        // rjf: increment
-        line_num -= 1;
-        if(line_num == 0)
+        tv->center_cursor = found;
+        if(found == 0)
         {
-          line_num = line_num_last;
+          DF_CmdParams params = df_cmd_params_from_view(ws, panel, view);
+          params.string = push_str8f(scratch.arena, "Could not find \"%S\"", needle);
+          df_cmd_params_mark_slot(&params, DF_CmdParamSlot_String);
+          df_push_cmd__root(&params, df_cmd_spec_from_core_cmd_kind(DF_CoreCmdKind_Error));
         }
+        scratch_end(scratch);
       }
-      tv->center_cursor = found;
-      if(found == 0)
-      {
-        DF_CmdParams params = df_cmd_params_from_view(ws, panel, view);
-        params.string = push_str8f(scratch.arena, "Could not find \"%S\"", tv->find_text_bwd);
-        df_cmd_params_mark_slot(&params, DF_CmdParamSlot_String);
-        df_push_cmd__root(&params, df_cmd_spec_from_core_cmd_kind(DF_CoreCmdKind_Error));
-      }
-      scratch_end(scratch);
     }
     
     MemoryZeroStruct(&tv->find_text_fwd);
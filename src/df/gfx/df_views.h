@@ -371,6 +371,7 @@ struct DF_CodeViewState
   S64 preferred_column;
   B32 drifted_for_search;
   DF_Handle pick_file_override_target;
+  U64 trimmed_line_count;
   
   // rjf: per-frame command info
   S64 goto_line_num;
@@ -184,6 +184,11 @@ fs_streamer_thread__entry_point(void *p)
     ProfBegin("load \"%.*s\"", str8_varg(path));
     FileProperties pre_props = os_properties_from_file_path(path);
     OS_Handle file = os_file_open(OS_AccessFlag_Read|OS_AccessFlag_ShareRead|OS_AccessFlag_ShareWrite, path);
+    
+    //- rjf: read into an arena. NOTE(rjf): files are never submitted as file
+    // mapping views here - other processes may write them in place (changing
+    // bytes which were already hashed), & on Windows an open mapping makes
+    // their truncates & resizes fail for as long as the blob lives.
     U64 data_arena_size = pre_props.size+ARENA_HEADER_SIZE;
     data_arena_size += KB(4)-1;
     data_arena_size -= data_arena_size%KB(4);
@@ -194,6 +199,10 @@ fs_streamer_thread__entry_point(void *p)
     String8 data = os_string_from_file_range(data_arena, file, r1u64(0, pre_props.size));
     ProfEnd();
     os_file_close(file);
+    
+    //- rjf: hash now, so the submission doesn't need to
+    U128 hash = {0};
+    ProfScope("hash") hash = hs_hash_from_data(data);
     FileProperties post_props = os_properties_from_file_path(path);
     
     //- rjf: abort if modification timestamps differ - we did not successfully read the file
@@ -212,7 +221,7 @@ fs_streamer_thread__entry_point(void *p)
     {
       ProfScope("submit")
       {
-        hs_submit_data(key, &data_arena, data);
+        hs_submit_hashed_data(key, hash, &data_arena, data);
       }
     }
     
@@ -117,6 +117,14 @@ fzy_init(void)
     fzy_shared->stripes[idx].rw_mutex = os_rw_mutex_alloc();
     fzy_shared->stripes[idx].cv = os_condition_variable_alloc();
   }
+  metric_counter_register(str8_lit("fzy.lookups"), &fzy_shared->lookup_count);
+  metric_counter_register(str8_lit("fzy.hits"), &fzy_shared->hit_count);
+  metric_counter_register(str8_lit("fzy.stale_lookups"), &fzy_shared->stale_count);
+  metric_counter_register(str8_lit("fzy.requests"), &fzy_shared->request_count);
+  metric_counter_register(str8_lit("fzy.searches"), &fzy_shared->search_count);
+  metric_counter_register(str8_lit("fzy.cancels"), &fzy_shared->cancel_count);
+  fzy_shared->lookup_wait_us_histogram = metric_histogram_alloc(str8_lit("fzy.lookup_wait_us"));
+  fzy_shared->search_us_histogram      = metric_histogram_alloc(str8_lit("fzy.search_us"));
   fzy_shared->thread_count = Min(os_logical_core_count(), 2);
   fzy_shared->threads = push_array(arena, FZY_Thread, fzy_shared->thread_count);
   for(U64 idx = 0; idx < fzy_shared->thread_count; idx += 1)
@@ -151,45 +159,17 @@ fzy_scope_open(void)
     scope = push_array_no_zero(fzy_tctx->arena, FZY_Scope, 1);
   }
   MemoryZeroStruct(scope);
+  epoch_enter();
   return scope;
 }
 
 internal void
 fzy_scope_close(FZY_Scope *scope)
 {
-  for(FZY_Touch *t = scope->first_touch, *next = 0; t != 0; t = next)
-  {
-    next = t->next;
-    SLLStackPush(fzy_tctx->free_touch, t);
-    if(t->node != 0)
-    {
-      ins_atomic_u64_dec_eval(&t->node->touch_count);
-    }
-  }
+  epoch_leave();
   SLLStackPush(fzy_tctx->free_scope, scope);
 }
 
-internal void
-fzy_scope_touch_node__stripe_mutex_r_guarded(FZY_Scope *scope, FZY_Node *node)
-{
-  if(node != 0)
-  {
-    ins_atomic_u64_inc_eval(&node->touch_count);
-  }
-  FZY_Touch *touch = fzy_tctx->free_touch;
-  if(touch != 0)
-  {
-    SLLStackPop(fzy_tctx->free_touch);
-  }
-  else
-  {
-    touch = push_array_no_zero(fzy_tctx->arena, FZY_Touch, 1);
-  }
-  MemoryZeroStruct(touch);
-  SLLQueuePush(scope->first_touch, scope->last_touch, touch);
-  touch->node = node;
-}
-
 ////////////////////////////////
 //~ rjf: Cache Lookup Functions
 
@@ -197,7 +177,9 @@ internal FZY_ItemArray
 fzy_items_from_key_params_query(FZY_Scope *scope, U128 key, FZY_Params *params, String8 query, U64 endt_us, B32 *stale_out)
 {
   Temp scratch = scratch_begin(0, 0);
+  U64 start_us = os_now_microseconds();
   FZY_ItemArray items = {0};
+  B32 is_hit = 0;
   
   //- rjf: hash parameters
   U64 params_hash = fzy_hash_from_params(params);
@@ -239,7 +221,6 @@ fzy_items_from_key_params_query(FZY_Scope *scope, U128 key, FZY_Params *params,
     if(params_hash == node->buckets[node->gen%ArrayCount(node->buckets)].params_hash &&
        node->gen != 0)
     {
-      fzy_scope_touch_node__stripe_mutex_r_guarded(scope, node);
       items = node->gen_items;
       stale = !str8_match(query, node->buckets[node->gen%ArrayCount(node->buckets)].query, 0);
       if(stale_out != 0)
@@ -248,10 +229,13 @@ fzy_items_from_key_params_query(FZY_Scope *scope, U128 key, FZY_Params *params,
       }
     }
     
-    // rjf: if stale -> request again
+    // rjf: if stale -> request again. the next bucket may hold results which
+    // were replaced, but which are still visible to open scopes - if so,
+    // leave it be, & try again later.
     if(stale) OS_MutexScopeRWPromote(stripe->rw_mutex)
     {
-      if(node->gen <= node->submit_gen && node->submit_gen < node->gen + ArrayCount(node->buckets)-1)
+      if(node->gen <= node->submit_gen && node->submit_gen < node->gen + ArrayCount(node->buckets)-1 &&
+         epoch_is_reclaimable(node->buckets[(node->submit_gen+1)%ArrayCount(node->buckets)].retire_epoch))
       {
         node->submit_gen += 1;
         arena_clear(node->buckets[node->submit_gen%ArrayCount(node->buckets)].arena);
@@ -259,16 +243,19 @@ fzy_items_from_key_params_query(FZY_Scope *scope, U128 key, FZY_Params *params,
         node->buckets[node->submit_gen%ArrayCount(node->buckets)].params = fzy_params_copy(node->buckets[node->submit_gen%ArrayCount(node->buckets)].arena, params);
         node->buckets[node->submit_gen%ArrayCount(node->buckets)].params_hash = params_hash;
       }
-      if((node->submit_gen > node->gen+1 || os_now_microseconds() >= node->last_time_submitted_us+100000) &&
+      if(node->submit_gen > node->gen &&
+         (node->submit_gen > node->gen+1 || os_now_microseconds() >= node->last_time_submitted_us+100000) &&
          fzy_u2s_enqueue_req(key, endt_us))
       {
         node->last_time_submitted_us = os_now_microseconds();
+        ins_atomic_u64_inc_eval(&fzy_shared->request_count);
       }
     }
     
     // rjf: not stale, or timeout -> break
     if(!stale || os_now_microseconds() >= endt_us)
     {
+      is_hit = !stale;
       break;
     }
     
@@ -276,6 +263,11 @@ fzy_items_from_key_params_query(FZY_Scope *scope, U128 key, FZY_Params *params,
     os_condition_variable_wait_rw_r(stripe->cv, stripe->rw_mutex, endt_us);
   }
   
+  //- rjf: bump stats
+  ins_atomic_u64_inc_eval(&fzy_shared->lookup_count);
+  ins_atomic_u64_inc_eval(is_hit ? &fzy_shared->hit_count : &fzy_shared->stale_count);
+  metric_histogram_record(fzy_shared->lookup_wait_us_histogram, os_now_microseconds()-start_us);
+  
   scratch_end(scratch);
   return items;
 }
@@ -361,6 +353,7 @@ fzy_search_thread__entry_point(void *p)
     //
     U128 key = {0};
     fzy_u2s_dequeue_req(scratch.arena, thread, &key);
+    U64 task_start_us = os_now_microseconds();
     U64 slot_idx = key.u64[1]%fzy_shared->slots_count;
     U64 stripe_idx = slot_idx%fzy_shared->stripes_count;
     FZY_Slot *slot = &fzy_shared->slots[slot_idx];
@@ -529,33 +522,34 @@ fzy_search_thread__entry_point(void *p)
       qsort(items.v, items.count, sizeof(FZY_Item), (int (*)(const void *, const void *))fzy_qsort_compare_items);
     }
     
-    //- rjf: commit to cache - busyloop on scope touches
-    if(task_is_good)
+    //- rjf: commit to cache. scopes may still be reading the replaced
+    // results, so their bucket is retired, rather than freed - it is not
+    // reused until all such scopes have closed.
+    if(task_is_good) OS_MutexScopeW(stripe->rw_mutex)
     {
-      for(B32 done = 0; !done;)
+      for(FZY_Node *n = slot->first; n != 0; n = n->next)
       {
-        B32 found = 0;
-        OS_MutexScopeW(stripe->rw_mutex) for(FZY_Node *n = slot->first; n != 0; n = n->next)
-        {
-          if(u128_match(n->key, key))
-          {
-            if(n->touch_count == 0)
-            {
-              n->gen = initial_submit_gen;
-              n->gen_items = items;
-              done = 1;
-            }
-            found = 1;
-            break;
-          }
-        }
-        if(!found)
+        if(u128_match(n->key, key))
         {
+          n->buckets[n->gen%ArrayCount(n->buckets)].retire_epoch = epoch_retire();
+          n->gen = initial_submit_gen;
+          n->gen_items = items;
           break;
         }
       }
     }
     
+    //- rjf: bump stats
+    if(task_is_good)
+    {
+      ins_atomic_u64_inc_eval(&fzy_shared->search_count);
+      metric_histogram_record(fzy_shared->search_us_histogram, os_now_microseconds()-task_start_us);
+    }
+    else if(task_arena != 0)
+    {
+      ins_atomic_u64_inc_eval(&fzy_shared->cancel_count);
+    }
+    
     di_scope_close(di_scope);
     scratch_end(scratch);
   }
@@ -70,6 +70,7 @@ struct FZY_Bucket
   String8 query;
   FZY_Params params;
   U64 params_hash;
+  U64 retire_epoch;
 };
 
 typedef struct FZY_Node FZY_Node;
@@ -77,7 +78,6 @@ struct FZY_Node
 {
   FZY_Node *next;
   U128 key;
-  U64 touch_count;
   U64 last_time_submitted_us;
   FZY_Bucket buckets[3];
   U64 gen;
@@ -103,19 +103,10 @@ struct FZY_Stripe
 ////////////////////////////////
 //~ rjf: Scoped Access Types
 
-typedef struct FZY_Touch FZY_Touch;
-struct FZY_Touch
-{
-  FZY_Touch *next;
-  FZY_Node *node;
-};
-
 typedef struct FZY_Scope FZY_Scope;
 struct FZY_Scope
 {
   FZY_Scope *next;
-  FZY_Touch *first_touch;
-  FZY_Touch *last_touch;
 };
 
 typedef struct FZY_TCTX FZY_TCTX;
@@ -123,7 +114,6 @@ struct FZY_TCTX
 {
   Arena *arena;
   FZY_Scope *free_scope;
-  FZY_Touch *free_touch;
 };
 
 ////////////////////////////////
@@ -155,6 +145,16 @@ struct FZY_Shared
   // rjf: threads
   U64 thread_count;
   FZY_Thread *threads;
+  
+  // rjf: metrics
+  U64 lookup_count;
+  U64 hit_count;
+  U64 stale_count;
+  U64 request_count;
+  U64 search_count;
+  U64 cancel_count;
+  MetricHistogram *lookup_wait_us_histogram;
+  MetricHistogram *search_us_histogram;
 };
 
 ////////////////////////////////
@@ -182,7 +182,6 @@ internal void fzy_init(void);
 
 internal FZY_Scope *fzy_scope_open(void);
 internal void fzy_scope_close(FZY_Scope *scope);
-internal void fzy_scope_touch_node__stripe_mutex_r_guarded(FZY_Scope *scope, FZY_Node *node);
 
 ////////////////////////////////
 //~ rjf: Cache Lookup Functions
@@ -4,17 +4,19 @@
 ////////////////////////////////
 //~ rjf: Basic Helpers
 
-#if !defined(BLAKE2_H)
-#define HAVE_SSE2
-#include "third_party/blake2/blake2.h"
-#include "third_party/blake2/blake2b.c"
+#if !defined(XXH_INLINE_ALL)
+#define XXH_INLINE_ALL
+#define XXH_STATIC_LINKING_ONLY
+#include "third_party/xxHash/xxhash.h"
 #endif
 
 internal U128
 hs_hash_from_data(String8 data)
 {
   U128 u128 = {0};
-  blake2b((U8 *)&u128.u64[0], sizeof(u128), data.str, data.size, 0, 0);
+  XXH128_hash_t hash = XXH3_128bits(data.str, data.size);
+  u128.u64[0] = hash.low64;
+  u128.u64[1] = hash.high64;
   return u128;
 }
 
@@ -50,9 +52,238 @@ hs_init(void)
     stripe->rw_mutex = os_rw_mutex_alloc();
     stripe->cv = os_condition_variable_alloc();
   }
+  hs_shared->budget_bytes = GB(1);
+  hs_shared->cold_threshold_us = 30*1000000;
+  {
+    // rjf: fixed pseudo-random gear table (splitmix64), so that chunk
+    // boundaries are stable across runs
+    U64 x = 0;
+    for(U64 idx = 0; idx < ArrayCount(hs_shared->chunk_gear); idx += 1)
+    {
+      x += 0x9e3779b97f4a7c15ull;
+      U64 z = x;
+      z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+      z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+      hs_shared->chunk_gear[idx] = z ^ (z >> 31);
+    }
+  }
+  metric_gauge_register(str8_lit("hs.budget_bytes"), &hs_shared->budget_bytes);
+  metric_gauge_register(str8_lit("hs.resident_bytes"), &hs_shared->resident_bytes);
+  metric_gauge_register(str8_lit("hs.resident_blobs"), &hs_shared->resident_blob_count);
+  metric_counter_register(str8_lit("hs.hits"), &hs_shared->hit_count);
+  metric_counter_register(str8_lit("hs.misses"), &hs_shared->miss_count);
+  metric_counter_register(str8_lit("hs.evictions"), &hs_shared->eviction_count);
+  metric_counter_register(str8_lit("hs.evicted_bytes"), &hs_shared->evicted_bytes);
+  metric_gauge_register(str8_lit("hs.cold_blobs"), &hs_shared->cold_blob_count);
+  metric_gauge_register(str8_lit("hs.cold_bytes"), &hs_shared->cold_bytes);
+  metric_counter_register(str8_lit("hs.compressions"), &hs_shared->compression_count);
+  metric_counter_register(str8_lit("hs.decompressions"), &hs_shared->decompression_count);
+  metric_counter_register(str8_lit("hs.diffs"), &hs_shared->diff_count);
+  hs_shared->decompress_us_histogram = metric_histogram_alloc(str8_lit("hs.decompress_us"));
+  hs_shared->diff_us_histogram       = metric_histogram_alloc(str8_lit("hs.diff_us"));
+  hs_shared->evictor_mutex = os_mutex_alloc();
+  hs_shared->evictor_cv = os_condition_variable_alloc();
   hs_shared->evictor_thread = os_launch_thread(hs_evictor_thread__entry_point, 0, 0);
 }
 
+////////////////////////////////
+//~ rjf: Budget & Stats
+
+internal void
+hs_set_budget(U64 budget_bytes)
+{
+  ins_atomic_u64_eval_assign(&hs_shared->budget_bytes, budget_bytes);
+  ins_atomic_u64_eval_assign(&hs_shared->evict_is_exhausted, 0);
+  hs_signal_pressure_if_over_budget();
+}
+
+internal HS_Stats
+hs_stats(void)
+{
+  HS_Stats stats = {0};
+  stats.budget_bytes        = ins_atomic_u64_eval(&hs_shared->budget_bytes);
+  stats.resident_bytes      = ins_atomic_u64_eval(&hs_shared->resident_bytes);
+  stats.resident_blob_count = ins_atomic_u64_eval(&hs_shared->resident_blob_count);
+  stats.hit_count           = ins_atomic_u64_eval(&hs_shared->hit_count);
+  stats.miss_count          = ins_atomic_u64_eval(&hs_shared->miss_count);
+  stats.eviction_count      = ins_atomic_u64_eval(&hs_shared->eviction_count);
+  stats.evicted_bytes       = ins_atomic_u64_eval(&hs_shared->evicted_bytes);
+  stats.cold_blob_count     = ins_atomic_u64_eval(&hs_shared->cold_blob_count);
+  stats.cold_bytes          = ins_atomic_u64_eval(&hs_shared->cold_bytes);
+  stats.cold_raw_bytes      = ins_atomic_u64_eval(&hs_shared->cold_raw_bytes);
+  stats.compression_count   = ins_atomic_u64_eval(&hs_shared->compression_count);
+  stats.decompression_count = ins_atomic_u64_eval(&hs_shared->decompression_count);
+  stats.diff_count          = ins_atomic_u64_eval(&hs_shared->diff_count);
+  stats.diff_kept_bytes     = ins_atomic_u64_eval(&hs_shared->diff_kept_bytes);
+  return stats;
+}
+
+internal void
+hs_signal_pressure_if_over_budget(void)
+{
+  B32 is_over_budget = (ins_atomic_u64_eval(&hs_shared->resident_bytes) > ins_atomic_u64_eval(&hs_shared->budget_bytes));
+  B32 may_free = (!ins_atomic_u64_eval(&hs_shared->evict_is_exhausted) ||
+                  ins_atomic_u64_eval(&hs_shared->released_bytes) != ins_atomic_u64_eval(&hs_shared->exhausted_released_bytes));
+  if(is_over_budget && may_free)
+  {
+    OS_MutexScope(hs_shared->evictor_mutex)
+    {
+      hs_shared->pressure_gen += 1;
+    }
+    os_condition_variable_broadcast(hs_shared->evictor_cv);
+  }
+}
+
+////////////////////////////////
+//~ rjf: Cold Tier
+
+internal void
+hs_set_cold_threshold(U64 idle_us)
+{
+  ins_atomic_u64_eval_assign(&hs_shared->cold_threshold_us, idle_us);
+  hs_signal_cold_work();
+}
+
+internal void
+hs_signal_cold_work(void)
+{
+  OS_MutexScope(hs_shared->evictor_mutex)
+  {
+    hs_shared->cold_work_gen += 1;
+  }
+  os_condition_variable_broadcast(hs_shared->evictor_cv);
+}
+
+////////////////////////////////
+//~ rjf: Content-Defined Chunking & Diffs
+
+internal HS_ChunkArray
+hs_chunks_from_data(Arena *arena, String8 data)
+{
+  HS_ChunkArray result = {0};
+  result.v = push_array_no_zero(arena, HS_Chunk, data.size/HS_CHUNK_MIN_SIZE + 1);
+  U64 *gear = hs_shared->chunk_gear;
+  for(U64 chunk_start = 0; chunk_start < data.size;)
+  {
+    // rjf: find boundary. the rolling hash's top bits only depend on the last
+    // 64 bytes, so rolling need only begin 64 bytes short of the minimum size.
+    U64 chunk_end = Min(data.size, chunk_start + HS_CHUNK_MAX_SIZE);
+    U64 rolling = 0;
+    for(U64 idx = chunk_start + HS_CHUNK_MIN_SIZE - 64; idx < chunk_end; idx += 1)
+    {
+      rolling = (rolling << 1) + gear[data.str[idx]];
+      if(idx+1 >= chunk_start + HS_CHUNK_MIN_SIZE && (rolling >> (64 - HS_CHUNK_BOUNDARY_BITS)) == 0)
+      {
+        chunk_end = idx+1;
+        break;
+      }
+    }
+    
+    // rjf: push
+    HS_Chunk *chunk = &result.v[result.count];
+    chunk->size = chunk_end - chunk_start;
+    chunk->hash = XXH3_64bits(data.str + chunk_start, chunk->size);
+    result.count += 1;
+    chunk_start = chunk_end;
+  }
+  return result;
+}
+
+internal HS_Diff
+hs_diff_from_chunks(U128 base_hash, U64 base_size, HS_ChunkArray base_chunks, HS_ChunkArray chunks)
+{
+  HS_Diff diff = {0};
+  diff.base_hash = base_hash;
+  diff.base_size = base_size;
+  U64 prefix_count = 0;
+  for(;prefix_count < base_chunks.count && prefix_count < chunks.count; prefix_count += 1)
+  {
+    HS_Chunk *a = &base_chunks.v[prefix_count];
+    HS_Chunk *b = &chunks.v[prefix_count];
+    if(a->size != b->size || a->hash != b->hash)
+    {
+      break;
+    }
+    diff.prefix_size += a->size;
+  }
+  for(U64 suffix_count = 0; prefix_count+suffix_count < base_chunks.count && prefix_count+suffix_count < chunks.count; suffix_count += 1)
+  {
+    HS_Chunk *a = &base_chunks.v[base_chunks.count-1-suffix_count];
+    HS_Chunk *b = &chunks.v[chunks.count-1-suffix_count];
+    if(a->size != b->size || a->hash != b->hash)
+    {
+      break;
+    }
+    diff.suffix_size += a->size;
+  }
+  return diff;
+}
+
+internal HS_ChunkArray
+hs_chunks_from_hash(Arena *arena, HS_Scope *scope, U128 hash, U64 *size_out)
+{
+  HS_ChunkArray result = {0};
+  String8 data = {0};
+  U64 slot_idx = hash.u64[1]%hs_shared->slots_count;
+  U64 stripe_idx = slot_idx%hs_shared->stripes_count;
+  HS_Slot *slot = &hs_shared->slots[slot_idx];
+  HS_Stripe *stripe = &hs_shared->stripes[stripe_idx];
+  OS_MutexScopeR(stripe->rw_mutex)
+  {
+    for(HS_Node *n = slot->first; n != 0; n = n->next)
+    {
+      if(u128_match(n->hash, hash))
+      {
+        // rjf: chunked already -> copy
+        if(n->chunks.count != 0)
+        {
+          result.count = n->chunks.count;
+          result.v = push_array_no_zero(arena, HS_Chunk, result.count);
+          MemoryCopy(result.v, n->chunks.v, sizeof(HS_Chunk)*result.count);
+          *size_out = (n->cold_raw_size != 0 ? n->cold_raw_size : n->data.size);
+        }
+        
+        // rjf: not chunked, & not cold -> pin data to chunk outside of the
+        // lock. cold blobs are not worth decompressing just to be diffed.
+        else if(n->cold_raw_size == 0)
+        {
+          data = n->data;
+          *size_out = data.size;
+          hs_scope_touch_node__stripe_r_guarded(scope, n);
+        }
+        break;
+      }
+    }
+  }
+  if(data.size != 0)
+  {
+    result = hs_chunks_from_data(arena, data);
+  }
+  return result;
+}
+
+internal HS_Diff
+hs_diff_from_hash(U128 hash)
+{
+  HS_Diff result = {0};
+  U64 slot_idx = hash.u64[1]%hs_shared->slots_count;
+  U64 stripe_idx = slot_idx%hs_shared->stripes_count;
+  HS_Slot *slot = &hs_shared->slots[slot_idx];
+  HS_Stripe *stripe = &hs_shared->stripes[stripe_idx];
+  OS_MutexScopeR(stripe->rw_mutex)
+  {
+    for(HS_Node *n = slot->first; n != 0; n = n->next)
+    {
+      if(u128_match(n->hash, hash))
+      {
+        result = n->diff;
+        break;
+      }
+    }
+  }
+  return result;
+}
+
 ////////////////////////////////
 //~ rjf: Thread Context Initialization
 
@@ -71,19 +302,47 @@ hs_tctx_ensure_inited(void)
 //~ rjf: Cache Submission
 
 internal U128
-hs_submit_data(U128 key, Arena **data_arena, String8 data)
+hs_submit_hashed_data(U128 key, U128 hash, Arena **data_arena, String8 data)
 {
   U64 key_slot_idx = key.u64[1]%hs_shared->key_slots_count;
   U64 key_stripe_idx = key_slot_idx%hs_shared->key_stripes_count;
   HS_KeySlot *key_slot = &hs_shared->key_slots[key_slot_idx];
   HS_Stripe *key_stripe = &hs_shared->key_stripes[key_stripe_idx];
-  U128 hash = hs_hash_from_data(data);
   U64 slot_idx = hash.u64[1]%hs_shared->slots_count;
   U64 stripe_idx = slot_idx%hs_shared->stripes_count;
   HS_Slot *slot = &hs_shared->slots[slot_idx];
   HS_Stripe *stripe = &hs_shared->stripes[stripe_idx];
   
+  //- rjf: large blob replacing an older version of this key -> chunk it, &
+  // diff against that version
+  Arena *chunks_arena = 0;
+  HS_ChunkArray chunks = {0};
+  HS_Diff diff = {0};
+  if(data.size >= HS_CHUNKED_MIN_SIZE) ProfScope("chunk & diff against previous version")
+  {
+    U128 base_hash = hs_hash_from_key(key, 0);
+    if(!u128_match(base_hash, u128_zero()) && !u128_match(base_hash, hash))
+    {
+      Temp scratch = scratch_begin(0, 0);
+      HS_Scope *scope = hs_scope_open();
+      U64 start_us = os_now_microseconds();
+      U64 base_size = 0;
+      HS_ChunkArray base_chunks = hs_chunks_from_hash(scratch.arena, scope, base_hash, &base_size);
+      if(base_chunks.count != 0)
+      {
+        U64 chunks_arena_size = AlignPow2(ARENA_HEADER_SIZE + sizeof(HS_Chunk)*(data.size/HS_CHUNK_MIN_SIZE + 1), KB(4));
+        chunks_arena = arena_alloc__sized(chunks_arena_size, chunks_arena_size);
+        chunks = hs_chunks_from_data(chunks_arena, data);
+        diff = hs_diff_from_chunks(base_hash, base_size, base_chunks, chunks);
+        metric_histogram_record(hs_shared->diff_us_histogram, os_now_microseconds()-start_us);
+      }
+      hs_scope_close(scope);
+      scratch_end(scratch);
+    }
+  }
+  
   //- rjf: commit data to cache - if already there, just bump key refcount
+  B32 is_new_cold_candidate = 0;
   ProfScope("commit data to cache - if already there, just bump key refcount") OS_MutexScopeW(stripe->rw_mutex)
   {
     HS_Node *existing_node = 0;
@@ -109,18 +368,45 @@ hs_submit_data(U128 key, Arena **data_arena, String8 data)
       node->hash = hash;
       node->arena = *data_arena;
       node->data = data;
+      node->cold_raw_size = 0;
       node->scope_ref_count = 0;
       node->key_ref_count = 1;
+      node->last_access_gen = ins_atomic_u64_inc_eval(&hs_shared->access_gen);
+      node->cold_rejected_access_gen = 0;
+      node->chunks_arena = chunks_arena;
+      node->chunks = chunks;
+      node->diff = diff;
       DLLPushBack(slot->first, slot->last, node);
+      is_new_cold_candidate = (node->arena != 0 && data.size >= HS_COLD_MIN_SIZE);
+      ins_atomic_u64_add_eval(&hs_shared->resident_bytes, data.size);
+      ins_atomic_u64_inc_eval(&hs_shared->resident_blob_count);
+      if(chunks_arena != 0)
+      {
+        ins_atomic_u64_inc_eval(&hs_shared->diff_count);
+        ins_atomic_u64_add_eval(&hs_shared->diff_kept_bytes, diff.prefix_size + diff.suffix_size);
+      }
     }
     else
     {
       existing_node->key_ref_count += 1;
+      existing_node->last_access_gen = ins_atomic_u64_inc_eval(&hs_shared->access_gen);
       arena_release(*data_arena);
+      if(chunks_arena != 0)
+      {
+        arena_release(chunks_arena);
+      }
     }
     *data_arena = 0;
   }
   
+  //- rjf: wake the evictor if this pushed us over budget, or if this blob
+  // may go cold
+  hs_signal_pressure_if_over_budget();
+  if(is_new_cold_candidate)
+  {
+    hs_signal_cold_work();
+  }
+  
   //- rjf: commit this hash to key cache
   U128 key_expired_hash = {0};
   ProfScope("commit this hash to key cache") OS_MutexScopeW(key_stripe->rw_mutex)
@@ -165,16 +451,27 @@ hs_submit_data(U128 key, Arena **data_arena, String8 data)
       {
         if(u128_match(n->hash, key_expired_hash))
         {
-          ins_atomic_u64_dec_eval(&n->key_ref_count);
+          if(ins_atomic_u64_dec_eval(&n->key_ref_count) == 0 && ins_atomic_u64_eval(&n->scope_ref_count) == 0)
+          {
+            ins_atomic_u64_add_eval(&hs_shared->released_bytes, n->data.size);
+          }
           break;
         }
       }
     }
+    hs_signal_pressure_if_over_budget();
   }
   
   return hash;
 }
 
+internal U128
+hs_submit_data(U128 key, Arena **data_arena, String8 data)
+{
+  U128 hash = hs_hash_from_data(data);
+  return hs_submit_hashed_data(key, hash, data_arena, data);
+}
+
 ////////////////////////////////
 //~ rjf: Scoped Access
 
@@ -212,7 +509,10 @@ hs_scope_close(HS_Scope *scope)
       {
         if(u128_match(hash, n->hash))
         {
-          ins_atomic_u64_dec_eval(&n->scope_ref_count);
+          if(ins_atomic_u64_dec_eval(&n->scope_ref_count) == 0 && ins_atomic_u64_eval(&n->key_ref_count) == 0)
+          {
+            ins_atomic_u64_add_eval(&hs_shared->released_bytes, n->data.size);
+          }
           break;
         }
       }
@@ -220,6 +520,7 @@ hs_scope_close(HS_Scope *scope)
     SLLStackPush(hs_tctx->free_touch, touch);
   }
   SLLStackPush(hs_tctx->free_scope, scope);
+  hs_signal_pressure_if_over_budget();
 }
 
 internal void
@@ -273,18 +574,89 @@ hs_data_from_hash(HS_Scope *scope, U128 hash)
   U64 stripe_idx = slot_idx%hs_shared->stripes_count;
   HS_Slot *slot = &hs_shared->slots[slot_idx];
   HS_Stripe *stripe = &hs_shared->stripes[stripe_idx];
+  Temp scratch = scratch_begin(0, 0);
+  B32 is_cold = 0;
+  String8 cold_data = {0};
+  U64 cold_raw_size = 0;
   OS_MutexScopeR(stripe->rw_mutex)
   {
     for(HS_Node *n = slot->first; n != 0; n = n->next)
     {
       if(u128_match(n->hash, hash))
       {
-        result = n->data;
+        ins_atomic_u64_eval_assign(&n->last_access_gen, ins_atomic_u64_inc_eval(&hs_shared->access_gen));
         hs_scope_touch_node__stripe_r_guarded(scope, n);
+        if(n->cold_raw_size == 0)
+        {
+          result = n->data;
+        }
+        else
+        {
+          is_cold = 1;
+          cold_data = push_str8_copy(scratch.arena, n->data);
+          cold_raw_size = n->cold_raw_size;
+        }
         break;
       }
     }
   }
+  
+  //- rjf: cold blob -> decompress a copy of the compressed bytes outside of
+  // the lock (the node is pinned by the touch above, but a concurrent
+  // decompression may release its compressed bytes), then swap it in - unless
+  // another thread already has, in which case its data is used instead.
+  if(is_cold)
+  {
+    U64 raw_arena_size = AlignPow2(cold_raw_size+ARENA_HEADER_SIZE, KB(4));
+    Arena *raw_arena = arena_alloc__sized(raw_arena_size, raw_arena_size);
+    U8 *raw = push_array_no_zero(raw_arena, U8, cold_raw_size);
+    ProfScope("decompress cold blob")
+    {
+      U64 start_us = os_now_microseconds();
+      rr_lzb_simple_decode(cold_data.str, (SINTa)cold_data.size, raw, (SINTa)cold_raw_size);
+      metric_histogram_record(hs_shared->decompress_us_histogram, os_now_microseconds()-start_us);
+    }
+    B32 swapped = 0;
+    OS_MutexScopeW(stripe->rw_mutex)
+    {
+      for(HS_Node *n = slot->first; n != 0; n = n->next)
+      {
+        if(u128_match(n->hash, hash))
+        {
+          if(n->cold_raw_size != 0)
+          {
+            ins_atomic_u64_add_eval(&hs_shared->resident_bytes, cold_raw_size - n->data.size);
+            ins_atomic_u64_dec_eval(&hs_shared->cold_blob_count);
+            ins_atomic_u64_add_eval(&hs_shared->cold_bytes, -(S64)n->data.size);
+            ins_atomic_u64_add_eval(&hs_shared->cold_raw_bytes, -(S64)cold_raw_size);
+            ins_atomic_u64_inc_eval(&hs_shared->decompression_count);
+            arena_release(n->arena);
+            n->arena = raw_arena;
+            n->data = str8(raw, cold_raw_size);
+            n->cold_raw_size = 0;
+            swapped = 1;
+          }
+          result = n->data;
+          break;
+        }
+      }
+    }
+    if(!swapped)
+    {
+      arena_release(raw_arena);
+    }
+  }
+  scratch_end(scratch);
+  if(is_cold)
+  {
+    hs_signal_pressure_if_over_budget();
+    hs_signal_cold_work();
+  }
+  
+  if(!u128_match(hash, u128_zero()))
+  {
+    ins_atomic_u64_inc_eval(result.size != 0 ? &hs_shared->hit_count : &hs_shared->miss_count);
+  }
   return result;
 }
 
@@ -292,45 +664,368 @@ hs_data_from_hash(HS_Scope *scope, U128 hash)
 //~ rjf: Evictor Thread
 
 internal void
-hs_evictor_thread__entry_point(void *p)
+hs_evict_unreferenced_blobs(void)
 {
-  for(;;)
+  Temp scratch = scratch_begin(0, 0);
+  
+  //- rjf: sample released bytes before gathering - any blob released after
+  // this may have been missed, & must be able to wake the next pass
+  U64 released_bytes = ins_atomic_u64_eval(&hs_shared->released_bytes);
+  
+  //- rjf: gather unreferenced blobs, oldest access first
+  U64 candidates_count = 0;
+  SortKey *candidates = 0;
+  ProfScope("gather eviction candidates")
   {
+    U64 candidates_cap = ins_atomic_u64_eval(&hs_shared->resident_blob_count) + 64;
+    candidates = push_array_no_zero(scratch.arena, SortKey, candidates_cap);
     for(U64 slot_idx = 0; slot_idx < hs_shared->slots_count; slot_idx += 1)
     {
       U64 stripe_idx = slot_idx%hs_shared->stripes_count;
       HS_Slot *slot = &hs_shared->slots[slot_idx];
       HS_Stripe *stripe = &hs_shared->stripes[stripe_idx];
-      B32 slot_has_work = 0;
       OS_MutexScopeR(stripe->rw_mutex)
       {
-        for(HS_Node *n = slot->first; n != 0; n = n->next)
+        for(HS_Node *n = slot->first; n != 0 && candidates_count < candidates_cap; n = n->next)
         {
           U64 key_ref_count = ins_atomic_u64_eval(&n->key_ref_count);
           U64 scope_ref_count = ins_atomic_u64_eval(&n->scope_ref_count);
           if(key_ref_count == 0 && scope_ref_count == 0)
           {
-            slot_has_work = 1;
-            break;
+            U128 *hash = push_array_no_zero(scratch.arena, U128, 1);
+            *hash = n->hash;
+            candidates[candidates_count].key = ins_atomic_u64_eval(&n->last_access_gen);
+            candidates[candidates_count].val = hash;
+            candidates_count += 1;
           }
         }
       }
-      if(slot_has_work) OS_MutexScopeW(stripe->rw_mutex)
+    }
+    candidates = sort_key_array_radix(scratch.arena, candidates, candidates_count);
+  }
+  
+  //- rjf: evict until under the low watermark - skip any blob which has been
+  // referenced or accessed since it was gathered
+  ProfScope("evict") for(U64 candidate_idx = 0; candidate_idx < candidates_count; candidate_idx += 1)
+  {
+    U64 budget_bytes = ins_atomic_u64_eval(&hs_shared->budget_bytes);
+    U64 low_watermark_bytes = budget_bytes - budget_bytes/8;
+    if(ins_atomic_u64_eval(&hs_shared->resident_bytes) <= low_watermark_bytes)
+    {
+      break;
+    }
+    U128 hash = *(U128 *)candidates[candidate_idx].val;
+    U64 slot_idx = hash.u64[1]%hs_shared->slots_count;
+    U64 stripe_idx = slot_idx%hs_shared->stripes_count;
+    HS_Slot *slot = &hs_shared->slots[slot_idx];
+    HS_Stripe *stripe = &hs_shared->stripes[stripe_idx];
+    OS_MutexScopeW(stripe->rw_mutex)
+    {
+      for(HS_Node *n = slot->first; n != 0; n = n->next)
       {
-        for(HS_Node *n = slot->first, *next = 0; n != 0; n = next)
+        if(u128_match(n->hash, hash))
         {
-          next = n->next;
           U64 key_ref_count = ins_atomic_u64_eval(&n->key_ref_count);
           U64 scope_ref_count = ins_atomic_u64_eval(&n->scope_ref_count);
-          if(key_ref_count == 0 && scope_ref_count == 0)
+          U64 last_access_gen = ins_atomic_u64_eval(&n->last_access_gen);
+          if(key_ref_count == 0 && scope_ref_count == 0 && last_access_gen == candidates[candidate_idx].key)
           {
             DLLRemove(slot->first, slot->last, n);
             SLLStackPush(hs_shared->stripes_free_nodes[stripe_idx], n);
+            ins_atomic_u64_add_eval(&hs_shared->resident_bytes, -(S64)n->data.size);
+            ins_atomic_u64_dec_eval(&hs_shared->resident_blob_count);
+            ins_atomic_u64_inc_eval(&hs_shared->eviction_count);
+            ins_atomic_u64_add_eval(&hs_shared->evicted_bytes, n->data.size);
+            if(n->cold_raw_size != 0)
+            {
+              ins_atomic_u64_dec_eval(&hs_shared->cold_blob_count);
+              ins_atomic_u64_add_eval(&hs_shared->cold_bytes, -(S64)n->data.size);
+              ins_atomic_u64_add_eval(&hs_shared->cold_raw_bytes, -(S64)n->cold_raw_size);
+            }
             arena_release(n->arena);
+            if(n->chunks_arena != 0)
+            {
+              arena_release(n->chunks_arena);
+            }
           }
+          break;
+        }
+      }
+    }
+  }
+  
+  //- rjf: still over the low watermark -> nothing more can be freed until
+  // some blob is released; don't take further pressure signals until then
+  {
+    U64 budget_bytes = ins_atomic_u64_eval(&hs_shared->budget_bytes);
+    U64 low_watermark_bytes = budget_bytes - budget_bytes/8;
+    B32 is_exhausted = (ins_atomic_u64_eval(&hs_shared->resident_bytes) > low_watermark_bytes);
+    ins_atomic_u64_eval_assign(&hs_shared->exhausted_released_bytes, released_bytes);
+    ins_atomic_u64_eval_assign(&hs_shared->evict_is_exhausted, is_exhausted);
+  }
+  scratch_end(scratch);
+}
+
+internal U64
+hs_compress_cold_blobs(rr_lzb_simple_context *ctx, U64 cold_access_gen)
+{
+  Temp scratch = scratch_begin(0, 0);
+  U64 min_warm_access_gen = max_U64;
+  
+  //- rjf: gather idle, large, arena-backed blobs which no scope holds. note
+  // the oldest access of any others which may go cold later - skipping blobs
+  // which did not compress well, & have not been accessed since.
+  U64 candidates_count = 0;
+  U128 *candidates = 0;
+  ProfScope("gather cold blobs")
+  {
+    U64 candidates_cap = ins_atomic_u64_eval(&hs_shared->resident_blob_count) + 64;
+    candidates = push_array_no_zero(scratch.arena, U128, candidates_cap);
+    for(U64 slot_idx = 0; slot_idx < hs_shared->slots_count; slot_idx += 1)
+    {
+      U64 stripe_idx = slot_idx%hs_shared->stripes_count;
+      HS_Slot *slot = &hs_shared->slots[slot_idx];
+      HS_Stripe *stripe = &hs_shared->stripes[stripe_idx];
+      OS_MutexScopeR(stripe->rw_mutex)
+      {
+        for(HS_Node *n = slot->first; n != 0 && candidates_count < candidates_cap; n = n->next)
+        {
+          if(n->cold_raw_size == 0 &&
+             n->arena != 0 &&
+             n->data.size >= HS_COLD_MIN_SIZE)
+          {
+            U64 last_access_gen = ins_atomic_u64_eval(&n->last_access_gen);
+            if(last_access_gen == n->cold_rejected_access_gen)
+            {
+              // rjf: incompressible as of its last access
+            }
+            else if(ins_atomic_u64_eval(&n->scope_ref_count) == 0 && last_access_gen <= cold_access_gen)
+            {
+              candidates[candidates_count] = n->hash;
+              candidates_count += 1;
+            }
+            else
+            {
+              min_warm_access_gen = Min(min_warm_access_gen, last_access_gen);
+            }
+          }
+        }
+      }
+    }
+  }
+  
+  //- rjf: compress each blob outside of the lock - pinned by a scope ref, so
+  // it cannot be evicted meanwhile - then swap in the compressed bytes, if
+  // worthwhile, & if nobody has accessed the blob in the meantime
+  for(U64 candidate_idx = 0; candidate_idx < candidates_count; candidate_idx += 1)
+  {
+    U128 hash = candidates[candidate_idx];
+    U64 slot_idx = hash.u64[1]%hs_shared->slots_count;
+    U64 stripe_idx = slot_idx%hs_shared->stripes_count;
+    HS_Slot *slot = &hs_shared->slots[slot_idx];
+    HS_Stripe *stripe = &hs_shared->stripes[stripe_idx];
+    
+    //- rjf: pin
+    String8 raw = {0};
+    U64 pinned_access_gen = 0;
+    OS_MutexScopeR(stripe->rw_mutex)
+    {
+      for(HS_Node *n = slot->first; n != 0; n = n->next)
+      {
+        if(u128_match(n->hash, hash))
+        {
+          if(n->cold_raw_size == 0 && ins_atomic_u64_eval(&n->scope_ref_count) == 0)
+          {
+            ins_atomic_u64_inc_eval(&n->scope_ref_count);
+            raw = n->data;
+            pinned_access_gen = ins_atomic_u64_eval(&n->last_access_gen);
+          }
+          else if(n->cold_raw_size == 0)
+          {
+            min_warm_access_gen = Min(min_warm_access_gen, ins_atomic_u64_eval(&n->last_access_gen));
+          }
+          break;
+        }
+      }
+    }
+    if(raw.size == 0)
+    {
+      continue;
+    }
+    
+    //- rjf: compress
+    Temp temp = temp_begin(scratch.arena);
+    U8 *compressed = push_array_no_zero(temp.arena, U8, raw.size);
+    U64 compressed_size = 0;
+    ProfScope("compress cold blob")
+    {
+      MemoryZero(ctx->m_hashTable, sizeof(U16)*(1<<ctx->m_tableSizeBits));
+      compressed_size = (U64)rr_lzb_simple_encode_veryfast(ctx, raw.str, (SINTa)raw.size, compressed);
+    }
+    B32 is_worthwhile = (compressed_size < raw.size - raw.size/8);
+    
+    //- rjf: unpin & swap
+    OS_MutexScopeW(stripe->rw_mutex)
+    {
+      for(HS_Node *n = slot->first; n != 0; n = n->next)
+      {
+        if(u128_match(n->hash, hash))
+        {
+          U64 scope_ref_count = ins_atomic_u64_dec_eval(&n->scope_ref_count);
+          if(scope_ref_count == 0 && ins_atomic_u64_eval(&n->key_ref_count) == 0)
+          {
+            ins_atomic_u64_add_eval(&hs_shared->released_bytes, n->data.size);
+          }
+          B32 is_untouched = (scope_ref_count == 0 && n->cold_raw_size == 0 && n->data.str == raw.str &&
+                              ins_atomic_u64_eval(&n->last_access_gen) == pinned_access_gen);
+          if(!is_untouched)
+          {
+            if(n->cold_raw_size == 0)
+            {
+              min_warm_access_gen = Min(min_warm_access_gen, ins_atomic_u64_eval(&n->last_access_gen));
+            }
+          }
+          else if(!is_worthwhile)
+          {
+            n->cold_rejected_access_gen = pinned_access_gen;
+          }
+          else
+          {
+            U64 cold_arena_size = AlignPow2(compressed_size+ARENA_HEADER_SIZE, KB(4));
+            Arena *cold_arena = arena_alloc__sized(cold_arena_size, cold_arena_size);
+            U8 *cold_data = push_array_no_zero(cold_arena, U8, compressed_size);
+            MemoryCopy(cold_data, compressed, compressed_size);
+            arena_release(n->arena);
+            n->arena = cold_arena;
+            n->data = str8(cold_data, compressed_size);
+            n->cold_raw_size = raw.size;
+            ins_atomic_u64_add_eval(&hs_shared->resident_bytes, -(S64)(raw.size - compressed_size));
+            ins_atomic_u64_inc_eval(&hs_shared->cold_blob_count);
+            ins_atomic_u64_add_eval(&hs_shared->cold_bytes, compressed_size);
+            ins_atomic_u64_add_eval(&hs_shared->cold_raw_bytes, raw.size);
+            ins_atomic_u64_inc_eval(&hs_shared->compression_count);
+          }
+          break;
+        }
+      }
+    }
+    temp_end(temp);
+  }
+  
+  scratch_end(scratch);
+  return min_warm_access_gen;
+}
+
+internal void
+hs_evictor_thread__entry_point(void *p)
+{
+  ThreadNameF("[hs] evictor");
+  Arena *arena = arena_alloc();
+  rr_lzb_simple_context lzb_ctx = {0};
+  lzb_ctx.m_tableSizeBits = 14;
+  lzb_ctx.m_hashTable = push_array(arena, U16, 1<<lzb_ctx.m_tableSizeBits);
+  U64 last_pressure_gen = 0;
+  U64 last_cold_work_gen = 0;
+  B32 cold_is_idle = 0;
+  U64 next_cold_pass_us = os_now_microseconds() + HS_COLD_PASS_INTERVAL_US;
+  U64 sample_count = 0;
+  U64 sample_times_us[HS_COLD_SAMPLE_COUNT] = {0};
+  U64 sample_access_gens[HS_COLD_SAMPLE_COUNT] = {0};
+  for(;;)
+  {
+    //- rjf: wait for new budget pressure, or for the next cold pass - if no
+    // blob can go cold, only new cold work resumes cold passes
+    B32 got_pressure = 0;
+    OS_MutexScope(hs_shared->evictor_mutex) for(;;)
+    {
+      if(hs_shared->cold_work_gen != last_cold_work_gen)
+      {
+        last_cold_work_gen = hs_shared->cold_work_gen;
+        cold_is_idle = 0;
+        next_cold_pass_us = Min(next_cold_pass_us, os_now_microseconds() + HS_COLD_PASS_INTERVAL_US);
+      }
+      if(hs_shared->pressure_gen != last_pressure_gen)
+      {
+        last_pressure_gen = hs_shared->pressure_gen;
+        got_pressure = 1;
+        break;
+      }
+      U64 wait_endt_us = cold_is_idle ? max_U64 : next_cold_pass_us;
+      if(os_now_microseconds() >= wait_endt_us)
+      {
+        break;
+      }
+      os_condition_variable_wait(hs_shared->evictor_cv, hs_shared->evictor_mutex, wait_endt_us);
+    }
+    
+    //- rjf: evict
+    if(got_pressure)
+    {
+      hs_evict_unreferenced_blobs();
+    }
+    
+    //- rjf: cold pass - access gens are sampled over time, so that the gen as
+    // of `cold_threshold_us` ago can be found without timestamping accesses
+    U64 now_us = os_now_microseconds();
+    if(!cold_is_idle && now_us >= next_cold_pass_us)
+    {
+      U64 cold_threshold_us = ins_atomic_u64_eval(&hs_shared->cold_threshold_us);
+      U64 sample_interval_us = Max(HS_COLD_PASS_INTERVAL_US, cold_threshold_us/(HS_COLD_SAMPLE_COUNT/2));
+      U64 cold_access_gen = 0;
+      for(U64 idx = 0; idx < Min(sample_count, HS_COLD_SAMPLE_COUNT); idx += 1)
+      {
+        U64 sample_idx = (sample_count-1-idx)%HS_COLD_SAMPLE_COUNT;
+        if(now_us - sample_times_us[sample_idx] >= cold_threshold_us)
+        {
+          cold_access_gen = sample_access_gens[sample_idx];
+          break;
+        }
+      }
+      U64 min_warm_access_gen = hs_compress_cold_blobs(&lzb_ctx, cold_access_gen);
+      
+      //- rjf: no blob may go cold -> sleep until new cold work
+      if(min_warm_access_gen == max_U64)
+      {
+        cold_is_idle = 1;
+      }
+      
+      //- rjf: otherwise, sleep until the least recently accessed warm blob
+      // goes cold - once the first sample taken after its last access is
+      // `cold_threshold_us` old. samples are only taken when such a blob
+      // needs one, & at most once per sample interval - otherwise, the next
+      // pass is just to take it.
+      else
+      {
+        now_us = os_now_microseconds();
+        U64 last_sample_idx = (sample_count-1)%HS_COLD_SAMPLE_COUNT;
+        B32 is_sampled = (sample_count != 0 && sample_access_gens[last_sample_idx] >= min_warm_access_gen);
+        if(!is_sampled && (sample_count == 0 || sample_times_us[last_sample_idx] + sample_interval_us <= now_us))
+        {
+          sample_times_us[sample_count%HS_COLD_SAMPLE_COUNT] = now_us;
+          sample_access_gens[sample_count%HS_COLD_SAMPLE_COUNT] = ins_atomic_u64_eval(&hs_shared->access_gen);
+          sample_count += 1;
+          is_sampled = 1;
+        }
+        U64 next_work_us = 0;
+        if(is_sampled)
+        {
+          U64 samples_count = Min(sample_count, HS_COLD_SAMPLE_COUNT);
+          for(U64 idx = 0; idx < samples_count; idx += 1)
+          {
+            U64 sample_idx = (sample_count-samples_count+idx)%HS_COLD_SAMPLE_COUNT;
+            if(sample_access_gens[sample_idx] >= min_warm_access_gen)
+            {
+              next_work_us = sample_times_us[sample_idx] + cold_threshold_us;
+              break;
+            }
+          }
+        }
+        else
+        {
+          next_work_us = sample_times_us[last_sample_idx] + sample_interval_us;
         }
+        next_cold_pass_us = Max(next_work_us, now_us + HS_COLD_PASS_INTERVAL_US);
       }
     }
-    os_sleep_milliseconds(1000);
   }
 }
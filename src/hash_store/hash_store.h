@@ -23,6 +23,29 @@ struct HS_KeySlot
   HS_KeyNode *last;
 };
 
+typedef struct HS_Chunk HS_Chunk;
+struct HS_Chunk
+{
+  U64 size;
+  U64 hash;
+};
+
+typedef struct HS_ChunkArray HS_ChunkArray;
+struct HS_ChunkArray
+{
+  HS_Chunk *v;
+  U64 count;
+};
+
+typedef struct HS_Diff HS_Diff;
+struct HS_Diff
+{
+  U128 base_hash;
+  U64 base_size;
+  U64 prefix_size;
+  U64 suffix_size;
+};
+
 typedef struct HS_Node HS_Node;
 struct HS_Node
 {
@@ -31,8 +54,14 @@ struct HS_Node
   U128 hash;
   Arena *arena;
   String8 data;
+  U64 cold_raw_size;
   U64 scope_ref_count;
   U64 key_ref_count;
+  U64 last_access_gen;
+  U64 cold_rejected_access_gen;
+  Arena *chunks_arena;
+  HS_ChunkArray chunks;
+  HS_Diff diff;
 };
 
 typedef struct HS_Slot HS_Slot;
@@ -78,6 +107,43 @@ struct HS_TCTX
   HS_Touch *free_touch;
 };
 
+////////////////////////////////
+//~ rjf: Eviction Statistics
+
+typedef struct HS_Stats HS_Stats;
+struct HS_Stats
+{
+  U64 budget_bytes;
+  U64 resident_bytes;
+  U64 resident_blob_count;
+  U64 hit_count;
+  U64 miss_count;
+  U64 eviction_count;
+  U64 evicted_bytes;
+  U64 cold_blob_count;
+  U64 cold_bytes;
+  U64 cold_raw_bytes;
+  U64 compression_count;
+  U64 decompression_count;
+  U64 diff_count;
+  U64 diff_kept_bytes;
+};
+
+////////////////////////////////
+//~ rjf: Cold Tier Constants
+
+#define HS_COLD_MIN_SIZE          MB(1)
+#define HS_COLD_PASS_INTERVAL_US  1000000
+#define HS_COLD_SAMPLE_COUNT      128
+
+////////////////////////////////
+//~ rjf: Chunking Constants
+
+#define HS_CHUNKED_MIN_SIZE       KB(64)
+#define HS_CHUNK_MIN_SIZE         KB(4)
+#define HS_CHUNK_MAX_SIZE         KB(64)
+#define HS_CHUNK_BOUNDARY_BITS    14
+
 ////////////////////////////////
 //~ rjf: Shared State
 
@@ -99,7 +165,41 @@ struct HS_Shared
   HS_KeySlot *key_slots;
   HS_Stripe *key_stripes;
   
+  // rjf: budget & stats
+  U64 budget_bytes;
+  U64 resident_bytes;
+  U64 resident_blob_count;
+  U64 access_gen;
+  U64 hit_count;
+  U64 miss_count;
+  U64 eviction_count;
+  U64 evicted_bytes;
+  
+  // rjf: cold tier
+  U64 cold_threshold_us;
+  U64 cold_blob_count;
+  U64 cold_bytes;
+  U64 cold_raw_bytes;
+  U64 compression_count;
+  U64 decompression_count;
+  
+  // rjf: chunking
+  U64 chunk_gear[256];
+  U64 diff_count;
+  U64 diff_kept_bytes;
+  
+  // rjf: latency metrics
+  MetricHistogram *decompress_us_histogram;
+  MetricHistogram *diff_us_histogram;
+  
   // rjf: evictor thread
+  U64 released_bytes;
+  U64 exhausted_released_bytes;
+  U64 evict_is_exhausted;
+  U64 pressure_gen;
+  U64 cold_work_gen;
+  OS_Handle evictor_mutex;
+  OS_Handle evictor_cv;
   OS_Handle evictor_thread;
 };
 
@@ -119,6 +219,60 @@ internal U128 hs_hash_from_data(String8 data);
 
 internal void hs_init(void);
 
+////////////////////////////////
+//~ rjf: Budget & Stats
+//
+// Blobs with no key & no scope references are not freed immediately - they
+// are kept (and may be found again by hash) until the bytes resident in the
+// store exceed the budget. Then, the evictor frees unreferenced blobs, least
+// recently submitted or accessed first, until the store is back under the
+// low watermark. Referenced blobs count towards the budget, but are never
+// evicted. If a pass runs out of unreferenced blobs before reaching the low
+// watermark, the evictor is not woken again until some blob loses its last
+// reference (or the budget changes), since another pass could free nothing.
+
+internal void hs_set_budget(U64 budget_bytes);
+internal HS_Stats hs_stats(void);
+internal void hs_signal_pressure_if_over_budget(void);
+
+////////////////////////////////
+//~ rjf: Cold Tier
+//
+// Large arena-backed blobs which have not been accessed for the cold
+// threshold are LZ-compressed in the background by the evictor thread -
+// whether or not they are still referenced by keys - as long as no scope
+// currently holds them. Cold blobs are decompressed in place upon their next
+// `hs_data_from_hash`, so callers never observe compressed data. Resident
+// byte counts reflect the compressed size of cold blobs.
+//
+// Cold passes are not run on a timer. After each pass, the evictor sleeps
+// until the least recently accessed blob which may still go cold reaches the
+// cold threshold - access times are only known to within a threshold, so
+// blobs go cold between one & two thresholds after their last access. Once
+// none can, it sleeps until a large blob is submitted or decompressed. Blobs
+// which do not compress well are not retried until accessed again.
+
+internal void hs_set_cold_threshold(U64 idle_us);
+internal void hs_signal_cold_work(void);
+
+////////////////////////////////
+//~ rjf: Content-Defined Chunking & Diffs
+//
+// When a large blob is submitted to a key which already refers to an older
+// version, both versions are split into content-defined chunks - boundaries
+// are picked by a rolling hash of the preceding 64 bytes, so an edit only
+// moves the boundaries of the chunks it touches - & the chunk hashes are
+// compared from either end. The sizes of the unchanged prefix & suffix are
+// stored with the new blob as its diff, so that derived data (e.g. text
+// cache line & token info) need only be rebuilt for the changed middle.
+// Chunk hashes are kept with the blob, so the next version of the key only
+// needs to chunk its own data.
+
+internal HS_ChunkArray hs_chunks_from_data(Arena *arena, String8 data);
+internal HS_Diff hs_diff_from_chunks(U128 base_hash, U64 base_size, HS_ChunkArray base_chunks, HS_ChunkArray chunks);
+internal HS_ChunkArray hs_chunks_from_hash(Arena *arena, HS_Scope *scope, U128 hash, U64 *size_out);
+internal HS_Diff hs_diff_from_hash(U128 hash);
+
 ////////////////////////////////
 //~ rjf: Thread Context Initialization
 
@@ -127,6 +281,10 @@ internal void hs_tctx_ensure_inited(void);
 ////////////////////////////////
 //~ rjf: Cache Submission/Derefs
 
+// NOTE(rjf): submitted data, & its arena, are owned by the store from then on.
+// the `_hashed_` path is for callers which already have
+// `hs_hash_from_data(data)`.
+internal U128 hs_submit_hashed_data(U128 key, U128 hash, Arena **data_arena, String8 data);
 internal U128 hs_submit_data(U128 key, Arena **data_arena, String8 data);
 
 ////////////////////////////////
@@ -145,6 +303,8 @@ internal String8 hs_data_from_hash(HS_Scope *scope, U128 hash);
 ////////////////////////////////
 //~ rjf: Evictor Thread
 
+internal void hs_evict_unreferenced_blobs(void);
+internal U64 hs_compress_cold_blobs(rr_lzb_simple_context *ctx, U64 cold_access_gen);
 internal void hs_evictor_thread__entry_point(void *p);
 
 #endif // HASH_STORE_H
@@ -263,7 +263,7 @@ rdim_str8_list_join(RDIM_Arena *arena, RDIM_String8List *list, RDIM_String8 sep)
 //- rjf: sortable range sorting
 
 RDI_PROC RDIM_SortKey *
-rdim_sort_key_array(RDIM_Arena *arena, RDIM_SortKey *keys, RDI_U64 count)
+rdim_sort_key_array_fallback(RDIM_Arena *arena, RDIM_SortKey *keys, RDI_U64 count)
 {
   // This sort is designed to take advantage of lots of pre-existing sorted ranges.
   // Most line info is already sorted or close to already sorted.
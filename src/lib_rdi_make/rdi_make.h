@@ -206,6 +206,21 @@ struct RDIM_Temp
 
 #define RDIM_ProfScope(...) for(int _i_ = ((RDIM_ProfBegin(__VA_ARGS__)), 0); !_i_; _i_ += 1, (RDIM_ProfEnd()))
 
+////////////////////////////////
+//~ rjf: Overrideable Sort Key Array Sorting
+
+// To override the default sort used for RDIM_SortKey arrays (vmap markers &
+// line tables) - a single-threaded merge sort over pre-sorted runs - do the
+// following:
+//
+// #define rdim_sort_key_array <name of sort implementation - must be stable, and (RDIM_Arena *arena, RDIM_SortKey *keys, RDI_U64 count) -> RDIM_SortKey *>
+//
+// The default implementation remains available as rdim_sort_key_array_fallback.
+
+#if !defined(rdim_sort_key_array)
+# define rdim_sort_key_array rdim_sort_key_array_fallback
+#endif
+
 ////////////////////////////////
 //~ rjf: Linked List Helper Macros
 
@@ -1038,7 +1053,7 @@ RDI_PROC void rdim_str8_list_push_align(RDIM_Arena *arena, RDIM_String8List *lis
 RDI_PROC RDIM_String8 rdim_str8_list_join(RDIM_Arena *arena, RDIM_String8List *list, RDIM_String8 sep);
 
 //- rjf: sortable range sorting
-RDI_PROC RDIM_SortKey *rdim_sort_key_array(RDIM_Arena *arena, RDIM_SortKey *keys, RDI_U64 count);
+RDI_PROC RDIM_SortKey *rdim_sort_key_array_fallback(RDIM_Arena *arena, RDIM_SortKey *keys, RDI_U64 count);
 
 //- rjf: rng1u64 list
 RDI_PROC void rdim_rng1u64_list_push(RDIM_Arena *arena, RDIM_Rng1U64List *list, RDIM_Rng1U64 r);
@@ -168,7 +168,7 @@ mg_escaped_from_str8(Arena *arena, String8 string)
       }
       String8 replace_string = push_str8_copy(scratch.arena, str8(&replace_byte, 1));
       str8_list_push(scratch.arena, &strs, replace_string);
-      if(replace_byte == '\\' || replace_byte == '"' || replace_byte == '\'')
+      if(replace_byte != 0)
       {
         idx += 1;
         start += 1;
@@ -306,6 +306,120 @@ mg_c_array_literal_contents_from_data(String8 data)
   return result;
 }
 
+////////////////////////////////
+//~ rjf: Perfect Hashing
+
+internal U64
+mg_perfect_hash_from_seed_string(U64 seed, String8 string)
+{
+  // NOTE(rjf): @perfect_hash_set emits this same function into the generated
+  // lookup, so the two must be kept in sync.
+  U64 hash = seed;
+  for(U64 idx = 0; idx < string.size; idx += 1)
+  {
+    hash = (hash ^ string.str[idx]) * 0x100000001b3ull;
+  }
+  hash *= 0x9e3779b97f4a7c15ull;
+  return hash;
+}
+
+internal MG_PerfectHash
+mg_perfect_hash_from_string_array(Arena *arena, String8Array strings)
+{
+  Temp scratch = scratch_begin(&arena, 1);
+  MG_PerfectHash result = {0};
+  result.string_size_min = max_U64;
+  for(U64 idx = 0; idx < strings.count; idx += 1)
+  {
+    result.string_size_min = Min(result.string_size_min, strings.strings[idx].size);
+    result.string_size_max = Max(result.string_size_max, strings.strings[idx].size);
+  }
+  
+  //- rjf: try seeds at increasing table sizes, starting from a load factor of
+  // 1/2, until every string lands in its own slot
+  B32 found = 0;
+  for(result.slots_count_log2 = 1;
+      ((U64)1 << result.slots_count_log2) < strings.count*2;
+      result.slots_count_log2 += 1);
+  for(;result.slots_count_log2 < 32; result.slots_count_log2 += 1)
+  {
+    U64 slots_count = (U64)1 << result.slots_count_log2;
+    U64 shift = 64 - result.slots_count_log2;
+    B8 *slots_taken = push_array(scratch.arena, B8, slots_count);
+    for(U64 seed = 0; !found && seed < MG_PERFECT_HASH_SEED_TRY_COUNT; seed += 1)
+    {
+      MemoryZero(slots_taken, slots_count);
+      B32 collision = 0;
+      for(U64 idx = 0; idx < strings.count && !collision; idx += 1)
+      {
+        U64 slot_idx = mg_perfect_hash_from_seed_string(seed, strings.strings[idx]) >> shift;
+        collision = slots_taken[slot_idx];
+        slots_taken[slot_idx] = 1;
+      }
+      if(!collision)
+      {
+        found = 1;
+        result.seed = seed;
+        result.slots = push_array(arena, String8, slots_count);
+        for(U64 idx = 0; idx < strings.count; idx += 1)
+        {
+          U64 slot_idx = mg_perfect_hash_from_seed_string(seed, strings.strings[idx]) >> shift;
+          result.slots[slot_idx] = strings.strings[idx];
+        }
+      }
+    }
+    if(found)
+    {
+      break;
+    }
+  }
+  scratch_end(scratch);
+  return result;
+}
+
+////////////////////////////////
+//~ rjf: Byte Class Tables
+
+internal String8Array
+mg_byte_class_flags_array_from_node(Arena *arena, MD_Node *node)
+{
+  Temp scratch = scratch_begin(&arena, 1);
+  
+  //- rjf: gather flag names for each byte, from each class's strings of
+  // member bytes, or @range strings of inclusive first/last bytes
+  String8List byte_flags[256] = {0};
+  for(MD_EachNode(class_node, node->first))
+  {
+    for(MD_EachNode(bytes_node, class_node->first))
+    {
+      String8 bytes = mg_escaped_from_str8(scratch.arena, bytes_node->string);
+      if(md_node_has_tag(bytes_node, str8_lit("range"), 0) && bytes.size == 2)
+      {
+        for(U64 byte = bytes.str[0]; byte <= bytes.str[1]; byte += 1)
+        {
+          str8_list_push(scratch.arena, &byte_flags[byte], class_node->string);
+        }
+      }
+      else for(U64 idx = 0; idx < bytes.size; idx += 1)
+      {
+        str8_list_push(scratch.arena, &byte_flags[bytes.str[idx]], class_node->string);
+      }
+    }
+  }
+  
+  //- rjf: join flag names per byte
+  String8Array result = str8_array_reserve(arena, 256);
+  StringJoin join = {0};
+  join.sep = str8_lit("|");
+  for(U64 byte = 0; byte < 256; byte += 1)
+  {
+    result.strings[byte] = (byte_flags[byte].node_count != 0) ? str8_list_join(arena, &byte_flags[byte], &join) : str8_lit("0");
+  }
+  result.count = 256;
+  scratch_end(scratch);
+  return result;
+}
+
 ////////////////////////////////
 //~ rjf: Map Functions
 
@@ -205,6 +205,21 @@ struct MG_TableExpandInfo
   String8 missing_value_fallback;
 };
 
+////////////////////////////////
+//~ rjf: Perfect Hash Types
+
+#define MG_PERFECT_HASH_SEED_TRY_COUNT 65536
+
+typedef struct MG_PerfectHash MG_PerfectHash;
+struct MG_PerfectHash
+{
+  U64 seed;
+  U64 slots_count_log2;
+  String8 *slots;
+  U64 string_size_min;
+  U64 string_size_max;
+};
+
 ////////////////////////////////
 //~ rjf: Main Output Path Types
 
@@ -277,6 +292,17 @@ internal String8List mg_wrapped_lines_from_string(Arena *arena, String8 string,
 internal String8 mg_c_string_literal_from_multiline_string(String8 string);
 internal String8 mg_c_array_literal_contents_from_data(String8 data);
 
+////////////////////////////////
+//~ rjf: Perfect Hashing
+
+internal U64 mg_perfect_hash_from_seed_string(U64 seed, String8 string);
+internal MG_PerfectHash mg_perfect_hash_from_string_array(Arena *arena, String8Array strings);
+
+////////////////////////////////
+//~ rjf: Byte Class Tables
+
+internal String8Array mg_byte_class_flags_array_from_node(Arena *arena, MD_Node *node);
+
 ////////////////////////////////
 //~ rjf: Map Functions
 
@@ -278,6 +278,89 @@ int main(int argument_count, char **arguments)
     }
   }
   
+  //////////////////////////////
+  //- rjf: generate perfect hash sets
+  //
+  for(MG_FileParseNode *n = parses.first; n != 0; n = n->next)
+  {
+    MD_Node *file = n->v.root;
+    for(MD_EachNode(node, file->first))
+    {
+      if(md_node_has_tag(node, str8_lit("perfect_hash_set"), 0))
+      {
+        String8 layer_key = mg_layer_key_from_path(file->string);
+        MG_Layer *layer = mg_layer_from_key(layer_key);
+        String8List strings = {0};
+        for(MD_EachNode(child, node->first))
+        {
+          str8_list_push(mg_arena, &strings, child->string);
+        }
+        String8Array strings_array = str8_array_from_list(mg_arena, &strings);
+        MG_PerfectHash hash = mg_perfect_hash_from_string_array(mg_arena, strings_array);
+        if(hash.slots == 0)
+        {
+          MG_Msg msg = {file->string, str8_lit("error"), push_str8f(mg_arena, "no perfect hash found for %S", node->string)};
+          mg_msg_list_push(mg_arena, &msgs, &msg);
+          continue;
+        }
+        U64 slots_count = (U64)1 << hash.slots_count_log2;
+        str8_list_pushf(mg_arena, &layer->h_tables, "extern String8 %S[%I64u];\n", node->string, slots_count);
+        str8_list_pushf(mg_arena, &layer->c_tables, "String8 %S[%I64u] =\n{\n", node->string, slots_count);
+        for(U64 slot_idx = 0; slot_idx < slots_count; slot_idx += 1)
+        {
+          if(hash.slots[slot_idx].size != 0)
+          {
+            str8_list_pushf(mg_arena, &layer->c_tables, "str8_lit_comp(\"%S\"),\n", hash.slots[slot_idx]);
+          }
+          else
+          {
+            str8_list_pushf(mg_arena, &layer->c_tables, "{0},\n");
+          }
+        }
+        str8_list_push(mg_arena, &layer->c_tables, str8_lit("};\n\n"));
+        str8_list_pushf(mg_arena, &layer->h_functions, "internal B32 %S_contains(String8 string);\n", node->string);
+        str8_list_pushf(mg_arena, &layer->c_functions, "internal B32\n%S_contains(String8 string)\n{\n", node->string);
+        str8_list_pushf(mg_arena, &layer->c_functions, "B32 result = 0;\n");
+        str8_list_pushf(mg_arena, &layer->c_functions, "if(%I64u <= string.size && string.size <= %I64u)\n{\n", hash.string_size_min, hash.string_size_max);
+        str8_list_pushf(mg_arena, &layer->c_functions, "U64 hash = 0x%I64xull;\n", hash.seed);
+        str8_list_pushf(mg_arena, &layer->c_functions, "for(U64 idx = 0; idx < string.size; idx += 1)\n{\n");
+        str8_list_pushf(mg_arena, &layer->c_functions, "hash = (hash ^ string.str[idx]) * 0x100000001b3ull;\n");
+        str8_list_pushf(mg_arena, &layer->c_functions, "}\n");
+        str8_list_pushf(mg_arena, &layer->c_functions, "hash *= 0x9e3779b97f4a7c15ull;\n");
+        str8_list_pushf(mg_arena, &layer->c_functions, "result = str8_match(%S[hash >> %I64u], string, 0);\n", node->string, 64 - hash.slots_count_log2);
+        str8_list_pushf(mg_arena, &layer->c_functions, "}\n");
+        str8_list_pushf(mg_arena, &layer->c_functions, "return result;\n");
+        str8_list_pushf(mg_arena, &layer->c_functions, "}\n\n");
+      }
+    }
+  }
+  
+  //////////////////////////////
+  //- rjf: generate byte class tables
+  //
+  for(MG_FileParseNode *n = parses.first; n != 0; n = n->next)
+  {
+    MD_Node *file = n->v.root;
+    for(MD_EachNode(node, file->first))
+    {
+      MD_Node *tag = md_tag_from_string(node, str8_lit("byte_class_table"), 0);
+      if(!md_node_is_nil(tag))
+      {
+        String8 element_type = tag->first->string;
+        String8 layer_key = mg_layer_key_from_path(file->string);
+        MG_Layer *layer = mg_layer_from_key(layer_key);
+        String8Array byte_flags = mg_byte_class_flags_array_from_node(mg_arena, node);
+        str8_list_pushf(mg_arena, &layer->h_tables, "extern %S %S[%I64u];\n", element_type, node->string, byte_flags.count);
+        str8_list_pushf(mg_arena, &layer->c_tables, "%S %S[%I64u] =\n{\n", element_type, node->string, byte_flags.count);
+        for(U64 byte = 0; byte < byte_flags.count; byte += 1)
+        {
+          str8_list_pushf(mg_arena, &layer->c_tables, "%S,\n", byte_flags.strings[byte]);
+        }
+        str8_list_push(mg_arena, &layer->c_tables, str8_lit("};\n\n"));
+      }
+    }
+  }
+  
   //////////////////////////////
   //- rjf: generate catch-all generations
   //
@@ -104,6 +104,11 @@ update_and_render(OS_Handle repaint_window_handle, void *user_data)
   //
   U64 begin_time_us = os_now_microseconds();
   
+  //////////////////////////////
+  //- rjf: cache requests made while building this frame are due by its end
+  //
+  ce_set_request_deadline(begin_time_us + (U64)(dt*1000000.f));
+  
   //////////////////////////////
   //- rjf: bind change
   //
@@ -38,6 +38,8 @@
 #include "mdesk/mdesk.h"
 #include "hash_store/hash_store.h"
 #include "file_stream/file_stream.h"
+#include "artifact_cache/artifact_cache.h"
+#include "cache_engine/cache_engine.h"
 #include "text_cache/text_cache.h"
 #include "path/path.h"
 #include "txti/txti.h"
@@ -77,6 +79,8 @@
 #include "mdesk/mdesk.c"
 #include "hash_store/hash_store.c"
 #include "file_stream/file_stream.c"
+#include "artifact_cache/artifact_cache.c"
+#include "cache_engine/cache_engine.c"
 #include "text_cache/text_cache.c"
 #include "path/path.c"
 #include "txti/txti.c"
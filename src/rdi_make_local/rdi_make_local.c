@@ -2,3 +2,36 @@
 // Licensed under the MIT license (https://opensource.org/license/mit/)
 
 #include "lib_rdi_make/rdi_make.c"
+
+StaticAssert(sizeof(RDIM_SortKey) == sizeof(SortKey), rdim_sort_key_size_check);
+
+internal RDIM_SortKey *
+rdim_local_sort_key_array(Arena *arena, RDIM_SortKey *keys, U64 count)
+{
+  RDIM_SortKey *result = keys;
+  
+  // rjf: count pre-sorted runs, up to a limit - most line info & many vmaps
+  // are already (nearly) sorted, and the library's run-merging sort finishes
+  // those in a pass or two, which beats even a skipped-digit radix sort
+  U64 max_merged_run_count = 16;
+  U64 run_count = 1;
+  for(U64 idx = 1; idx < count && run_count <= max_merged_run_count; idx += 1)
+  {
+    run_count += (keys[idx-1].key > keys[idx].key);
+  }
+  
+  // rjf: few runs or small arrays -> merge; otherwise -> (parallel) radix
+  if(run_count <= max_merged_run_count || count < 4096)
+  {
+    result = rdim_sort_key_array_fallback(arena, keys, count);
+  }
+  else
+  {
+#if defined(TASK_SYSTEM_H)
+    result = (RDIM_SortKey *)ts_sort_key_array_radix(arena, (SortKey *)keys, count);
+#else
+    result = (RDIM_SortKey *)sort_key_array_radix(arena, (SortKey *)keys, count);
+#endif
+  }
+  return result;
+}
@@ -45,6 +45,11 @@
 #define RDIM_ProfBegin(...) ProfBeginDynamic(__VA_ARGS__)
 #define RDIM_ProfEnd(...) ProfEnd()
 
+// rjf: sort key array sorting override
+#define rdim_sort_key_array rdim_local_sort_key_array
+
 #include "lib_rdi_make/rdi_make.h"
 
+internal RDIM_SortKey *rdim_local_sort_key_array(Arena *arena, RDIM_SortKey *keys, U64 count);
+
 #endif // RDI_CONS_LOCAL_H
@@ -0,0 +1,122 @@
+// Copyright (c) 2024 Epic Games Tools
+// Licensed under the MIT license (https://opensource.org/license/mit/)
+
+////////////////////////////////
+//~ rjf: Build Options
+
+#define BUILD_VERSION_MAJOR 0
+#define BUILD_VERSION_MINOR 9
+#define BUILD_VERSION_PATCH 10
+#define BUILD_RELEASE_PHASE_STRING_LITERAL "ALPHA"
+#define BUILD_TITLE "hash_bench"
+#define BUILD_CONSOLE_INTERFACE 1
+
+////////////////////////////////
+//~ rjf: Includes
+
+//- rjf: [lib]
+#include "third_party/rad_lzb_simple/rad_lzb_simple.h"
+#include "third_party/rad_lzb_simple/rad_lzb_simple.c"
+
+//- rjf: [h]
+#include "base/base_inc.h"
+#include "os/os_inc.h"
+#include "hash_store/hash_store.h"
+
+//- rjf: [c]
+#include "base/base_inc.c"
+#include "os/os_inc.c"
+#include "hash_store/hash_store.c"
+
+//- rjf: [third party] reference hash, for comparison
+#if !defined(BLAKE2_H)
+#define HAVE_SSE2
+#include "third_party/blake2/blake2.h"
+#include "third_party/blake2/blake2b.c"
+#endif
+
+////////////////////////////////
+//~ rjf: Benchmarked Hash Functions
+
+typedef U128 HashBenchFunction(String8 data);
+
+internal U128
+hash_bench_blake2b(String8 data)
+{
+  U128 u128 = {0};
+  blake2b((U8 *)&u128.u64[0], sizeof(u128), data.str, data.size, 0, 0);
+  return u128;
+}
+
+internal U128
+hash_bench_hs(String8 data)
+{
+  return hs_hash_from_data(data);
+}
+
+////////////////////////////////
+//~ rjf: Entry Point
+
+internal void
+entry_point(CmdLine *cmd_line)
+{
+  Arena *arena = arena_alloc();
+
+  //- rjf: unpack parameters
+  U64 size_mb = 512;
+  U64 iteration_count = 4;
+  {
+    String8 size_string = cmd_line_string(cmd_line, str8_lit("size_mb"));
+    String8 iterations_string = cmd_line_string(cmd_line, str8_lit("iterations"));
+    if(size_string.size != 0)       { size_mb = u64_from_str8(size_string, 10); }
+    if(iterations_string.size != 0) { iteration_count = u64_from_str8(iterations_string, 10); }
+    size_mb = Max(size_mb, 1);
+    iteration_count = Max(iteration_count, 1);
+  }
+
+  //- rjf: generate deterministic input (xorshift64)
+  String8 data = {0};
+  {
+    data.size = MB(size_mb);
+    data.str = push_array_no_zero(arena, U8, data.size);
+    U64 state = 0x9e3779b97f4a7c15ull;
+    U64 *words = (U64 *)data.str;
+    for(U64 idx = 0; idx < data.size/sizeof(U64); idx += 1)
+    {
+      state ^= state << 13;
+      state ^= state >> 7;
+      state ^= state << 17;
+      words[idx] = state;
+    }
+  }
+
+  //- rjf: run benchmarks
+  struct
+  {
+    String8 name;
+    HashBenchFunction *function;
+  }
+  benches[] =
+  {
+    {str8_lit_comp("blake2b-128"),       hash_bench_blake2b},
+    {str8_lit_comp("hs_hash_from_data"), hash_bench_hs},
+  };
+  fprintf(stdout, "hashing %I64u MB x %I64u iterations\n", size_mb, iteration_count);
+  for(U64 bench_idx = 0; bench_idx < ArrayCount(benches); bench_idx += 1)
+  {
+    U128 hash = {0};
+    U64 best_us = max_U64;
+    for(U64 iteration_idx = 0; iteration_idx < iteration_count; iteration_idx += 1)
+    {
+      U64 begin_us = os_now_microseconds();
+      hash = benches[bench_idx].function(data);
+      U64 end_us = os_now_microseconds();
+      best_us = Min(best_us, Max(end_us-begin_us, 1));
+    }
+    F64 gb_per_s = ((F64)data.size / (F64)GB(1)) / ((F64)best_us / 1000000.0);
+    fprintf(stdout, "%-20.*s %10.3f GB/s  (best %I64u us, hash %016I64x%016I64x)\n",
+            str8_varg(benches[bench_idx].name), gb_per_s, best_us, hash.u64[1], hash.u64[0]);
+  }
+
+  arena_release(arena);
+}
@@ -0,0 +1,250 @@
+// Copyright (c) 2024 Epic Games Tools
+// Licensed under the MIT license (https://opensource.org/license/mit/)
+
+////////////////////////////////
+//~ rjf: Build Options
+
+#define BUILD_VERSION_MAJOR 0
+#define BUILD_VERSION_MINOR 9
+#define BUILD_VERSION_PATCH 10
+#define BUILD_RELEASE_PHASE_STRING_LITERAL "ALPHA"
+#define BUILD_TITLE "hash_map_bench"
+#define BUILD_CONSOLE_INTERFACE 1
+
+////////////////////////////////
+//~ rjf: Includes
+
+//- rjf: [h]
+#include "base/base_inc.h"
+#include "os/os_inc.h"
+
+//- rjf: [c]
+#include "base/base_inc.c"
+#include "os/os_inc.c"
+
+////////////////////////////////
+//~ rjf: Chained Hash Table (Existing Codebase Pattern)
+
+typedef struct ChainNode ChainNode;
+struct ChainNode
+{
+  ChainNode *next;
+  U64 hash;
+  String8 key;
+  U64 value;
+};
+
+typedef struct ChainSlot ChainSlot;
+struct ChainSlot
+{
+  ChainNode *first;
+  ChainNode *last;
+};
+
+typedef struct ChainMap ChainMap;
+struct ChainMap
+{
+  U64 slots_count;
+  ChainSlot *slots;
+};
+
+internal ChainMap *
+chain_map_alloc(Arena *arena, U64 slots_count)
+{
+  ChainMap *map = push_array(arena, ChainMap, 1);
+  map->slots_count = slots_count;
+  map->slots = push_array(arena, ChainSlot, slots_count);
+  return map;
+}
+
+internal ChainNode *
+chain_map_lookup(ChainMap *map, U64 hash, String8 key)
+{
+  ChainNode *result = 0;
+  ChainSlot *slot = &map->slots[hash%map->slots_count];
+  for(ChainNode *n = slot->first; n != 0; n = n->next)
+  {
+    if(n->hash == hash && str8_match(n->key, key, 0))
+    {
+      result = n;
+      break;
+    }
+  }
+  return result;
+}
+
+internal void
+chain_map_insert(Arena *arena, ChainMap *map, U64 hash, String8 key, U64 value)
+{
+  ChainNode *node = chain_map_lookup(map, hash, key);
+  if(node == 0)
+  {
+    ChainSlot *slot = &map->slots[hash%map->slots_count];
+    node = push_array(arena, ChainNode, 1);
+    node->hash = hash;
+    node->key = key;
+    SLLQueuePush(slot->first, slot->last, node);
+  }
+  node->value = value;
+}
+
+////////////////////////////////
+//~ rjf: Helpers
+
+internal void
+bench_print(String8 name, U64 op_count, U64 elapsed_us)
+{
+  F64 ns_per_op = (F64)Max(elapsed_us, 1)*1000.0 / (F64)Max(op_count, 1);
+  F64 mops_per_s = (F64)op_count / (F64)Max(elapsed_us, 1);
+  fprintf(stdout, "  %-28.*s %8.2f ns/op  %8.2f Mop/s\n", str8_varg(name), ns_per_op, mops_per_s);
+}
+
+////////////////////////////////
+//~ rjf: Entry Point
+
+internal void
+entry_point(CmdLine *cmd_line)
+{
+  Arena *arena = arena_alloc();
+
+  //- rjf: unpack parameters
+  U64 key_count = 4000000;
+  {
+    String8 count_string = cmd_line_string(cmd_line, str8_lit("count"));
+    if(count_string.size != 0) { key_count = u64_from_str8(count_string, 10); }
+    key_count = Max(key_count, 1);
+  }
+
+  //- rjf: generate keys - symbol-like names, plus a disjoint set for misses
+  String8 *keys = push_array_no_zero(arena, String8, key_count);
+  String8 *miss_keys = push_array_no_zero(arena, String8, key_count);
+  U64 *hashes = push_array_no_zero(arena, U64, key_count);
+  U64 *miss_hashes = push_array_no_zero(arena, U64, key_count);
+  U64 *lookup_order = push_array_no_zero(arena, U64, key_count);
+  {
+    U64 state = 0x2545f4914f6cdd1dull;
+    for(U64 idx = 0; idx < key_count; idx += 1)
+    {
+      keys[idx] = push_str8f(arena, "ns::module_%I64u::symbol_%I64x", idx%97, idx*0x9e3779b97f4a7c15ull);
+      miss_keys[idx] = push_str8f(arena, "ns::module_%I64u::missing_%I64x", idx%97, idx*0x9e3779b97f4a7c15ull);
+      hashes[idx] = hash_map_hash_from_str8(keys[idx]);
+      miss_hashes[idx] = hash_map_hash_from_str8(miss_keys[idx]);
+      state ^= state << 13;
+      state ^= state >> 7;
+      state ^= state << 17;
+      lookup_order[idx] = state%key_count;
+    }
+  }
+  fprintf(stdout, "%I64u string keys\n", key_count);
+
+  //- rjf: chained
+  U64 chain_checksum = 0;
+  {
+    Temp temp = temp_begin(arena);
+    fprintf(stdout, "chained (slots = count/2, existing pattern):\n");
+    ChainMap *map = chain_map_alloc(temp.arena, key_count/2 + 1);
+    U64 t0 = os_now_microseconds();
+    for(U64 idx = 0; idx < key_count; idx += 1)
+    {
+      chain_map_insert(temp.arena, map, hashes[idx], keys[idx], idx);
+    }
+    U64 t1 = os_now_microseconds();
+    for(U64 idx = 0; idx < key_count; idx += 1)
+    {
+      U64 key_idx = lookup_order[idx];
+      ChainNode *node = chain_map_lookup(map, hashes[key_idx], keys[key_idx]);
+      chain_checksum += node ? node->value : 0;
+    }
+    U64 t2 = os_now_microseconds();
+    for(U64 idx = 0; idx < key_count; idx += 1)
+    {
+      ChainNode *node = chain_map_lookup(map, miss_hashes[idx], miss_keys[idx]);
+      chain_checksum += node ? 1 : 0;
+    }
+    U64 t3 = os_now_microseconds();
+    bench_print(str8_lit("insert"), key_count, t1-t0);
+    bench_print(str8_lit("lookup (hit, random order)"), key_count, t2-t1);
+    bench_print(str8_lit("lookup (miss)"), key_count, t3-t2);
+    temp_end(temp);
+  }
+
+  //- rjf: open addressing
+  U64 open_checksum = 0;
+  {
+    Temp temp = temp_begin(arena);
+    fprintf(stdout, "open addressing (HashMap, grown from 16):\n");
+    HashMap *map = hash_map_alloc(temp.arena, 0);
+    U64 t0 = os_now_microseconds();
+    for(U64 idx = 0; idx < key_count; idx += 1)
+    {
+      B32 is_new = 0;
+      HashMapSlot *slot = hash_map_ensure_hash_key(temp.arena, map, hashes[idx], keys[idx], &is_new);
+      slot->value = idx;
+    }
+    U64 t1 = os_now_microseconds();
+    for(U64 idx = 0; idx < key_count; idx += 1)
+    {
+      U64 key_idx = lookup_order[idx];
+      HashMapSlot *slot = hash_map_slot_from_hash_key(map, hashes[key_idx], keys[key_idx]);
+      open_checksum += slot ? slot->value : 0;
+    }
+    U64 t2 = os_now_microseconds();
+    for(U64 idx = 0; idx < key_count; idx += 1)
+    {
+      HashMapSlot *slot = hash_map_slot_from_hash_key(map, miss_hashes[idx], miss_keys[idx]);
+      open_checksum += slot ? 1 : 0;
+    }
+    U64 t3 = os_now_microseconds();
+    bench_print(str8_lit("insert"), key_count, t1-t0);
+    bench_print(str8_lit("lookup (hit, random order)"), key_count, t2-t1);
+    bench_print(str8_lit("lookup (miss)"), key_count, t3-t2);
+
+    //- rjf: removal of every other key, then verify survivors
+    U64 t4 = os_now_microseconds();
+    for(U64 idx = 0; idx < key_count; idx += 2)
+    {
+      hash_map_remove_hash_key(map, hashes[idx], keys[idx]);
+    }
+    U64 t5 = os_now_microseconds();
+    bench_print(str8_lit("remove (every other key)"), (key_count+1)/2, t5-t4);
+    for(U64 idx = 0; idx < key_count; idx += 1)
+    {
+      HashMapSlot *slot = hash_map_slot_from_hash_key(map, hashes[idx], keys[idx]);
+      B32 expect_present = (idx%2 == 1);
+      if((slot != 0) != expect_present || (slot != 0 && slot->value != idx))
+      {
+        fprintf(stdout, "  error: post-removal lookup mismatch at key %I64u\n", idx);
+        break;
+      }
+    }
+    temp_end(temp);
+  }
+
+  //- rjf: u64 keys
+  {
+    Temp temp = temp_begin(arena);
+    fprintf(stdout, "open addressing, u64 keys:\n");
+    HashMap *map = hash_map_alloc(temp.arena, key_count);
+    U64 t0 = os_now_microseconds();
+    for(U64 idx = 0; idx < key_count; idx += 1)
+    {
+      hash_map_insert_u64(temp.arena, map, hashes[idx], idx);
+    }
+    U64 t1 = os_now_microseconds();
+    U64 u64_checksum = 0;
+    for(U64 idx = 0; idx < key_count; idx += 1)
+    {
+      HashMapSlot *slot = hash_map_slot_from_u64(map, hashes[lookup_order[idx]]);
+      u64_checksum += slot ? slot->value : 0;
+    }
+    U64 t2 = os_now_microseconds();
+    bench_print(str8_lit("insert (presized)"), key_count, t1-t0);
+    bench_print(str8_lit("lookup (hit, random order)"), key_count, t2-t1);
+    fprintf(stdout, "  checksum %I64u\n", u64_checksum);
+    temp_end(temp);
+  }
+
+  fprintf(stdout, "checksums: chained %I64u, open addressing %I64u (%s)\n",
+          chain_checksum, open_checksum, chain_checksum == open_checksum ? "match" : "MISMATCH");
+  arena_release(arena);
+}
@@ -0,0 +1,215 @@
+// Copyright (c) 2024 Epic Games Tools
+// Licensed under the MIT license (https://opensource.org/license/mit/)
+
+////////////////////////////////
+//~ rjf: Build Options
+
+#define BUILD_VERSION_MAJOR 0
+#define BUILD_VERSION_MINOR 9
+#define BUILD_VERSION_PATCH 10
+#define BUILD_RELEASE_PHASE_STRING_LITERAL "ALPHA"
+#define BUILD_TITLE "line_scan_bench"
+#define BUILD_CONSOLE_INTERFACE 1
+
+////////////////////////////////
+//~ rjf: Includes
+
+//- rjf: [lib]
+#include "third_party/rad_lzb_simple/rad_lzb_simple.h"
+#include "third_party/rad_lzb_simple/rad_lzb_simple.c"
+
+//- rjf: [h]
+#include "base/base_inc.h"
+#include "os/os_inc.h"
+#include "task_system/task_system.h"
+#include "hash_store/hash_store.h"
+#include "artifact_cache/artifact_cache.h"
+#include "cache_engine/cache_engine.h"
+#include "text_cache/text_cache.h"
+
+//- rjf: [c]
+#include "base/base_inc.c"
+#include "os/os_inc.c"
+#include "task_system/task_system.c"
+#include "hash_store/hash_store.c"
+#include "artifact_cache/artifact_cache.c"
+#include "cache_engine/cache_engine.c"
+#include "text_cache/text_cache.c"
+
+////////////////////////////////
+//~ rjf: Byte-At-A-Time Reference Scanner
+
+internal TXT_LineEndCounts
+line_scan_bench_counts__scalar(String8 data)
+{
+  TXT_LineEndCounts counts = {0};
+  for(U64 idx = 0; idx < data.size; idx += 1)
+  {
+    if(data.str[idx] == '\r' && idx+1 < data.size && data.str[idx+1] == '\n')
+    {
+      counts.crlf_count += 1;
+      idx += 1;
+    }
+    else if(data.str[idx] == '\r')
+    {
+      counts.cr_count += 1;
+    }
+    else if(data.str[idx] == '\n')
+    {
+      counts.lf_count += 1;
+    }
+  }
+  return counts;
+}
+
+internal U64
+line_scan_bench_ranges__scalar(String8 data, Rng1U64 *lines_out, U64 lines_count)
+{
+  U64 lines_max_size = 0;
+  U64 line_idx = 0;
+  U64 line_start_off = 0;
+  for(U64 idx = 0; idx <= data.size && line_idx < lines_count; idx += 1)
+  {
+    if(idx == data.size || data.str[idx] == '\n' || data.str[idx] == '\r')
+    {
+      Rng1U64 line_range = r1u64(line_start_off, idx);
+      lines_out[line_idx] = line_range;
+      lines_max_size = Max(lines_max_size, dim_1u64(line_range));
+      line_idx += 1;
+      line_start_off = idx+1;
+      if(idx+1 < data.size && data.str[idx] == '\r' && data.str[idx+1] == '\n')
+      {
+        line_start_off += 1;
+        idx += 1;
+      }
+    }
+  }
+  return lines_max_size;
+}
+
+////////////////////////////////
+//~ rjf: Helpers
+
+internal void
+bench_print(String8 name, U64 size, U64 best_us)
+{
+  F64 gb_per_s = ((F64)size / (F64)GB(1)) / ((F64)Max(best_us, 1) / 1000000.0);
+  fprintf(stdout, "  %-28.*s %10.3f GB/s  (best %I64u us)\n", str8_varg(name), gb_per_s, best_us);
+}
+
+////////////////////////////////
+//~ rjf: Entry Point
+
+internal void
+entry_point(CmdLine *cmd_line)
+{
+  Arena *arena = arena_alloc();
+
+  //- rjf: unpack parameters
+  String8 path = cmd_line_string(cmd_line, str8_lit("file"));
+  U64 size_mb = 256;
+  U64 iteration_count = 4;
+  {
+    String8 size_string = cmd_line_string(cmd_line, str8_lit("size_mb"));
+    String8 iterations_string = cmd_line_string(cmd_line, str8_lit("iterations"));
+    if(size_string.size != 0)       { size_mb = u64_from_str8(size_string, 10); }
+    if(iterations_string.size != 0) { iteration_count = u64_from_str8(iterations_string, 10); }
+    size_mb = Max(size_mb, 1);
+    iteration_count = Max(iteration_count, 1);
+  }
+
+  //- rjf: load input file, or generate source-like text (xorshift64) with
+  // short & long lines, & mostly-LF endings mixed with some CRLF & bare CR
+  String8 data = {0};
+  if(path.size != 0)
+  {
+    data = os_data_from_file_path(arena, path);
+    fprintf(stdout, "scanning %.*s (%I64u bytes) x %I64u iterations\n", str8_varg(path), data.size, iteration_count);
+  }
+  else
+  {
+    data.size = MB(size_mb);
+    data.str = push_array_no_zero(arena, U8, data.size);
+    U64 state = 0x9e3779b97f4a7c15ull;
+    for(U64 off = 0; off < data.size;)
+    {
+      state ^= state << 13;
+      state ^= state >> 7;
+      state ^= state << 17;
+      U64 line_size = (state%8 == 0) ? (state>>8)%400 : (state>>8)%60;
+      for(U64 idx = 0; idx < line_size && off < data.size; idx += 1, off += 1)
+      {
+        data.str[off] = (U8)(' ' + (state>>(idx%48))%95);
+      }
+      U64 ending_kind = (state>>56)%16;
+      if(ending_kind == 0 && off+1 < data.size)
+      {
+        data.str[off+0] = '\r';
+        data.str[off+1] = '\n';
+        off += 2;
+      }
+      else if(ending_kind == 1 && off < data.size)
+      {
+        data.str[off] = '\r';
+        off += 1;
+      }
+      else if(off < data.size)
+      {
+        data.str[off] = '\n';
+        off += 1;
+      }
+    }
+    fprintf(stdout, "scanning %I64u MB of generated text x %I64u iterations\n", size_mb, iteration_count);
+  }
+
+  //- rjf: count line endings
+  TXT_LineEndCounts scalar_counts = {0};
+  TXT_LineEndCounts block_counts = {0};
+  {
+    fprintf(stdout, "line ending counts:\n");
+    U64 scalar_best_us = max_U64;
+    U64 block_best_us = max_U64;
+    for(U64 iteration_idx = 0; iteration_idx < iteration_count; iteration_idx += 1)
+    {
+      U64 t0 = os_now_microseconds();
+      scalar_counts = line_scan_bench_counts__scalar(data);
+      U64 t1 = os_now_microseconds();
+      block_counts = txt_line_end_counts_from_data(0, data);
+      U64 t2 = os_now_microseconds();
+      scalar_best_us = Min(scalar_best_us, t1-t0);
+      block_best_us = Min(block_best_us, t2-t1);
+    }
+    bench_print(str8_lit("byte loop"), data.size, scalar_best_us);
+    bench_print(str8_lit("txt_line_end_counts_from_data"), data.size, block_best_us);
+    fprintf(stdout, "  lf %I64u, crlf %I64u, cr %I64u (%s)\n", block_counts.lf_count, block_counts.crlf_count, block_counts.cr_count,
+            MemoryMatchStruct(&scalar_counts, &block_counts) ? "match" : "MISMATCH");
+  }
+
+  //- rjf: measure line ranges
+  {
+    fprintf(stdout, "line ranges:\n");
+    U64 lines_count = txt_line_count_from_line_end_counts(block_counts);
+    Rng1U64 *scalar_lines = push_array(arena, Rng1U64, lines_count);
+    Rng1U64 *block_lines = push_array(arena, Rng1U64, lines_count);
+    U64 scalar_max = 0;
+    U64 block_max = 0;
+    U64 scalar_best_us = max_U64;
+    U64 block_best_us = max_U64;
+    for(U64 iteration_idx = 0; iteration_idx < iteration_count; iteration_idx += 1)
+    {
+      U64 t0 = os_now_microseconds();
+      scalar_max = line_scan_bench_ranges__scalar(data, scalar_lines, lines_count);
+      U64 t1 = os_now_microseconds();
+      block_max = txt_line_ranges_from_data(0, data, block_lines, lines_count);
+      U64 t2 = os_now_microseconds();
+      scalar_best_us = Min(scalar_best_us, t1-t0);
+      block_best_us = Min(block_best_us, t2-t1);
+    }
+    bench_print(str8_lit("byte loop"), data.size, scalar_best_us);
+    bench_print(str8_lit("txt_line_ranges_from_data"), data.size, block_best_us);
+    B32 lines_match = (scalar_max == block_max && MemoryMatch(scalar_lines, block_lines, sizeof(Rng1U64)*lines_count));
+    fprintf(stdout, "  %I64u lines, max size %I64u (%s)\n", lines_count, block_max, lines_match ? "match" : "MISMATCH");
+  }
+
+  arena_release(arena);
+}
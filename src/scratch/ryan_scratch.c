@@ -19,6 +19,8 @@
 #include "lib_rdi_format/rdi_format_parse.h"
 #include "lib_rdi_format/rdi_format.c"
 #include "lib_rdi_format/rdi_format_parse.c"
+#include "third_party/rad_lzb_simple/rad_lzb_simple.h"
+#include "third_party/rad_lzb_simple/rad_lzb_simple.c"
 
 //- rjf: [h]
 #include "base/base_inc.h"
@@ -28,6 +30,8 @@
 #include "mdesk/mdesk.h"
 #include "hash_store/hash_store.h"
 #include "file_stream/file_stream.h"
+#include "artifact_cache/artifact_cache.h"
+#include "cache_engine/cache_engine.h"
 #include "text_cache/text_cache.h"
 #include "path/path.h"
 #include "txti/txti.h"
@@ -56,6 +60,8 @@
 #include "mdesk/mdesk.c"
 #include "hash_store/hash_store.c"
 #include "file_stream/file_stream.c"
+#include "artifact_cache/artifact_cache.c"
+#include "cache_engine/cache_engine.c"
 #include "text_cache/text_cache.c"
 #include "path/path.c"
 #include "txti/txti.c"
@@ -0,0 +1,406 @@
+// Copyright (c) 2024 Epic Games Tools
+// Licensed under the MIT license (https://opensource.org/license/mit/)
+
+////////////////////////////////
+//~ rjf: Build Options
+
+#define BUILD_VERSION_MAJOR 0
+#define BUILD_VERSION_MINOR 9
+#define BUILD_VERSION_PATCH 10
+#define BUILD_RELEASE_PHASE_STRING_LITERAL "ALPHA"
+#define BUILD_TITLE "text_bench"
+#define BUILD_CONSOLE_INTERFACE 1
+
+////////////////////////////////
+//~ rjf: Includes
+
+//- rjf: [lib]
+#include "third_party/rad_lzb_simple/rad_lzb_simple.h"
+#include "third_party/rad_lzb_simple/rad_lzb_simple.c"
+
+//- rjf: [h]
+#include "base/base_inc.h"
+#include "os/os_inc.h"
+#include "task_system/task_system.h"
+#include "hash_store/hash_store.h"
+#include "artifact_cache/artifact_cache.h"
+#include "cache_engine/cache_engine.h"
+#include "text_cache/text_cache.h"
+
+//- rjf: [c]
+#include "base/base_inc.c"
+#include "os/os_inc.c"
+#include "task_system/task_system.c"
+#include "hash_store/hash_store.c"
+#include "artifact_cache/artifact_cache.c"
+#include "cache_engine/cache_engine.c"
+#include "text_cache/text_cache.c"
+
+////////////////////////////////
+//~ rjf: Corpus Fragments
+//
+// Each corpus is built from lines picked from one of these tables, with every
+// %S replaced by a random identifier. Tables mix the constructs which each
+// lexer handles specially - comments, strings & escapes, numerics, & symbol
+// runs - with plain code.
+
+read_only global char *text_bench_c_cpp_fragments[] =
+{
+  "internal %S *\n",
+  "%S(Arena *arena, %S *%S)\n",
+  "{\n",
+  "}\n",
+  "\n",
+  "  U64 %S = 0;\n",
+  "  for(U64 idx = 0; idx < %S.count; idx += 1)\n",
+  "  if(%S != 0 && %S->%S >= 0x7fffffffull)\n",
+  "  %S = (%S << 13) ^ (%S >> 7);\n",
+  "  result.%S = push_array(arena, %S, %S.count);\n",
+  "  // rjf: %S the %S, & %S it\n",
+  "  /* %S\n     %S */\n",
+  "  String8 %S = str8_lit(\"%S \\\"quoted\\\" \\n\");\n",
+  "  U8 %S = '\\\\';\n",
+  "  F32 %S = 1.5e-3f * (F32)%S;\n",
+  "#define %S(x) ((x) + \\\n    1)\n",
+  "#include \"%S/%S.h\"\n",
+  "  return %S;\n",
+  "  case %S: { %S += 1; } break;\n",
+  "template <typename T> struct %S { T *%S; static constexpr int %S = 1'000; };\n",
+  "\t\tswitch(%S) { default: break; }\r\n",
+};
+
+read_only global char *text_bench_odin_fragments[] =
+{
+  "%S :: proc(%S: ^%S, allocator := context.allocator) -> (%S, bool) {\n",
+  "}\n",
+  "\n",
+  "\t%S := make([dynamic]%S, 0, 64)\n",
+  "\tfor %S, idx in %S {\n",
+  "\tif %S != nil && %S.%S >= 0x7fff_ffff do return\n",
+  "\t%S = (%S << 13) ~ (%S >> 7)\n",
+  "\t// %S the %S, and %S it\n",
+  "\t/* %S\n\t   %S */\n",
+  "\t%S := \"%S \\\"quoted\\\" \\n\"\n",
+  "\t%S := `raw %S string`\n",
+  "\t%S: f32 = 1.5e-3 * f32(%S)\n",
+  "#assert(size_of(%S) == 16)\n",
+  "\tdefer delete(%S)\n",
+  "\tcase .%S: %S += 1\n",
+  "%S :: struct #packed { %S: u32, %S: ^%S }\n",
+};
+
+read_only global char *text_bench_zig_fragments[] =
+{
+  "pub fn %S(%S: *%S, allocator: std.mem.Allocator) !%S {\n",
+  "}\n",
+  "\n",
+  "    var %S = std.ArrayList(%S).init(allocator);\n",
+  "    for (%S.items, 0..) |%S, idx| {\n",
+  "    if (%S != null and %S.%S >= 0x7fff_ffff) return;\n",
+  "    %S = (%S << 13) ^ (%S >> 7);\n",
+  "    // %S the %S, and %S it\n",
+  "    const %S = \"%S \\\"quoted\\\" \\n\";\n",
+  "    const %S =\n        \\\\multiline %S\n        \\\\string\n    ;\n",
+  "    const %S: f32 = 1.5e-3 * @as(f32, %S);\n",
+  "    defer %S.deinit();\n",
+  "    .%S => %S += 1,\n",
+  "const %S = packed struct { %S: u32, %S: *%S };\n",
+  "test \"%S\" { try std.testing.expect(%S); }\n",
+};
+
+read_only global char *text_bench_identifiers[] =
+{
+  "arena", "result", "node", "first", "last", "count", "data", "off", "size",
+  "line_range", "token", "tokens_count", "hash", "key", "slot", "entity",
+  "scratch", "string", "idx", "parent", "child", "ctrl_entity", "module",
+  "thread", "process", "vaddr", "voff", "unwind", "frame", "src_line_num",
+};
+
+read_only global char *text_bench_dasm_mnemonics[] =
+{
+  "mov", "lea", "add", "sub", "cmp", "test", "jne", "je", "jmp", "call",
+  "push", "pop", "xor", "and", "or", "shl", "shr", "movzx", "movsxd", "ret",
+  "nop", "imul", "movdqu", "pxor", "cvtsi2sd",
+};
+
+read_only global char *text_bench_dasm_operands[] =
+{
+  "rax, qword ptr [rsp+0x28]",
+  "rcx, rdx",
+  "dword ptr [rbp-0x14], 0x0",
+  "r8, [rip+0x1f2c4]",
+  "eax, byte ptr [rcx+rdx*1]",
+  "0x7ff6129a4c10",
+  "rsp, 0x48",
+  "xmm0, xmmword ptr [rax]",
+  "",
+};
+
+////////////////////////////////
+//~ rjf: Corpus Generation
+
+internal U64
+text_bench_rand(U64 *state)
+{
+  U64 x = *state;
+  x ^= x << 13;
+  x ^= x >> 7;
+  x ^= x << 17;
+  *state = x;
+  return x;
+}
+
+internal String8
+text_bench_corpus_from_fragments(Arena *arena, char **fragments, U64 fragments_count, U64 size, U64 seed)
+{
+  Temp scratch = scratch_begin(&arena, 1);
+  String8List parts = {0};
+  U64 state = seed;
+  for(U64 total_size = 0; total_size < size;)
+  {
+    char *fragment = fragments[text_bench_rand(&state)%fragments_count];
+    String8 names[4] = {0};
+    for(U64 idx = 0; idx < ArrayCount(names); idx += 1)
+    {
+      U64 r = text_bench_rand(&state);
+      names[idx] = str8_cstring(text_bench_identifiers[r%ArrayCount(text_bench_identifiers)]);
+    }
+    String8 line = push_str8f(scratch.arena, fragment, names[0], names[1], names[2], names[3]);
+    str8_list_push(scratch.arena, &parts, line);
+    total_size += line.size;
+  }
+  String8 result = str8_list_join(arena, &parts, 0);
+  result.size = Min(result.size, size);
+  scratch_end(scratch);
+  return result;
+}
+
+internal String8
+text_bench_dasm_corpus(Arena *arena, U64 size, U64 seed)
+{
+  Temp scratch = scratch_begin(&arena, 1);
+  String8List parts = {0};
+  U64 state = seed;
+  U64 vaddr = 0x7ff612340000ull;
+  for(U64 total_size = 0; total_size < size;)
+  {
+    U64 r = text_bench_rand(&state);
+    String8 line = {0};
+    if(r%16 == 0)
+    {
+      String8 name = str8_cstring(text_bench_identifiers[(r>>8)%ArrayCount(text_bench_identifiers)]);
+      line = push_str8f(scratch.arena, "> %S = %S->%S + 1;\n", name, name, name);
+    }
+    else
+    {
+      U64 inst_size = 1 + (r>>8)%7;
+      String8List code_bytes_strings = {0};
+      for(U64 idx = 0; idx < inst_size; idx += 1)
+      {
+        str8_list_pushf(scratch.arena, &code_bytes_strings, "%02x ", (U8)(r >> (16 + idx*6)));
+      }
+      String8 code_bytes_string = str8_list_join(scratch.arena, &code_bytes_strings, 0);
+      char *mnemonic = text_bench_dasm_mnemonics[(r>>40)%ArrayCount(text_bench_dasm_mnemonics)];
+      char *operands = text_bench_dasm_operands[(r>>48)%ArrayCount(text_bench_dasm_operands)];
+      line = push_str8f(scratch.arena, "  %016I64X  %S %s %s\n", vaddr, code_bytes_string, mnemonic, operands);
+      vaddr += inst_size;
+    }
+    str8_list_push(scratch.arena, &parts, line);
+    total_size += line.size;
+  }
+  String8 result = str8_list_join(arena, &parts, 0);
+  result.size = Min(result.size, size);
+  scratch_end(scratch);
+  return result;
+}
+
+////////////////////////////////
+//~ rjf: Helpers
+
+internal void
+text_bench_print_rate(String8 name, U64 size, U64 best_us)
+{
+  F64 mb_per_s = ((F64)size / (F64)MB(1)) / ((F64)Max(best_us, 1) / 1000000.0);
+  fprintf(stdout, "  %-24.*s %10.1f MB/s  (best %I64u us)\n", str8_varg(name), mb_per_s, best_us);
+}
+
+internal void
+text_bench_print_latency(String8 name, U64 query_count, U64 total_us)
+{
+  F64 ns_per_query = ((F64)total_us * 1000.0) / (F64)Max(query_count, 1);
+  fprintf(stdout, "  %-24.*s %10.1f ns/query  (%I64u queries)\n", str8_varg(name), ns_per_query, query_count);
+}
+
+internal U64
+text_bench_size_from_packed_range_array(TXT_PackedRangeArray *array)
+{
+  U64 blocks_count = (array->count + TXT_PACKED_RANGE_BLOCK_SIZE-1)/TXT_PACKED_RANGE_BLOCK_SIZE;
+  U64 size = (blocks_count*sizeof(U64) +
+              array->count*(sizeof(U32) + sizeof(U16)) +
+              array->overflow_count*(sizeof(U64) + sizeof(Rng1U64)));
+  return size;
+}
+
+////////////////////////////////
+//~ rjf: Entry Point
+
+internal void
+entry_point(CmdLine *cmd_line)
+{
+  Arena *arena = arena_alloc();
+
+  //- rjf: unpack parameters
+  U64 size_mb = 64;
+  U64 iteration_count = 4;
+  U64 query_count = 100000;
+  U64 slice_line_count = 64;
+  {
+    String8 size_string = cmd_line_string(cmd_line, str8_lit("size_mb"));
+    String8 iterations_string = cmd_line_string(cmd_line, str8_lit("iterations"));
+    String8 queries_string = cmd_line_string(cmd_line, str8_lit("queries"));
+    String8 slice_lines_string = cmd_line_string(cmd_line, str8_lit("slice_lines"));
+    if(size_string.size != 0)        { size_mb = u64_from_str8(size_string, 10); }
+    if(iterations_string.size != 0)  { iteration_count = u64_from_str8(iterations_string, 10); }
+    if(queries_string.size != 0)     { query_count = u64_from_str8(queries_string, 10); }
+    if(slice_lines_string.size != 0) { slice_line_count = u64_from_str8(slice_lines_string, 10); }
+    size_mb = Max(size_mb, 1);
+    iteration_count = Max(iteration_count, 1);
+    query_count = Max(query_count, 1);
+    slice_line_count = Max(slice_line_count, 1);
+  }
+  fprintf(stdout, "%I64u MB corpora, %I64u iterations, %I64u queries, %I64u-line slices, %I64u task threads\n",
+          size_mb, iteration_count, query_count, slice_line_count, ts_thread_count());
+
+  //- rjf: generate corpora
+  struct
+  {
+    String8 name;
+    TXT_LangKind lang;
+    String8 data;
+  }
+  corpora[] =
+  {
+    {str8_lit_comp("c/c++"),  TXT_LangKind_CPlusPlus},
+    {str8_lit_comp("odin"),   TXT_LangKind_Odin},
+    {str8_lit_comp("zig"),    TXT_LangKind_Zig},
+    {str8_lit_comp("disasm"), TXT_LangKind_DisasmX64Intel},
+  };
+  U64 size = MB(size_mb);
+  corpora[0].data = text_bench_corpus_from_fragments(arena, text_bench_c_cpp_fragments, ArrayCount(text_bench_c_cpp_fragments), size, 0x9e3779b97f4a7c15ull);
+  corpora[1].data = text_bench_corpus_from_fragments(arena, text_bench_odin_fragments, ArrayCount(text_bench_odin_fragments), size, 0xbf58476d1ce4e5b9ull);
+  corpora[2].data = text_bench_corpus_from_fragments(arena, text_bench_zig_fragments, ArrayCount(text_bench_zig_fragments), size, 0x94d049bb133111ebull);
+  corpora[3].data = text_bench_dasm_corpus(arena, size, 0x2545f4914f6cdd1dull);
+
+  //- rjf: benchmark each corpus
+  for(U64 corpus_idx = 0; corpus_idx < ArrayCount(corpora); corpus_idx += 1)
+  {
+    Temp scratch = scratch_begin(&arena, 1);
+    String8 name = corpora[corpus_idx].name;
+    TXT_LangKind lang = corpora[corpus_idx].lang;
+    String8 data = corpora[corpus_idx].data;
+    TXT_LangLexFunctionType *lex_function = txt_lex_function_from_lang_kind(lang);
+    fprintf(stdout, "%.*s (%I64u bytes):\n", str8_varg(name), data.size);
+
+    //- rjf: line scanning
+    TXT_TextInfo info = {0};
+    Rng1U64 *lines_ranges = 0;
+    {
+      U64 best_us = max_U64;
+      for(U64 iteration_idx = 0; iteration_idx < iteration_count; iteration_idx += 1)
+      {
+        Temp temp = temp_begin(scratch.arena);
+        U64 t0 = os_now_microseconds();
+        TXT_LineEndCounts counts = txt_line_end_counts_from_data(0, data);
+        U64 lines_count = txt_line_count_from_line_end_counts(counts);
+        Rng1U64 *ranges = push_array_no_zero(scratch.arena, Rng1U64, lines_count);
+        U64 lines_max_size = txt_line_ranges_from_data(0, data, ranges, lines_count);
+        U64 t1 = os_now_microseconds();
+        best_us = Min(best_us, t1-t0);
+        temp_end(temp);
+        info.line_end_counts = counts;
+        info.lines_count = lines_count;
+        info.lines_max_size = lines_max_size;
+      }
+      lines_ranges = push_array_no_zero(scratch.arena, Rng1U64, info.lines_count);
+      txt_line_ranges_from_data(0, data, lines_ranges, info.lines_count);
+      info.lines = txt_packed_range_array_from_rng1u64s(scratch.arena, lines_ranges, info.lines_count);
+      text_bench_print_rate(str8_lit("line scanning"), data.size, best_us);
+    }
+
+    //- rjf: lexing, serial & parallel
+    TXT_TokenArray tokens = {0};
+    {
+      U64 serial_best_us = max_U64;
+      U64 parallel_best_us = max_U64;
+      for(U64 iteration_idx = 0; iteration_idx < iteration_count; iteration_idx += 1)
+      {
+        Temp temp = temp_begin(scratch.arena);
+        U64 t0 = os_now_microseconds();
+        lex_function(scratch.arena, 0, data);
+        U64 t1 = os_now_microseconds();
+        txt_token_array_from_data_lang__parallel(scratch.arena, 0, data, lang);
+        U64 t2 = os_now_microseconds();
+        serial_best_us = Min(serial_best_us, t1-t0);
+        parallel_best_us = Min(parallel_best_us, t2-t1);
+        temp_end(temp);
+      }
+      tokens = lex_function(scratch.arena, 0, data);
+      info.tokens = txt_packed_token_array_from_token_array(scratch.arena, &tokens);
+      text_bench_print_rate(str8_lit("lexing (serial)"), data.size, serial_best_us);
+      text_bench_print_rate(str8_lit("lexing (parallel)"), data.size, parallel_best_us);
+    }
+
+    //- rjf: memory
+    {
+      U64 token_size = text_bench_size_from_packed_range_array(&info.tokens.ranges) + tokens.count*sizeof(U8);
+      U64 line_size = text_bench_size_from_packed_range_array(&info.lines);
+      fprintf(stdout, "  %I64u tokens: %.2f bytes/token packed (%I64u unpacked), %I64u overflowing\n",
+              tokens.count, (F64)token_size/(F64)Max(tokens.count, 1), (U64)sizeof(TXT_Token), info.tokens.ranges.overflow_count);
+      fprintf(stdout, "  %I64u lines: %.2f bytes/line packed (%I64u unpacked), %I64u overflowing\n",
+              info.lines_count, (F64)line_size/(F64)Max(info.lines_count, 1), (U64)sizeof(Rng1U64), info.lines.overflow_count);
+    }
+
+    //- rjf: queries, at random lines & offsets
+    {
+      U64 state = 0x853c49e6748fea9bull;
+      U64 check = 0;
+
+      // rjf: line tokens slices
+      U64 t0 = os_now_microseconds();
+      for(U64 query_idx = 0; query_idx < query_count; query_idx += 1)
+      {
+        Temp temp = temp_begin(scratch.arena);
+        S64 line_num = 1 + (S64)(text_bench_rand(&state)%info.lines_count);
+        TXT_LineTokensSlice slice = txt_line_tokens_slice_from_info_data_line_range(temp.arena, &info, data, r1s64(line_num, line_num + (S64)slice_line_count - 1));
+        check += slice.line_tokens[0].count;
+        temp_end(temp);
+      }
+      U64 t1 = os_now_microseconds();
+
+      // rjf: offset -> point
+      for(U64 query_idx = 0; query_idx < query_count; query_idx += 1)
+      {
+        TxtPt pt = txt_pt_from_info_off(&info, text_bench_rand(&state)%data.size);
+        check += (U64)pt.line;
+      }
+      U64 t2 = os_now_microseconds();
+
+      // rjf: point -> offset
+      for(U64 query_idx = 0; query_idx < query_count; query_idx += 1)
+      {
+        S64 line_num = 1 + (S64)(text_bench_rand(&state)%info.lines_count);
+        check += txt_off_from_info_pt(&info, txt_pt(line_num, 1));
+      }
+      U64 t3 = os_now_microseconds();
+
+      text_bench_print_latency(push_str8f(scratch.arena, "slice (%I64u lines)", slice_line_count), query_count, t1-t0);
+      text_bench_print_latency(str8_lit("txt_pt_from_info_off"), query_count, t2-t1);
+      text_bench_print_latency(str8_lit("txt_off_from_info_pt"), query_count, t3-t2);
+      fprintf(stdout, "  (check %I64u)\n", check);
+    }
+
+    scratch_end(scratch);
+  }
+
+  arena_release(arena);
+}
@@ -93,34 +93,17 @@ ts_kickoff(TS_TaskFunctionType *entry_point, Arena **optional_arena_ptr, void *p
   TS_Ticket ticket = {artifact_num, (U64)artifact};
   
   // rjf: push task info to task ring buffer
-  OS_MutexScope(ts_shared->u2t_ring_mutex) for(;;)
-  {
-    U64 unconsumed_size = ts_shared->u2t_ring_write_pos - ts_shared->u2t_ring_read_pos;
-    U64 available_size = ts_shared->u2t_ring_size-unconsumed_size;
-    if(available_size >= sizeof(entry_point) + sizeof(p) + sizeof(ticket))
-    {
-      Arena *task_arena = 0;
-      if(optional_arena_ptr != 0)
-      {
-        task_arena = *optional_arena_ptr;
-      }
-      ts_shared->u2t_ring_write_pos += ring_write_struct(ts_shared->u2t_ring_base, ts_shared->u2t_ring_size, ts_shared->u2t_ring_write_pos, &entry_point);
-      ts_shared->u2t_ring_write_pos += ring_write_struct(ts_shared->u2t_ring_base, ts_shared->u2t_ring_size, ts_shared->u2t_ring_write_pos, &task_arena);
-      ts_shared->u2t_ring_write_pos += ring_write_struct(ts_shared->u2t_ring_base, ts_shared->u2t_ring_size, ts_shared->u2t_ring_write_pos, &p);
-      ts_shared->u2t_ring_write_pos += ring_write_struct(ts_shared->u2t_ring_base, ts_shared->u2t_ring_size, ts_shared->u2t_ring_write_pos, &ticket);
-      if(optional_arena_ptr != 0)
-      {
-        *optional_arena_ptr = 0;
-      }
-      break;
-    }
-    os_condition_variable_wait(ts_shared->u2t_ring_cv, ts_shared->u2t_ring_mutex, max_U64);
-  }
-  os_condition_variable_broadcast(ts_shared->u2t_ring_cv);
+  ts_u2t_enqueue_task(entry_point, optional_arena_ptr, p, ticket);
   
   return ticket;
 }
 
+internal void
+ts_kickoff_detached(TS_TaskFunctionType *entry_point, Arena **optional_arena_ptr, void *p)
+{
+  ts_u2t_enqueue_task(entry_point, optional_arena_ptr, p, ts_ticket_zero());
+}
+
 internal void *
 ts_join(TS_Ticket ticket, U64 endt_us)
 {
@@ -155,9 +138,174 @@ ts_join(TS_Ticket ticket, U64 endt_us)
   return result;
 }
 
+////////////////////////////////
+//~ rjf: Parallel Radix Sort
+
+internal void
+ts_sort_key_radix_shared_release(TS_SortKeyRadixShared *shared)
+{
+  if(ins_atomic_u64_dec_eval(&shared->ref_count) == 0)
+  {
+    arena_release(shared->arena);
+  }
+}
+
+internal B32
+ts_sort_key_radix_do_work(TS_SortKeyRadixShared *shared)
+{
+  //- rjf: claim next work item
+  U64 work_idx = ins_atomic_u64_inc_eval(&shared->work_claim_gen) - 1;
+  B32 result = (work_idx < shared->work_count);
+  if(result)
+  {
+    //- rjf: unpack work item
+    U64 phase_idx = work_idx/shared->chunk_count;
+    U64 chunk_idx = work_idx%shared->chunk_count;
+    U64 digit_idx = phase_idx/2;
+    B32 is_scatter = (phase_idx%2 == 1);
+    U64 shift = shared->digit_shifts[digit_idx];
+    SortKey *src = shared->bufs[digit_idx%2];
+    SortKey *dst = shared->bufs[(digit_idx+1)%2];
+    U64 chunk_first = chunk_idx*shared->chunk_size;
+    U64 chunk_opl = Min(shared->count, chunk_first + shared->chunk_size);
+    U64 *chunk_counts = shared->chunk_counts + chunk_idx*SORT_KEY_RADIX_BUCKET_COUNT;
+    
+    //- rjf: wait for all items of previous phases - these have all been
+    // claimed by running threads, so this cannot wait on an unscheduled task
+    for(U64 phase_first_work_idx = phase_idx*shared->chunk_count;
+        ins_atomic_u64_eval(&shared->work_done_count) < phase_first_work_idx;)
+    {
+      os_sleep_milliseconds(0);
+    }
+    
+    //- rjf: histogram phase
+    if(!is_scatter)
+    {
+      sort_key_radix_histogram(src + chunk_first, chunk_opl - chunk_first, shift, chunk_counts);
+    }
+    
+    //- rjf: scatter phase - this chunk's offsets are the counts of all smaller
+    // buckets, plus the counts of this bucket in all earlier chunks
+    else
+    {
+      U64 offsets[SORT_KEY_RADIX_BUCKET_COUNT];
+      U64 bucket_base = 0;
+      for(U64 bucket = 0; bucket < SORT_KEY_RADIX_BUCKET_COUNT; bucket += 1)
+      {
+        U64 off = bucket_base;
+        for(U64 other_chunk_idx = 0; other_chunk_idx < shared->chunk_count; other_chunk_idx += 1)
+        {
+          U64 other_count = shared->chunk_counts[other_chunk_idx*SORT_KEY_RADIX_BUCKET_COUNT + bucket];
+          off += (other_chunk_idx < chunk_idx) ? other_count : 0;
+          bucket_base += other_count;
+        }
+        offsets[bucket] = off;
+      }
+      sort_key_radix_scatter(src + chunk_first, chunk_opl - chunk_first, shift, offsets, dst);
+    }
+    
+    ins_atomic_u64_inc_eval(&shared->work_done_count);
+  }
+  return result;
+}
+
+internal TS_TASK_FUNCTION_DEF(ts_sort_key_radix_task__entry_point)
+{
+  TS_SortKeyRadixShared *shared = (TS_SortKeyRadixShared *)p;
+  ProfScope("radix sort helper") for(;ts_sort_key_radix_do_work(shared);){}
+  ts_sort_key_radix_shared_release(shared);
+  return 0;
+}
+
+internal SortKey *
+ts_sort_key_array_radix(Arena *arena, SortKey *keys, U64 count)
+{
+  ProfBeginFunction();
+  SortKey *result = keys;
+  U64 min_chunk_size = 1<<16;
+  U64 max_chunk_count = ts_shared ? (ts_thread_count()+1)*2 : 1;
+  U64 chunk_count = Clamp(1, count/min_chunk_size, max_chunk_count);
+  
+  //- rjf: small arrays (or no task threads) -> sort on this thread
+  if(chunk_count <= 1)
+  {
+    result = sort_key_array_radix(arena, keys, count);
+  }
+  
+  //- rjf: large arrays -> split digit passes across task threads
+  else
+  {
+    U64 varying_key_bits = 0;
+    ProfScope("find varying key bits") varying_key_bits = sort_key_array_varying_key_bits(keys, count);
+    Arena *shared_arena = arena_alloc();
+    TS_SortKeyRadixShared *shared = push_array(shared_arena, TS_SortKeyRadixShared, 1);
+    shared->arena = shared_arena;
+    shared->digit_count = sort_key_radix_digit_shifts_from_varying_key_bits(varying_key_bits, shared->digit_shifts);
+    if(shared->digit_count != 0)
+    {
+      U64 helper_count = Min(ts_thread_count(), chunk_count-1);
+      shared->ref_count = helper_count+1;
+      shared->bufs[0] = keys;
+      shared->bufs[1] = push_array_no_zero(arena, SortKey, count);
+      shared->count = count;
+      shared->chunk_count = chunk_count;
+      shared->chunk_size = (count + chunk_count - 1)/chunk_count;
+      shared->chunk_counts = push_array(shared_arena, U64, chunk_count*SORT_KEY_RADIX_BUCKET_COUNT);
+      shared->work_count = shared->digit_count*2*chunk_count;
+      for(U64 idx = 0; idx < helper_count; idx += 1)
+      {
+        ts_kickoff_detached(ts_sort_key_radix_task__entry_point, 0, shared);
+      }
+      ProfScope("radix sort") for(;ts_sort_key_radix_do_work(shared);){}
+      ProfScope("wait for helpers") for(;ins_atomic_u64_eval(&shared->work_done_count) < shared->work_count;)
+      {
+        os_sleep_milliseconds(0);
+      }
+      result = shared->bufs[shared->digit_count%2];
+      ts_sort_key_radix_shared_release(shared);
+    }
+    else
+    {
+      arena_release(shared_arena);
+    }
+  }
+  
+  ProfEnd();
+  return result;
+}
+
 ////////////////////////////////
 //~ rjf: Task Threads
 
+internal void
+ts_u2t_enqueue_task(TS_TaskFunctionType *entry_point, Arena **optional_arena_ptr, void *p, TS_Ticket ticket)
+{
+  OS_MutexScope(ts_shared->u2t_ring_mutex) for(;;)
+  {
+    U64 unconsumed_size = ts_shared->u2t_ring_write_pos - ts_shared->u2t_ring_read_pos;
+    U64 available_size = ts_shared->u2t_ring_size-unconsumed_size;
+    if(available_size >= sizeof(entry_point) + sizeof(p) + sizeof(ticket))
+    {
+      Arena *task_arena = 0;
+      if(optional_arena_ptr != 0)
+      {
+        task_arena = *optional_arena_ptr;
+      }
+      ts_shared->u2t_ring_write_pos += ring_write_struct(ts_shared->u2t_ring_base, ts_shared->u2t_ring_size, ts_shared->u2t_ring_write_pos, &entry_point);
+      ts_shared->u2t_ring_write_pos += ring_write_struct(ts_shared->u2t_ring_base, ts_shared->u2t_ring_size, ts_shared->u2t_ring_write_pos, &task_arena);
+      ts_shared->u2t_ring_write_pos += ring_write_struct(ts_shared->u2t_ring_base, ts_shared->u2t_ring_size, ts_shared->u2t_ring_write_pos, &p);
+      ts_shared->u2t_ring_write_pos += ring_write_struct(ts_shared->u2t_ring_base, ts_shared->u2t_ring_size, ts_shared->u2t_ring_write_pos, &ticket);
+      if(optional_arena_ptr != 0)
+      {
+        *optional_arena_ptr = 0;
+      }
+      break;
+    }
+    os_condition_variable_wait(ts_shared->u2t_ring_cv, ts_shared->u2t_ring_mutex, max_U64);
+  }
+  os_condition_variable_broadcast(ts_shared->u2t_ring_cv);
+}
+
 internal void
 ts_u2t_dequeue_task(TS_TaskFunctionType **entry_point_out, Arena **arena_out, void **p_out, TS_Ticket *ticket_out)
 {
@@ -201,18 +349,21 @@ ts_task_thread__entry_point(void *p)
     //- rjf: run task
     void *task_result = task_function(task_arena, thread_idx, task_params);
     
-    //- rjf: store into artifact
+    //- rjf: store into artifact (detached tasks have none)
     U64 artifact_num = task_ticket.u64[0];
     U64 slot_idx = artifact_num%ts_shared->artifact_slots_count;
     U64 stripe_idx = slot_idx%ts_shared->artifact_stripes_count;
     TS_TaskArtifactSlot *slot = &ts_shared->artifact_slots[slot_idx];
     TS_TaskArtifactStripe *stripe = &ts_shared->artifact_stripes[stripe_idx];
     TS_TaskArtifact *artifact = (TS_TaskArtifact *)task_ticket.u64[1];
-    OS_MutexScopeW(stripe->rw_mutex)
+    if(artifact != 0)
     {
-      artifact->task_is_done = 1;
-      artifact->result = task_result;
+      OS_MutexScopeW(stripe->rw_mutex)
+      {
+        artifact->task_is_done = 1;
+        artifact->result = task_result;
+      }
+      os_condition_variable_broadcast(stripe->cv);
     }
-    os_condition_variable_broadcast(stripe->cv);
   }
 }
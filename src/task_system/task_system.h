@@ -75,6 +75,33 @@ struct TS_TaskThread
   OS_Handle thread;
 };
 
+////////////////////////////////
+//~ rjf: Parallel Radix Sort State
+//
+// Work is split into (digit pass, histogram/scatter phase, chunk) items,
+// claimed in order from a shared counter by the calling thread and by any
+// helper tasks which happen to start. An item only waits on items of earlier
+// phases, all of which have already been claimed by running threads, so the
+// sort never waits on a task which has not been scheduled - it is safe to
+// call from within other tasks. Helpers are detached & refcount the state.
+
+typedef struct TS_SortKeyRadixShared TS_SortKeyRadixShared;
+struct TS_SortKeyRadixShared
+{
+  Arena *arena;
+  U64 ref_count;
+  SortKey *bufs[2];
+  U64 count;
+  U64 chunk_size;
+  U64 chunk_count;
+  U64 *chunk_counts;
+  U64 digit_count;
+  U64 digit_shifts[SORT_KEY_RADIX_DIGIT_COUNT];
+  U64 work_count;
+  U64 work_claim_gen;
+  U64 work_done_count;
+};
+
 ////////////////////////////////
 //~ rjf: Main Shared State
 
@@ -128,12 +155,22 @@ internal U64 ts_thread_count(void);
 //~ rjf: High-Level Task Kickoff / Joining
 
 internal TS_Ticket ts_kickoff(TS_TaskFunctionType *entry_point, Arena **optional_arena_ptr, void *p);
+internal void ts_kickoff_detached(TS_TaskFunctionType *entry_point, Arena **optional_arena_ptr, void *p);
 internal void *ts_join(TS_Ticket ticket, U64 endt_us);
 #define ts_join_struct(ticket, endt_us, type) (type *)ts_join((ticket), (endt_us))
 
+////////////////////////////////
+//~ rjf: Parallel Radix Sort
+
+internal void ts_sort_key_radix_shared_release(TS_SortKeyRadixShared *shared);
+internal B32 ts_sort_key_radix_do_work(TS_SortKeyRadixShared *shared);
+internal TS_TASK_FUNCTION_DEF(ts_sort_key_radix_task__entry_point);
+internal SortKey *ts_sort_key_array_radix(Arena *arena, SortKey *keys, U64 count);
+
 ////////////////////////////////
 //~ rjf: Task Threads
 
+internal void ts_u2t_enqueue_task(TS_TaskFunctionType *entry_point, Arena **optional_arena_ptr, void *p, TS_Ticket ticket);
 internal void ts_u2t_dequeue_task(TS_TaskFunctionType **entry_point_out, Arena **arena_out, void **p_out, TS_Ticket *ticket_out);
 internal void ts_task_thread__entry_point(void *p);
 
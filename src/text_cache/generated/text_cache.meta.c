@@ -0,0 +1,2032 @@
+// Copyright (c) 2024 Epic Games Tools
+// Licensed under the MIT license (https://opensource.org/license/mit/)
+
+//- GENERATED CODE
+
+read_only global TXT_LexRules txt_lex_rules__c_cpp = {txt_c_cpp_byte_classes, txt_c_cpp_keywords_contains, TXT_LexRuleFlag_BlockComments|TXT_LexRuleFlag_MetaSpansLine};
+read_only global TXT_LexRules txt_lex_rules__odin = {txt_odin_byte_classes, txt_odin_keywords_contains, TXT_LexRuleFlag_BlockComments};
+read_only global TXT_LexRules txt_lex_rules__jai = {txt_jai_byte_classes, txt_jai_keywords_contains, TXT_LexRuleFlag_BlockComments};
+read_only global TXT_LexRules txt_lex_rules__zig = {txt_zig_byte_classes, txt_zig_keywords_contains, TXT_LexRuleFlag_LineStrings};
+internal B32
+txt_c_cpp_keywords_contains(String8 string)
+{
+B32 result = 0;
+if(2 <= string.size && string.size <= 16)
+{
+U64 hash = 0x304dull;
+for(U64 idx = 0; idx < string.size; idx += 1)
+{
+hash = (hash ^ string.str[idx]) * 0x100000001b3ull;
+}
+hash *= 0x9e3779b97f4a7c15ull;
+result = str8_match(txt_c_cpp_keywords[hash >> 55], string, 0);
+}
+return result;
+}
+
+internal B32
+txt_odin_keywords_contains(String8 string)
+{
+B32 result = 0;
+if(2 <= string.size && string.size <= 11)
+{
+U64 hash = 0x642ull;
+for(U64 idx = 0; idx < string.size; idx += 1)
+{
+hash = (hash ^ string.str[idx]) * 0x100000001b3ull;
+}
+hash *= 0x9e3779b97f4a7c15ull;
+result = str8_match(txt_odin_keywords[hash >> 57], string, 0);
+}
+return result;
+}
+
+internal B32
+txt_jai_keywords_contains(String8 string)
+{
+B32 result = 0;
+if(2 <= string.size && string.size <= 10)
+{
+U64 hash = 0x1f0ull;
+for(U64 idx = 0; idx < string.size; idx += 1)
+{
+hash = (hash ^ string.str[idx]) * 0x100000001b3ull;
+}
+hash *= 0x9e3779b97f4a7c15ull;
+result = str8_match(txt_jai_keywords[hash >> 57], string, 0);
+}
+return result;
+}
+
+internal B32
+txt_zig_keywords_contains(String8 string)
+{
+B32 result = 0;
+if(2 <= string.size && string.size <= 14)
+{
+U64 hash = 0xb8f1ull;
+for(U64 idx = 0; idx < string.size; idx += 1)
+{
+hash = (hash ^ string.str[idx]) * 0x100000001b3ull;
+}
+hash *= 0x9e3779b97f4a7c15ull;
+result = str8_match(txt_zig_keywords[hash >> 57], string, 0);
+}
+return result;
+}
+
+C_LINKAGE_BEGIN
+String8 txt_c_cpp_keywords[512] =
+{
+str8_lit_comp("alignof"),
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("extern"),
+{0},
+str8_lit_comp("try"),
+{0},
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("false"),
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("return"),
+{0},
+str8_lit_comp("new"),
+str8_lit_comp("bool"),
+{0},
+{0},
+{0},
+str8_lit_comp("break"),
+{0},
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("template"),
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("alignas"),
+str8_lit_comp("co_await"),
+{0},
+{0},
+str8_lit_comp("bitand"),
+{0},
+{0},
+{0},
+str8_lit_comp("concept"),
+{0},
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("virtual"),
+{0},
+{0},
+str8_lit_comp("asm"),
+{0},
+{0},
+str8_lit_comp("char8_t"),
+{0},
+{0},
+str8_lit_comp("const_cast"),
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("static_assert"),
+str8_lit_comp("void"),
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("mutable"),
+str8_lit_comp("private"),
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("or"),
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("typeid"),
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("noexcept"),
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("bitor"),
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("volatile"),
+{0},
+str8_lit_comp("signed"),
+{0},
+str8_lit_comp("explicit"),
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("not_eq"),
+str8_lit_comp("class"),
+{0},
+{0},
+str8_lit_comp("auto"),
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("sizeof"),
+{0},
+{0},
+{0},
+str8_lit_comp("xor_eq"),
+str8_lit_comp("enum"),
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("case"),
+{0},
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("true"),
+{0},
+{0},
+{0},
+str8_lit_comp("do"),
+{0},
+str8_lit_comp("for"),
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("not"),
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("using"),
+{0},
+str8_lit_comp("operator"),
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("static_cast"),
+{0},
+str8_lit_comp("and_eq"),
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("friend"),
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("dynamic_cast"),
+{0},
+str8_lit_comp("consteval"),
+{0},
+str8_lit_comp("float"),
+str8_lit_comp("atomic_commit"),
+str8_lit_comp("char"),
+str8_lit_comp("switch"),
+{0},
+str8_lit_comp("constinit"),
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("register"),
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("double"),
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("unsigned"),
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("atomic_noexcept"),
+str8_lit_comp("inline"),
+{0},
+str8_lit_comp("char32_t"),
+str8_lit_comp("delete"),
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("char16_t"),
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("xor"),
+str8_lit_comp("this"),
+{0},
+str8_lit_comp("while"),
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("nullptr"),
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("union"),
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("atomic_cancel"),
+{0},
+str8_lit_comp("reinterpret_cast"),
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("int"),
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("synchronized"),
+{0},
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("else"),
+str8_lit_comp("namespace"),
+str8_lit_comp("reflexpr"),
+str8_lit_comp("thread_local"),
+{0},
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("export"),
+{0},
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("typedef"),
+{0},
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("or_eq"),
+{0},
+str8_lit_comp("struct"),
+str8_lit_comp("continue"),
+{0},
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("catch"),
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("wchar_t"),
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("goto"),
+{0},
+str8_lit_comp("short"),
+{0},
+{0},
+{0},
+str8_lit_comp("requires"),
+str8_lit_comp("const"),
+{0},
+str8_lit_comp("public"),
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("protected"),
+{0},
+str8_lit_comp("default"),
+{0},
+{0},
+{0},
+str8_lit_comp("decltype"),
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("static"),
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("co_yield"),
+{0},
+{0},
+str8_lit_comp("throw"),
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("compl"),
+{0},
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("and"),
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("co_return"),
+str8_lit_comp("typename"),
+{0},
+str8_lit_comp("long"),
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("if"),
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("constexpr"),
+{0},
+{0},
+{0},
+};
+
+String8 txt_odin_keywords[128] =
+{
+{0},
+{0},
+str8_lit_comp("in"),
+{0},
+{0},
+str8_lit_comp("when"),
+{0},
+{0},
+{0},
+str8_lit_comp("not_in"),
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("distinct"),
+{0},
+{0},
+{0},
+str8_lit_comp("size_of"),
+str8_lit_comp("map"),
+str8_lit_comp("using"),
+{0},
+str8_lit_comp("asm"),
+{0},
+str8_lit_comp("proc"),
+{0},
+{0},
+{0},
+str8_lit_comp("context"),
+{0},
+str8_lit_comp("defer"),
+{0},
+str8_lit_comp("union"),
+{0},
+{0},
+{0},
+str8_lit_comp("typeid"),
+str8_lit_comp("matrix"),
+str8_lit_comp("return"),
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("bit_set"),
+str8_lit_comp("or_break"),
+{0},
+str8_lit_comp("cast"),
+{0},
+{0},
+{0},
+str8_lit_comp("case"),
+{0},
+str8_lit_comp("switch"),
+{0},
+{0},
+str8_lit_comp("for"),
+{0},
+str8_lit_comp("enum"),
+{0},
+str8_lit_comp("dynamic"),
+{0},
+{0},
+{0},
+str8_lit_comp("or_return"),
+{0},
+str8_lit_comp("or_else"),
+{0},
+{0},
+{0},
+str8_lit_comp("align_of"),
+str8_lit_comp("do"),
+str8_lit_comp("transmute"),
+str8_lit_comp("break"),
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("continue"),
+{0},
+{0},
+{0},
+str8_lit_comp("import"),
+str8_lit_comp("fallthrough"),
+str8_lit_comp("where"),
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("else"),
+{0},
+{0},
+str8_lit_comp("struct"),
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("package"),
+{0},
+{0},
+{0},
+str8_lit_comp("foreign"),
+{0},
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("or_continue"),
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("auto_cast"),
+str8_lit_comp("if"),
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+};
+
+String8 txt_jai_keywords[128] =
+{
+{0},
+{0},
+str8_lit_comp("for"),
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("s128"),
+{0},
+str8_lit_comp("s64"),
+{0},
+str8_lit_comp("xx"),
+str8_lit_comp("float32"),
+{0},
+str8_lit_comp("string"),
+{0},
+{0},
+str8_lit_comp("return"),
+{0},
+{0},
+str8_lit_comp("break"),
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("cast"),
+str8_lit_comp("size_of"),
+{0},
+{0},
+str8_lit_comp("case"),
+{0},
+str8_lit_comp("while"),
+{0},
+str8_lit_comp("remove"),
+str8_lit_comp("continue"),
+str8_lit_comp("s32"),
+str8_lit_comp("bool"),
+str8_lit_comp("null"),
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("s8"),
+str8_lit_comp("u16"),
+{0},
+str8_lit_comp("float64"),
+{0},
+{0},
+str8_lit_comp("else"),
+{0},
+{0},
+{0},
+str8_lit_comp("int"),
+{0},
+str8_lit_comp("u32"),
+{0},
+{0},
+str8_lit_comp("s16"),
+str8_lit_comp("false"),
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("defer"),
+str8_lit_comp("u64"),
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("enum"),
+{0},
+{0},
+{0},
+str8_lit_comp("u128"),
+{0},
+str8_lit_comp("inline"),
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("ifs"),
+{0},
+{0},
+{0},
+str8_lit_comp("void"),
+{0},
+{0},
+{0},
+str8_lit_comp("enum_flags"),
+{0},
+str8_lit_comp("true"),
+{0},
+{0},
+{0},
+str8_lit_comp("u8"),
+{0},
+str8_lit_comp("float"),
+{0},
+str8_lit_comp("type_of"),
+{0},
+{0},
+str8_lit_comp("then"),
+{0},
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("if"),
+};
+
+String8 txt_zig_keywords[128] =
+{
+{0},
+str8_lit_comp("or"),
+{0},
+{0},
+{0},
+str8_lit_comp("fn"),
+{0},
+{0},
+{0},
+str8_lit_comp("suspend"),
+str8_lit_comp("errdefer"),
+{0},
+{0},
+str8_lit_comp("noalias"),
+str8_lit_comp("addrspace"),
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("async"),
+{0},
+{0},
+str8_lit_comp("try"),
+str8_lit_comp("anytype"),
+{0},
+{0},
+str8_lit_comp("if"),
+str8_lit_comp("switch"),
+str8_lit_comp("inline"),
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("linksection"),
+{0},
+{0},
+{0},
+str8_lit_comp("await"),
+str8_lit_comp("usingnamespace"),
+str8_lit_comp("defer"),
+str8_lit_comp("pub"),
+{0},
+{0},
+str8_lit_comp("and"),
+str8_lit_comp("union"),
+str8_lit_comp("return"),
+{0},
+{0},
+str8_lit_comp("align"),
+{0},
+str8_lit_comp("packed"),
+str8_lit_comp("break"),
+{0},
+{0},
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("continue"),
+str8_lit_comp("for"),
+str8_lit_comp("nosuspend"),
+{0},
+str8_lit_comp("export"),
+{0},
+str8_lit_comp("unreachable"),
+str8_lit_comp("var"),
+str8_lit_comp("threadlocal"),
+{0},
+{0},
+str8_lit_comp("comptime"),
+{0},
+str8_lit_comp("struct"),
+{0},
+{0},
+str8_lit_comp("anyframe"),
+{0},
+str8_lit_comp("noinline"),
+{0},
+str8_lit_comp("error"),
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("orelse"),
+{0},
+{0},
+{0},
+str8_lit_comp("volatile"),
+{0},
+str8_lit_comp("enum"),
+{0},
+{0},
+str8_lit_comp("while"),
+{0},
+{0},
+str8_lit_comp("test"),
+{0},
+str8_lit_comp("resume"),
+{0},
+{0},
+{0},
+{0},
+str8_lit_comp("const"),
+str8_lit_comp("extern"),
+str8_lit_comp("catch"),
+{0},
+str8_lit_comp("opaque"),
+str8_lit_comp("callconv"),
+{0},
+{0},
+{0},
+str8_lit_comp("allowzero"),
+str8_lit_comp("asm"),
+{0},
+str8_lit_comp("else"),
+{0},
+};
+
+TXT_ByteClassFlags txt_c_cpp_byte_classes[256] =
+{
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+TXT_ByteClassFlag_Whitespace,
+TXT_ByteClassFlag_Whitespace,
+TXT_ByteClassFlag_Whitespace,
+TXT_ByteClassFlag_Whitespace,
+TXT_ByteClassFlag_Whitespace,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+TXT_ByteClassFlag_Whitespace,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+0,
+TXT_ByteClassFlag_Meta,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_NumericContinue|TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_Digit|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_Digit|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_Digit|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_Digit|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_Digit|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_Digit|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_Digit|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_Digit|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_Digit|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_Digit|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+0,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+0,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+0,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+};
+
+TXT_ByteClassFlags txt_odin_byte_classes[256] =
+{
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+TXT_ByteClassFlag_Whitespace,
+TXT_ByteClassFlag_Whitespace,
+TXT_ByteClassFlag_Whitespace,
+TXT_ByteClassFlag_Whitespace,
+TXT_ByteClassFlag_Whitespace,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+TXT_ByteClassFlag_Whitespace,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+0,
+TXT_ByteClassFlag_Meta,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_NumericContinue|TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_Digit|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_Digit|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_Digit|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_Digit|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_Digit|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_Digit|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_Digit|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_Digit|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_Digit|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_Digit|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+0,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+0,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+0,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+};
+
+TXT_ByteClassFlags txt_jai_byte_classes[256] =
+{
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+TXT_ByteClassFlag_Whitespace,
+TXT_ByteClassFlag_Whitespace,
+TXT_ByteClassFlag_Whitespace,
+TXT_ByteClassFlag_Whitespace,
+TXT_ByteClassFlag_Whitespace,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+TXT_ByteClassFlag_Whitespace,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+0,
+TXT_ByteClassFlag_Meta,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_NumericContinue|TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_Digit|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_Digit|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_Digit|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_Digit|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_Digit|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_Digit|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_Digit|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_Digit|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_Digit|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_Digit|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+0,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+0,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+0,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+};
+
+TXT_ByteClassFlags txt_zig_byte_classes[256] =
+{
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+TXT_ByteClassFlag_Whitespace,
+TXT_ByteClassFlag_Whitespace,
+TXT_ByteClassFlag_Whitespace,
+TXT_ByteClassFlag_Whitespace,
+TXT_ByteClassFlag_Whitespace,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+TXT_ByteClassFlag_Whitespace,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+0,
+0,
+TXT_ByteClassFlag_IdentContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_NumericContinue|TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_Digit|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_Digit|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_Digit|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_Digit|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_Digit|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_Digit|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_Digit|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_Digit|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_Digit|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_Digit|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+0,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+0,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+0,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue|TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_IdentStart|TXT_ByteClassFlag_IdentContinue|TXT_ByteClassFlag_NumericContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+TXT_ByteClassFlag_Symbol|TXT_ByteClassFlag_SymbolContinue,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+};
+
+C_LINKAGE_END
+
@@ -0,0 +1,24 @@
+// Copyright (c) 2024 Epic Games Tools
+// Licensed under the MIT license (https://opensource.org/license/mit/)
+
+//- GENERATED CODE
+
+#ifndef TEXT_CACHE_META_H
+#define TEXT_CACHE_META_H
+
+internal B32 txt_c_cpp_keywords_contains(String8 string);
+internal B32 txt_odin_keywords_contains(String8 string);
+internal B32 txt_jai_keywords_contains(String8 string);
+internal B32 txt_zig_keywords_contains(String8 string);
+C_LINKAGE_BEGIN
+extern String8 txt_c_cpp_keywords[512];
+extern String8 txt_odin_keywords[128];
+extern String8 txt_jai_keywords[128];
+extern String8 txt_zig_keywords[128];
+extern TXT_ByteClassFlags txt_c_cpp_byte_classes[256];
+extern TXT_ByteClassFlags txt_odin_byte_classes[256];
+extern TXT_ByteClassFlags txt_jai_byte_classes[256];
+extern TXT_ByteClassFlags txt_zig_byte_classes[256];
+C_LINKAGE_END
+
+#endif // TEXT_CACHE_META_H
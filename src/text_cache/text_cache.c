@@ -1,6 +1,11 @@
 // Copyright (c) 2024 Epic Games Tools
 // Licensed under the MIT license (https://opensource.org/license/mit/)
 
+////////////////////////////////
+//~ rjf: Generated Code
+
+#include "generated/text_cache.meta.c"
+
 ////////////////////////////////
 //~ rjf: Basic Helpers
 
@@ -95,6 +100,16 @@ txt_lex_function_from_lang_kind(TXT_LangKind kind)
   return fn;
 }
 
+internal B32
+txt_lang_kind_is_relexable(TXT_LangKind kind)
+{
+  // NOTE(rjf): the disassembly lexer tracks bracket nesting across tokens, &
+  // the zig lexer keeps treating strings as line strings once it has seen
+  // one, so neither can be resumed from an arbitrary token boundary
+  B32 result = (kind != TXT_LangKind_DisasmX64Intel && kind != TXT_LangKind_Zig);
+  return result;
+}
+
 ////////////////////////////////
 //~ rjf: Token Type Functions
 
@@ -155,305 +170,204 @@ txt_token_array_from_list(Arena *arena, TXT_TokenList *list)
 }
 
 ////////////////////////////////
-//~ rjf: Lexing Functions
+//~ rjf: Packed Range Functions
 
-internal TXT_TokenArray
-txt_token_array_from_string__c_cpp(Arena *arena, U64 *bytes_processed_counter, String8 string)
+internal TXT_PackedRangeArray
+txt_packed_range_array_from_rng1u64s__stride(Arena *arena, Rng1U64 *first, U64 stride, U64 count)
 {
-  Temp scratch = scratch_begin(&arena, 1);
+  TXT_PackedRangeArray array = {0};
+  array.count           = count;
+  array.block_base_offs = push_array_no_zero(arena, U64, (count + TXT_PACKED_RANGE_BLOCK_SIZE-1)/TXT_PACKED_RANGE_BLOCK_SIZE);
+  array.offs            = push_array_no_zero(arena, U32, count);
+  array.sizes           = push_array_no_zero(arena, U16, count);
   
-  //- rjf: generate token list
-  TXT_TokenChunkList tokens = {0};
+  //- rjf: pack ranges, & count those which do not fit. an overflowing range
+  // keeps its offset, clamped, so that searches can skip most of them.
+  U64 block_base_off = 0;
+  for(U64 idx = 0; idx < count; idx += 1)
   {
-    B32 comment_is_single_line = 0;
-    B32 string_is_char = 0;
-    TXT_TokenKind active_token_kind = TXT_TokenKind_Null;
-    U64 active_token_start_idx = 0;
-    B32 escaped = 0;
-    B32 next_escaped = 0;
-    U64 byte_process_start_idx = 0;
-    for(U64 idx = 0; idx <= string.size;)
+    Rng1U64 range = *(Rng1U64 *)((U8 *)first + idx*stride);
+    if(idx%TXT_PACKED_RANGE_BLOCK_SIZE == 0)
     {
-      U8 byte      = (idx+0 < string.size) ? (string.str[idx+0]) : 0;
-      U8 next_byte = (idx+1 < string.size) ? (string.str[idx+1]) : 0;
-      
-      // rjf: update counter
-      if(bytes_processed_counter != 0 && ((idx-byte_process_start_idx) >= 1000 || idx == string.size))
-      {
-        ins_atomic_u64_add_eval(bytes_processed_counter, (idx-byte_process_start_idx));
-        byte_process_start_idx = idx;
-      }
-      
-      // rjf: escaping
-      if(escaped && (byte != '\r' && byte != '\n'))
-      {
-        next_escaped = 0;
-      }
-      else if(!escaped && byte == '\\')
+      block_base_off = range.min;
+      array.block_base_offs[idx/TXT_PACKED_RANGE_BLOCK_SIZE] = block_base_off;
+    }
+    U64 rel_off = range.min - block_base_off;
+    U64 size = range.max - range.min;
+    array.offs[idx] = (U32)Min(rel_off, max_U32);
+    if(rel_off <= max_U32 && size < TXT_PACKED_RANGE_SIZE_OVERFLOW)
+    {
+      array.sizes[idx] = (U16)size;
+    }
+    else
+    {
+      array.sizes[idx] = TXT_PACKED_RANGE_SIZE_OVERFLOW;
+      array.overflow_count += 1;
+    }
+  }
+  
+  //- rjf: store overflowing ranges in full
+  array.overflow_idxs   = push_array_no_zero(arena, U64, array.overflow_count);
+  array.overflow_ranges = push_array_no_zero(arena, Rng1U64, array.overflow_count);
+  if(array.overflow_count != 0)
+  {
+    U64 overflow_idx = 0;
+    for(U64 idx = 0; idx < count; idx += 1)
+    {
+      if(array.sizes[idx] == TXT_PACKED_RANGE_SIZE_OVERFLOW)
       {
-        next_escaped = 1;
+        array.overflow_idxs[overflow_idx]   = idx;
+        array.overflow_ranges[overflow_idx] = *(Rng1U64 *)((U8 *)first + idx*stride);
+        overflow_idx += 1;
       }
-      
-      // rjf: take starter, determine active token kind
-      if(active_token_kind == TXT_TokenKind_Null)
+    }
+  }
+  return array;
+}
+
+internal TXT_PackedRangeArray
+txt_packed_range_array_from_rng1u64s(Arena *arena, Rng1U64 *ranges, U64 count)
+{
+  return txt_packed_range_array_from_rng1u64s__stride(arena, ranges, sizeof(Rng1U64), count);
+}
+
+internal TXT_PackedTokenArray
+txt_packed_token_array_from_token_array(Arena *arena, TXT_TokenArray *tokens)
+{
+  TXT_PackedTokenArray result = {0};
+  result.ranges = txt_packed_range_array_from_rng1u64s__stride(arena, &tokens->v[0].range, sizeof(TXT_Token), tokens->count);
+  result.kinds  = push_array_no_zero(arena, U8, tokens->count);
+  for(U64 idx = 0; idx < tokens->count; idx += 1)
+  {
+    result.kinds[idx] = (U8)tokens->v[idx].kind;
+  }
+  return result;
+}
+
+internal Rng1U64
+txt_range_from_packed_range_array_idx(TXT_PackedRangeArray *array, U64 idx)
+{
+  Rng1U64 result = {0};
+  if(idx < array->count)
+  {
+    if(array->sizes[idx] != TXT_PACKED_RANGE_SIZE_OVERFLOW)
+    {
+      result.min = array->block_base_offs[idx/TXT_PACKED_RANGE_BLOCK_SIZE] + array->offs[idx];
+      result.max = result.min + array->sizes[idx];
+    }
+    else
+    {
+      U64 lo = 0;
+      U64 hi = array->overflow_count;
+      for(;lo < hi;)
       {
-        // rjf: use next bytes to start a new token
-        if(0){}
-        else if(char_is_space(byte))             { active_token_kind = TXT_TokenKind_Whitespace; }
-        else if(byte == '_' ||
-                byte == '$' ||
-                char_is_alpha(byte))             { active_token_kind = TXT_TokenKind_Identifier; }
-        else if(char_is_digit(byte, 10) ||
-                (byte == '.' &&
-                 char_is_digit(next_byte, 10)))  { active_token_kind = TXT_TokenKind_Numeric; }
-        else if(byte == '"')                     { active_token_kind = TXT_TokenKind_String; string_is_char = 0; }
-        else if(byte == '\'')                    { active_token_kind = TXT_TokenKind_String; string_is_char = 1; }
-        else if(byte == '/' && next_byte == '/') { active_token_kind = TXT_TokenKind_Comment; comment_is_single_line = 1; }
-        else if(byte == '/' && next_byte == '*') { active_token_kind = TXT_TokenKind_Comment; comment_is_single_line = 0; }
-        else if(byte == '~' || byte == '!' ||
-                byte == '%' || byte == '^' ||
-                byte == '&' || byte == '*' ||
-                byte == '(' || byte == ')' ||
-                byte == '-' || byte == '=' ||
-                byte == '+' || byte == '[' ||
-                byte == ']' || byte == '{' ||
-                byte == '}' || byte == ':' ||
-                byte == ';' || byte == ',' ||
-                byte == '.' || byte == '<' ||
-                byte == '>' || byte == '/' ||
-                byte == '?' || byte == '|')      { active_token_kind = TXT_TokenKind_Symbol; }
-        else if(byte == '#')                     { active_token_kind = TXT_TokenKind_Meta; }
-        
-        // rjf: start new token
-        if(active_token_kind != TXT_TokenKind_Null)
+        U64 mid = lo + (hi-lo)/2;
+        if(array->overflow_idxs[mid] < idx)
         {
-          active_token_start_idx = idx;
+          lo = mid+1;
         }
-        
-        // rjf: invalid token kind -> emit error
         else
         {
-          TXT_Token token = {TXT_TokenKind_Error, r1u64(idx, idx+1)};
-          txt_token_chunk_list_push(scratch.arena, &tokens, 4096, &token);
+          hi = mid;
         }
       }
-      
-      // rjf: look for ender
-      U64 ender_pad = 0;
-      B32 ender_found = 0;
-      if(active_token_kind != TXT_TokenKind_Null && idx>active_token_start_idx)
+      if(lo < array->overflow_count && array->overflow_idxs[lo] == idx)
       {
-        if(idx == string.size)
-        {
-          ender_pad = 0;
-          ender_found = 1;
-        }
-        else switch(active_token_kind)
-        {
-          default:break;
-          case TXT_TokenKind_Whitespace:
-          {
-            ender_found = !char_is_space(byte);
-          }break;
-          case TXT_TokenKind_Identifier:
-          {
-            ender_found = (!char_is_alpha(byte) && !char_is_digit(byte, 10) && byte != '_' && byte != '$');
-          }break;
-          case TXT_TokenKind_Numeric:
-          {
-            ender_found = (!char_is_alpha(byte) && !char_is_digit(byte, 10) && byte != '_' && byte != '.' && byte != '\'');
-          }break;
-          case TXT_TokenKind_String:
-          {
-            ender_found = (!escaped && ((!string_is_char && byte == '"') || (string_is_char && byte == '\'')));
-            ender_pad += 1;
-          }break;
-          case TXT_TokenKind_Symbol:
-          {
-            ender_found = (byte != '~' && byte != '!' &&
-                           byte != '%' && byte != '^' &&
-                           byte != '&' && byte != '*' &&
-                           byte != '(' && byte != ')' &&
-                           byte != '-' && byte != '=' &&
-                           byte != '+' && byte != '[' &&
-                           byte != ']' && byte != '{' &&
-                           byte != '}' && byte != ':' &&
-                           byte != ';' && byte != ',' &&
-                           byte != '.' && byte != '<' &&
-                           byte != '>' && byte != '/' &&
-                           byte != '?' && byte != '|');
-          }break;
-          case TXT_TokenKind_Comment:
-          {
-            if(comment_is_single_line)
-            {
-              ender_found = (!escaped && (byte == '\r' || byte == '\n'));
-            }
-            else
-            {
-              ender_found = (active_token_start_idx+1 < idx && byte == '*' && next_byte == '/');
-              ender_pad += 2;
-            }
-          }break;
-          case TXT_TokenKind_Meta:
-          {
-            ender_found = (!escaped && (byte == '\r' || byte == '\n'));
-          }break;
-        }
+        result = array->overflow_ranges[lo];
       }
-      
-      // rjf: next byte is ender => emit token
-      if(ender_found)
+    }
+  }
+  return result;
+}
+
+internal U64
+txt_idx_upper_bound_from_packed_range_array_off(TXT_PackedRangeArray *array, U64 off)
+{
+  U64 result = 0;
+  
+  //- rjf: find the last block starting at or before the offset
+  U64 lo = 0;
+  U64 hi = (array->count + TXT_PACKED_RANGE_BLOCK_SIZE-1)/TXT_PACKED_RANGE_BLOCK_SIZE;
+  for(;lo < hi;)
+  {
+    U64 mid = lo + (hi-lo)/2;
+    if(array->block_base_offs[mid] <= off)
+    {
+      lo = mid+1;
+    }
+    else
+    {
+      hi = mid;
+    }
+  }
+  
+  //- rjf: find the first range within it starting past the offset
+  if(lo != 0)
+  {
+    U64 block_idx = lo-1;
+    U64 block_base_off = array->block_base_offs[block_idx];
+    U64 block_first_idx = block_idx*TXT_PACKED_RANGE_BLOCK_SIZE;
+    lo = block_first_idx+1;
+    hi = Min(block_first_idx+TXT_PACKED_RANGE_BLOCK_SIZE, array->count);
+    for(;lo < hi;)
+    {
+      U64 mid = lo + (hi-lo)/2;
+      U64 mid_min = (array->offs[mid] != max_U32 ? block_base_off + array->offs[mid] : txt_range_from_packed_range_array_idx(array, mid).min);
+      if(mid_min <= off)
       {
-        TXT_Token token = {active_token_kind, r1u64(active_token_start_idx, idx+ender_pad)};
-        active_token_kind = TXT_TokenKind_Null;
-        
-        // rjf: identifier -> keyword in special cases
-        if(token.kind == TXT_TokenKind_Identifier)
-        {
-          read_only local_persist String8 cpp_keywords[] =
-          {
-            str8_lit_comp("alignas"),
-            str8_lit_comp("alignof"),
-            str8_lit_comp("and"),
-            str8_lit_comp("and_eq"),
-            str8_lit_comp("asm"),
-            str8_lit_comp("atomic_cancel"),
-            str8_lit_comp("atomic_commit"),
-            str8_lit_comp("atomic_noexcept"),
-            str8_lit_comp("auto"),
-            str8_lit_comp("bitand"),
-            str8_lit_comp("bitor"),
-            str8_lit_comp("bool"),
-            str8_lit_comp("break"),
-            str8_lit_comp("case"),
-            str8_lit_comp("catch"),
-            str8_lit_comp("char"),
-            str8_lit_comp("char8_t"),
-            str8_lit_comp("char16_t"),
-            str8_lit_comp("char32_t"),
-            str8_lit_comp("class"),
-            str8_lit_comp("compl"),
-            str8_lit_comp("concept"),
-            str8_lit_comp("const"),
-            str8_lit_comp("consteval"),
-            str8_lit_comp("constexpr"),
-            str8_lit_comp("constinit"),
-            str8_lit_comp("const_cast"),
-            str8_lit_comp("continue"),
-            str8_lit_comp("co_await"),
-            str8_lit_comp("co_return"),
-            str8_lit_comp("co_yield"),
-            str8_lit_comp("decltype"),
-            str8_lit_comp("default"),
-            str8_lit_comp("delete"),
-            str8_lit_comp("do"),
-            str8_lit_comp("double"),
-            str8_lit_comp("dynamic_cast"),
-            str8_lit_comp("else"),
-            str8_lit_comp("enum"),
-            str8_lit_comp("explicit"),
-            str8_lit_comp("export"),
-            str8_lit_comp("extern"),
-            str8_lit_comp("false"),
-            str8_lit_comp("float"),
-            str8_lit_comp("for"),
-            str8_lit_comp("friend"),
-            str8_lit_comp("goto"),
-            str8_lit_comp("if"),
-            str8_lit_comp("inline"),
-            str8_lit_comp("int"),
-            str8_lit_comp("long"),
-            str8_lit_comp("mutable"),
-            str8_lit_comp("namespace"),
-            str8_lit_comp("new"),
-            str8_lit_comp("noexcept"),
-            str8_lit_comp("not"),
-            str8_lit_comp("not_eq"),
-            str8_lit_comp("nullptr"),
-            str8_lit_comp("operator"),
-            str8_lit_comp("or"),
-            str8_lit_comp("or_eq"),
-            str8_lit_comp("private"),
-            str8_lit_comp("protected"),
-            str8_lit_comp("public"),
-            str8_lit_comp("reflexpr"),
-            str8_lit_comp("register"),
-            str8_lit_comp("reinterpret_cast"),
-            str8_lit_comp("requires"),
-            str8_lit_comp("return"),
-            str8_lit_comp("short"),
-            str8_lit_comp("signed"),
-            str8_lit_comp("sizeof"),
-            str8_lit_comp("static"),
-            str8_lit_comp("static_assert"),
-            str8_lit_comp("static_cast"),
-            str8_lit_comp("struct"),
-            str8_lit_comp("switch"),
-            str8_lit_comp("synchronized"),
-            str8_lit_comp("template"),
-            str8_lit_comp("this"),
-            str8_lit_comp("thread_local"),
-            str8_lit_comp("throw"),
-            str8_lit_comp("true"),
-            str8_lit_comp("try"),
-            str8_lit_comp("typedef"),
-            str8_lit_comp("typeid"),
-            str8_lit_comp("typename"),
-            str8_lit_comp("union"),
-            str8_lit_comp("unsigned"),
-            str8_lit_comp("using"),
-            str8_lit_comp("virtual"),
-            str8_lit_comp("void"),
-            str8_lit_comp("volatile"),
-            str8_lit_comp("wchar_t"),
-            str8_lit_comp("while"),
-            str8_lit_comp("xor"),
-            str8_lit_comp("xor_eq"),
-          };
-          String8 token_string = str8_substr(string, r1u64(active_token_start_idx, idx+ender_pad));
-          for(U64 keyword_idx = 0; keyword_idx < ArrayCount(cpp_keywords); keyword_idx += 1)
-          {
-            if(str8_match(cpp_keywords[keyword_idx], token_string, 0))
-            {
-              token.kind = TXT_TokenKind_Keyword;
-              break;
-            }
-          }
-        }
-        
-        // rjf: push
-        txt_token_chunk_list_push(scratch.arena, &tokens, 4096, &token);
-        
-        // rjf: increment by ender padding
-        idx += ender_pad;
+        lo = mid+1;
       }
-      
-      // rjf: advance by 1 byte if we haven't found an ender
-      if(!ender_found)
+      else
       {
-        idx += 1;
+        hi = mid;
       }
-      escaped = next_escaped;
     }
+    result = lo;
+  }
+  return result;
+}
+
+internal TXT_Token
+txt_token_from_packed_token_array_idx(TXT_PackedTokenArray *tokens, U64 idx)
+{
+  TXT_Token result = {0};
+  if(idx < tokens->ranges.count)
+  {
+    result.kind  = (TXT_TokenKind)tokens->kinds[idx];
+    result.range = txt_range_from_packed_range_array_idx(&tokens->ranges, idx);
   }
-  
-  //- rjf: token list -> token array
-  TXT_TokenArray result = txt_token_array_from_chunk_list(arena, &tokens);
-  scratch_end(scratch);
   return result;
 }
 
 internal TXT_TokenArray
-txt_token_array_from_string__odin(Arena *arena, U64 *bytes_processed_counter, String8 string)
+txt_token_array_from_packed_token_array_idx_range(Arena *arena, TXT_PackedTokenArray *tokens, Rng1U64 idx_range)
+{
+  Rng1U64 idx_range_clamped = r1u64(Min(idx_range.min, tokens->ranges.count), Min(idx_range.max, tokens->ranges.count));
+  TXT_TokenArray result = {0};
+  result.count = dim_1u64(idx_range_clamped);
+  result.v = push_array_no_zero(arena, TXT_Token, result.count);
+  for(U64 idx = 0; idx < result.count; idx += 1)
+  {
+    result.v[idx] = txt_token_from_packed_token_array_idx(tokens, idx_range_clamped.min + idx);
+  }
+  return result;
+}
+
+////////////////////////////////
+//~ rjf: Lexing Functions
+
+internal TXT_TokenArray
+txt_token_array_from_string__rules(Arena *arena, U64 *bytes_processed_counter, String8 string, TXT_LexRules *rules)
 {
   Temp scratch = scratch_begin(&arena, 1);
+  TXT_ByteClassFlags *byte_classes = rules->byte_classes;
   
   //- rjf: generate token list
   TXT_TokenChunkList tokens = {0};
   {
     B32 comment_is_single_line = 0;
     B32 string_is_char = 0;
+    B32 string_is_line = 0;
     TXT_TokenKind active_token_kind = TXT_TokenKind_Null;
     U64 active_token_start_idx = 0;
     B32 escaped = 0;
@@ -463,6 +377,7 @@ txt_token_array_from_string__odin(Arena *arena, U64 *bytes_processed_counter, St
     {
       U8 byte      = (idx+0 < string.size) ? (string.str[idx+0]) : 0;
       U8 next_byte = (idx+1 < string.size) ? (string.str[idx+1]) : 0;
+      TXT_ByteClassFlags byte_class = byte_classes[byte];
       
       // rjf: update counter
       if(bytes_processed_counter != 0 && ((idx-byte_process_start_idx) >= 1000 || idx == string.size))
@@ -486,30 +401,20 @@ txt_token_array_from_string__odin(Arena *arena, U64 *bytes_processed_counter, St
       {
         // rjf: use next bytes to start a new token
         if(0){}
-        else if(char_is_space(byte))             { active_token_kind = TXT_TokenKind_Whitespace; }
-        else if(byte == '_' ||
-                byte == '$' ||
-                char_is_alpha(byte))             { active_token_kind = TXT_TokenKind_Identifier; }
-        else if(char_is_digit(byte, 10) ||
+        else if(byte_class & TXT_ByteClassFlag_Whitespace) { active_token_kind = TXT_TokenKind_Whitespace; }
+        else if(byte_class & TXT_ByteClassFlag_IdentStart) { active_token_kind = TXT_TokenKind_Identifier; }
+        else if(byte_class & TXT_ByteClassFlag_Digit ||
                 (byte == '.' &&
-                 char_is_digit(next_byte, 10)))  { active_token_kind = TXT_TokenKind_Numeric; }
-        else if(byte == '"')                     { active_token_kind = TXT_TokenKind_String; string_is_char = 0; }
-        else if(byte == '\'')                    { active_token_kind = TXT_TokenKind_String; string_is_char = 1; }
-        else if(byte == '/' && next_byte == '/') { active_token_kind = TXT_TokenKind_Comment; comment_is_single_line = 1; }
-        else if(byte == '/' && next_byte == '*') { active_token_kind = TXT_TokenKind_Comment; comment_is_single_line = 0; }
-        else if(byte == '~' || byte == '!' ||
-                byte == '%' || byte == '^' ||
-                byte == '&' || byte == '*' ||
-                byte == '(' || byte == ')' ||
-                byte == '-' || byte == '=' ||
-                byte == '+' || byte == '[' ||
-                byte == ']' || byte == '{' ||
-                byte == '}' || byte == ':' ||
-                byte == ';' || byte == ',' ||
-                byte == '.' || byte == '<' ||
-                byte == '>' || byte == '/' ||
-                byte == '?' || byte == '|')      { active_token_kind = TXT_TokenKind_Symbol; }
-        else if(byte == '#')                     { active_token_kind = TXT_TokenKind_Meta; }
+                 byte_classes[next_byte] & TXT_ByteClassFlag_Digit)) { active_token_kind = TXT_TokenKind_Numeric; }
+        else if(byte == '"')                               { active_token_kind = TXT_TokenKind_String; string_is_char = 0; }
+        else if(byte == '\'')                              { active_token_kind = TXT_TokenKind_String; string_is_char = 1; }
+        else if(rules->flags & TXT_LexRuleFlag_LineStrings &&
+                byte == '\\' && next_byte == '\\')          { active_token_kind = TXT_TokenKind_String; string_is_line = 1; }
+        else if(byte == '/' && next_byte == '/')           { active_token_kind = TXT_TokenKind_Comment; comment_is_single_line = 1; }
+        else if(rules->flags & TXT_LexRuleFlag_BlockComments &&
+                byte == '/' && next_byte == '*')           { active_token_kind = TXT_TokenKind_Comment; comment_is_single_line = 0; }
+        else if(byte_class & TXT_ByteClassFlag_Symbol)     { active_token_kind = TXT_TokenKind_Symbol; }
+        else if(byte_class & TXT_ByteClassFlag_Meta)       { active_token_kind = TXT_TokenKind_Meta; }
         
         // rjf: start new token
         if(active_token_kind != TXT_TokenKind_Null)
@@ -540,35 +445,31 @@ txt_token_array_from_string__odin(Arena *arena, U64 *bytes_processed_counter, St
           default:break;
           case TXT_TokenKind_Whitespace:
           {
-            ender_found = !char_is_space(byte);
+            ender_found = !(byte_class & TXT_ByteClassFlag_Whitespace);
           }break;
           case TXT_TokenKind_Identifier:
           {
-            ender_found = (!char_is_alpha(byte) && !char_is_digit(byte, 10) && byte != '_' && byte != '$');
+            ender_found = !(byte_class & TXT_ByteClassFlag_IdentContinue);
           }break;
           case TXT_TokenKind_Numeric:
           {
-            ender_found = (!char_is_alpha(byte) && !char_is_digit(byte, 10) && byte != '_' && byte != '.' && byte != '\'');
+            ender_found = !(byte_class & TXT_ByteClassFlag_NumericContinue);
           }break;
           case TXT_TokenKind_String:
           {
-            ender_found = (!escaped && ((!string_is_char && byte == '"') || (string_is_char && byte == '\'')));
-            ender_pad += 1;
+            if(string_is_line)
+            {
+              ender_found = (!escaped && (byte == '\r' || byte == '\n'));
+            }
+            else
+            {
+              ender_found = (!escaped && ((!string_is_char && byte == '"') || (string_is_char && byte == '\'')));
+              ender_pad += 1;
+            }
           }break;
           case TXT_TokenKind_Symbol:
           {
-            ender_found = (byte != '~' && byte != '!' &&
-                           byte != '%' && byte != '^' &&
-                           byte != '&' && byte != '*' &&
-                           byte != '(' && byte != ')' &&
-                           byte != '-' && byte != '=' &&
-                           byte != '+' && byte != '[' &&
-                           byte != ']' && byte != '{' &&
-                           byte != '}' && byte != ':' &&
-                           byte != ';' && byte != ',' &&
-                           byte != '.' && byte != '<' &&
-                           byte != '>' && byte != '/' &&
-                           byte != '?' && byte != '|');
+            ender_found = !(byte_class & TXT_ByteClassFlag_SymbolContinue);
           }break;
           case TXT_TokenKind_Comment:
           {
@@ -584,7 +485,14 @@ txt_token_array_from_string__odin(Arena *arena, U64 *bytes_processed_counter, St
           }break;
           case TXT_TokenKind_Meta:
           {
-            ender_found = (!char_is_alpha(byte) && !char_is_digit(byte, 10) && byte != '_' && byte != '$');
+            if(rules->flags & TXT_LexRuleFlag_MetaSpansLine)
+            {
+              ender_found = (!escaped && (byte == '\r' || byte == '\n'));
+            }
+            else
+            {
+              ender_found = !(byte_class & TXT_ByteClassFlag_IdentContinue);
+            }
           }break;
         }
       }
@@ -596,60 +504,9 @@ txt_token_array_from_string__odin(Arena *arena, U64 *bytes_processed_counter, St
         active_token_kind = TXT_TokenKind_Null;
         
         // rjf: identifier -> keyword in special cases
-        if(token.kind == TXT_TokenKind_Identifier)
+        if(token.kind == TXT_TokenKind_Identifier && rules->keyword_match(str8_substr(string, token.range)))
         {
-          read_only local_persist String8 odin_keywords[] =
-          {
-            str8_lit_comp("align_of"),
-            str8_lit_comp("asm"),
-            str8_lit_comp("auto_cast"),
-            str8_lit_comp("bit_set"),
-            str8_lit_comp("break"),
-            str8_lit_comp("case"),
-            str8_lit_comp("cast"),
-            str8_lit_comp("context"),
-            str8_lit_comp("continue"),
-            str8_lit_comp("defer"),
-            str8_lit_comp("distinct"),
-            str8_lit_comp("do"),
-            str8_lit_comp("dynamic"),
-            str8_lit_comp("else"),
-            str8_lit_comp("enum"),
-            str8_lit_comp("fallthrough"),
-            str8_lit_comp("for"),
-            str8_lit_comp("foreign"),
-            str8_lit_comp("if"),
-            str8_lit_comp("in"),
-            str8_lit_comp("map"),
-            str8_lit_comp("matrix"),
-            str8_lit_comp("not_in"),
-            str8_lit_comp("or_break"),
-            str8_lit_comp("or_continue"),
-            str8_lit_comp("or_else"),
-            str8_lit_comp("or_return"),
-            str8_lit_comp("package"),
-            str8_lit_comp("proc"),
-            str8_lit_comp("return"),
-            str8_lit_comp("size_of"),
-            str8_lit_comp("struct"),
-            str8_lit_comp("switch"),
-            str8_lit_comp("transmute"),
-            str8_lit_comp("typeid"),
-            str8_lit_comp("union"),
-            str8_lit_comp("using"),
-            str8_lit_comp("when"),
-            str8_lit_comp("where"),
-            str8_lit_comp("import"),
-          };
-          String8 token_string = str8_substr(string, r1u64(active_token_start_idx, idx+ender_pad));
-          for(U64 keyword_idx = 0; keyword_idx < ArrayCount(odin_keywords); keyword_idx += 1)
-          {
-            if(str8_match(odin_keywords[keyword_idx], token_string, 0))
-            {
-              token.kind = TXT_TokenKind_Keyword;
-              break;
-            }
-          }
+          token.kind = TXT_TokenKind_Keyword;
         }
         
         // rjf: push
@@ -674,492 +531,52 @@ txt_token_array_from_string__odin(Arena *arena, U64 *bytes_processed_counter, St
   return result;
 }
 
+internal TXT_TokenArray
+txt_token_array_from_string__c_cpp(Arena *arena, U64 *bytes_processed_counter, String8 string)
+{
+  return txt_token_array_from_string__rules(arena, bytes_processed_counter, string, &txt_lex_rules__c_cpp);
+}
+
+internal TXT_TokenArray
+txt_token_array_from_string__odin(Arena *arena, U64 *bytes_processed_counter, String8 string)
+{
+  return txt_token_array_from_string__rules(arena, bytes_processed_counter, string, &txt_lex_rules__odin);
+}
+
 internal TXT_TokenArray
 txt_token_array_from_string__jai(Arena *arena, U64 *bytes_processed_counter, String8 string)
+{
+  return txt_token_array_from_string__rules(arena, bytes_processed_counter, string, &txt_lex_rules__jai);
+}
+
+internal TXT_TokenArray
+txt_token_array_from_string__zig(Arena *arena, U64 *bytes_processed_counter, String8 string)
+{
+  return txt_token_array_from_string__rules(arena, bytes_processed_counter, string, &txt_lex_rules__zig);
+}
+
+internal TXT_TokenArray
+txt_token_array_from_string__disasm_x64_intel(Arena *arena, U64 *bytes_processed_counter, String8 string)
 {
   Temp scratch = scratch_begin(&arena, 1);
   
-  //- rjf: generate token list
+  //- rjf: parse tokens
   TXT_TokenChunkList tokens = {0};
   {
-    B32 comment_is_single_line = 0;
-    B32 string_is_char = 0;
     TXT_TokenKind active_token_kind = TXT_TokenKind_Null;
-    U64 active_token_start_idx = 0;
+    U64 active_token_start_off = 0;
+    U64 off = 0;
     B32 escaped = 0;
-    B32 next_escaped = 0;
-    U64 byte_process_start_idx = 0;
-    for(U64 idx = 0; idx <= string.size;)
+    B32 string_is_char = 0;
+    S32 brace_nest = 0;
+    S32 paren_nest = 0;
+    for(U64 advance = 0; off <= string.size; off += advance)
     {
-      U8 byte      = (idx+0 < string.size) ? (string.str[idx+0]) : 0;
-      U8 next_byte = (idx+1 < string.size) ? (string.str[idx+1]) : 0;
-      
-      // rjf: update counter
-      if(bytes_processed_counter != 0 && ((idx-byte_process_start_idx) >= 1000 || idx == string.size))
-      {
-        ins_atomic_u64_add_eval(bytes_processed_counter, (idx-byte_process_start_idx));
-        byte_process_start_idx = idx;
-      }
-      
-      // rjf: escaping
-      if(escaped && (byte != '\r' && byte != '\n'))
-      {
-        next_escaped = 0;
-      }
-      else if(!escaped && byte == '\\')
-      {
-        next_escaped = 1;
-      }
-      
-      // rjf: take starter, determine active token kind
-      if(active_token_kind == TXT_TokenKind_Null)
-      {
-        // rjf: use next bytes to start a new token
-        if(0){}
-        else if(char_is_space(byte))             { active_token_kind = TXT_TokenKind_Whitespace; }
-        else if(byte == '_' ||
-                byte == '$' ||
-                char_is_alpha(byte))             { active_token_kind = TXT_TokenKind_Identifier; }
-        else if(char_is_digit(byte, 10) ||
-                (byte == '.' &&
-                 char_is_digit(next_byte, 10)))  { active_token_kind = TXT_TokenKind_Numeric; }
-        else if(byte == '"')                     { active_token_kind = TXT_TokenKind_String; string_is_char = 0; }
-        else if(byte == '\'')                    { active_token_kind = TXT_TokenKind_String; string_is_char = 1; }
-        else if(byte == '/' && next_byte == '/') { active_token_kind = TXT_TokenKind_Comment; comment_is_single_line = 1; }
-        else if(byte == '/' && next_byte == '*') { active_token_kind = TXT_TokenKind_Comment; comment_is_single_line = 0; }
-        else if(byte == '~' || byte == '!' ||
-                byte == '%' || byte == '^' ||
-                byte == '&' || byte == '*' ||
-                byte == '(' || byte == ')' ||
-                byte == '-' || byte == '=' ||
-                byte == '+' || byte == '[' ||
-                byte == ']' || byte == '{' ||
-                byte == '}' || byte == ':' ||
-                byte == ';' || byte == ',' ||
-                byte == '.' || byte == '<' ||
-                byte == '>' || byte == '/' ||
-                byte == '?' || byte == '|')      { active_token_kind = TXT_TokenKind_Symbol; }
-        else if(byte == '#')                     { active_token_kind = TXT_TokenKind_Meta; }
-        
-        // rjf: start new token
-        if(active_token_kind != TXT_TokenKind_Null)
-        {
-          active_token_start_idx = idx;
-        }
-        
-        // rjf: invalid token kind -> emit error
-        else
-        {
-          TXT_Token token = {TXT_TokenKind_Error, r1u64(idx, idx+1)};
-          txt_token_chunk_list_push(scratch.arena, &tokens, 4096, &token);
-        }
-      }
-      
-      // rjf: look for ender
-      U64 ender_pad = 0;
-      B32 ender_found = 0;
-      if(active_token_kind != TXT_TokenKind_Null && idx>active_token_start_idx)
-      {
-        if(idx == string.size)
-        {
-          ender_pad = 0;
-          ender_found = 1;
-        }
-        else switch(active_token_kind)
-        {
-          default:break;
-          case TXT_TokenKind_Whitespace:
-          {
-            ender_found = !char_is_space(byte);
-          }break;
-          case TXT_TokenKind_Identifier:
-          {
-            ender_found = (!char_is_alpha(byte) && !char_is_digit(byte, 10) && byte != '_' && byte != '$');
-          }break;
-          case TXT_TokenKind_Numeric:
-          {
-            ender_found = (!char_is_alpha(byte) && !char_is_digit(byte, 10) && byte != '_' && byte != '.' && byte != '\'');
-          }break;
-          case TXT_TokenKind_String:
-          {
-            ender_found = (!escaped && ((!string_is_char && byte == '"') || (string_is_char && byte == '\'')));
-            ender_pad += 1;
-          }break;
-          case TXT_TokenKind_Symbol:
-          {
-            ender_found = (byte != '~' && byte != '!' &&
-                           byte != '%' && byte != '^' &&
-                           byte != '&' && byte != '*' &&
-                           byte != '(' && byte != ')' &&
-                           byte != '-' && byte != '=' &&
-                           byte != '+' && byte != '[' &&
-                           byte != ']' && byte != '{' &&
-                           byte != '}' && byte != ':' &&
-                           byte != ';' && byte != ',' &&
-                           byte != '.' && byte != '<' &&
-                           byte != '>' && byte != '/' &&
-                           byte != '?' && byte != '|');
-          }break;
-          case TXT_TokenKind_Comment:
-          {
-            if(comment_is_single_line)
-            {
-              ender_found = (!escaped && (byte == '\r' || byte == '\n'));
-            }
-            else
-            {
-              ender_found = (active_token_start_idx+1 < idx && byte == '*' && next_byte == '/');
-              ender_pad += 2;
-            }
-          }break;
-          case TXT_TokenKind_Meta:
-          {
-            ender_found = (!char_is_alpha(byte) && !char_is_digit(byte, 10) && byte != '_' && byte != '$');
-          }break;
-        }
-      }
-      
-      // rjf: next byte is ender => emit token
-      if(ender_found)
-      {
-        TXT_Token token = {active_token_kind, r1u64(active_token_start_idx, idx+ender_pad)};
-        active_token_kind = TXT_TokenKind_Null;
-        
-        // rjf: identifier -> keyword in special cases
-        if(token.kind == TXT_TokenKind_Identifier)
-        {
-          read_only local_persist String8 jai_keywords[] =
-          {
-            str8_lit_comp("bool"),
-            str8_lit_comp("true"),
-            str8_lit_comp("false"),
-            str8_lit_comp("int"),
-            str8_lit_comp("s8"),
-            str8_lit_comp("u8"),
-            str8_lit_comp("s16"),
-            str8_lit_comp("u16"),
-            str8_lit_comp("s32"),
-            str8_lit_comp("u32"),
-            str8_lit_comp("s64"),
-            str8_lit_comp("u64"),
-            str8_lit_comp("s128"),
-            str8_lit_comp("u128"),
-            str8_lit_comp("float"),
-            str8_lit_comp("float32"),
-            str8_lit_comp("float64"),
-            str8_lit_comp("void"),
-            str8_lit_comp("enum"),
-            str8_lit_comp("enum_flags"),
-            str8_lit_comp("size_of"),
-            str8_lit_comp("string"),
-            str8_lit_comp("type_of"),
-            str8_lit_comp("cast"),
-            str8_lit_comp("if"),
-            str8_lit_comp("ifs"),
-            str8_lit_comp("then"),
-            str8_lit_comp("else"),
-            str8_lit_comp("case"),
-            str8_lit_comp("for"),
-            str8_lit_comp("while"),
-            str8_lit_comp("break"),
-            str8_lit_comp("continue"),
-            str8_lit_comp("remove"),
-            str8_lit_comp("return"),
-            str8_lit_comp("inline"),
-            str8_lit_comp("null"),
-            str8_lit_comp("defer"),
-            str8_lit_comp("xx"),
-          };
-          String8 token_string = str8_substr(string, r1u64(active_token_start_idx, idx+ender_pad));
-          for(U64 keyword_idx = 0; keyword_idx < ArrayCount(jai_keywords); keyword_idx += 1)
-          {
-            if(str8_match(jai_keywords[keyword_idx], token_string, 0))
-            {
-              token.kind = TXT_TokenKind_Keyword;
-              break;
-            }
-          }
-        }
-        
-        // rjf: push
-        txt_token_chunk_list_push(scratch.arena, &tokens, 4096, &token);
-        
-        // rjf: increment by ender padding
-        idx += ender_pad;
-      }
-      
-      // rjf: advance by 1 byte if we haven't found an ender
-      if(!ender_found)
-      {
-        idx += 1;
-      }
-      escaped = next_escaped;
-    }
-  }
-  
-  //- rjf: token list -> token array
-  TXT_TokenArray result = txt_token_array_from_chunk_list(arena, &tokens);
-  scratch_end(scratch);
-  return result;
-}
-
-internal TXT_TokenArray
-txt_token_array_from_string__zig(Arena *arena, U64 *bytes_processed_counter, String8 string)
-{
-  Temp scratch = scratch_begin(&arena, 1);
-  
-  //- rjf: generate token list
-  TXT_TokenChunkList tokens = {0};
-  {
-    B32 string_is_char = 0;
-    B32 string_is_line = 0;
-    TXT_TokenKind active_token_kind = TXT_TokenKind_Null;
-    U64 active_token_start_idx = 0;
-    B32 escaped = 0;
-    B32 next_escaped = 0;
-    U64 byte_process_start_idx = 0;
-    for(U64 idx = 0; idx <= string.size;)
-    {
-      U8 byte        = (idx+0 < string.size) ? (string.str[idx+0]) : 0;
-      U8 next_byte   = (idx+1 < string.size) ? (string.str[idx+1]) : 0;
-      
-      // rjf: update counter
-      if(bytes_processed_counter != 0 && ((idx-byte_process_start_idx) >= 1000 || idx == string.size))
-      {
-        ins_atomic_u64_add_eval(bytes_processed_counter, (idx-byte_process_start_idx));
-        byte_process_start_idx = idx;
-      }
-      
-      // rjf: escaping
-      if(escaped && (byte != '\r' && byte != '\n'))
-      {
-        next_escaped = 0;
-      }
-      else if(!escaped && byte == '\\')
-      {
-        next_escaped = 1;
-      }
-      
-      // rjf: take starter, determine active token kind
-      if(active_token_kind == TXT_TokenKind_Null)
-      {
-        // rjf: use next bytes to start a new token
-        if(0){}
-        else if(char_is_space(byte))             { active_token_kind = TXT_TokenKind_Whitespace; }
-        else if(byte == '_' ||
-                char_is_alpha(byte))             { active_token_kind = TXT_TokenKind_Identifier; }
-        else if(char_is_digit(byte, 10) ||
-                (byte == '.' &&
-                 char_is_digit(next_byte, 10)))  { active_token_kind = TXT_TokenKind_Numeric; }
-        else if(byte == '"')                     { active_token_kind = TXT_TokenKind_String; string_is_char = 0; }
-        else if(byte == '\'')                    { active_token_kind = TXT_TokenKind_String; string_is_char = 1; }
-        else if(byte == '\\' &&
-                next_byte == '\\')               { active_token_kind = TXT_TokenKind_String; string_is_line = 1; }
-        else if(byte == '/' && next_byte == '/') { active_token_kind = TXT_TokenKind_Comment; }
-        else if(byte == '~' || byte == '!' ||
-                byte == '%' || byte == '^' ||
-                byte == '&' || byte == '*' ||
-                byte == '(' || byte == ')' ||
-                byte == '-' || byte == '=' ||
-                byte == '+' || byte == '[' ||
-                byte == ']' || byte == '{' ||
-                byte == '}' || byte == ':' ||
-                byte == ';' || byte == ',' ||
-                byte == '.' || byte == '<' ||
-                byte == '>' || byte == '/' ||
-                byte == '?' || byte == '|' ||
-                byte == 'c')                     { active_token_kind = TXT_TokenKind_Symbol; }
-        
-        // rjf: start new token
-        if(active_token_kind != TXT_TokenKind_Null)
-        {
-          active_token_start_idx = idx;
-        }
-        
-        // rjf: invalid token kind -> emit error
-        else
-        {
-          TXT_Token token = {TXT_TokenKind_Error, r1u64(idx, idx+1)};
-          txt_token_chunk_list_push(scratch.arena, &tokens, 4096, &token);
-        }
-      }
-      
-      // rjf: look for ender
-      U64 ender_pad = 0;
-      B32 ender_found = 0;
-      if(active_token_kind != TXT_TokenKind_Null && idx>active_token_start_idx)
-      {
-        if(idx == string.size)
-        {
-          ender_pad = 0;
-          ender_found = 1;
-        }
-        else switch(active_token_kind)
-        {
-          default:break;
-          case TXT_TokenKind_Whitespace:
-          {
-            ender_found = !char_is_space(byte);
-          }break;
-          case TXT_TokenKind_Identifier:
-          {
-            ender_found = (!char_is_alpha(byte) && !char_is_digit(byte, 10) && byte != '_' && byte != '$');
-          }break;
-          case TXT_TokenKind_Numeric:
-          {
-            ender_found = (!char_is_alpha(byte) && !char_is_digit(byte, 10) && byte != '_' && byte != '.' && byte != '\'');
-          }break;
-          case TXT_TokenKind_String:
-          {
-            if (string_is_line)
-            {
-              ender_found = (!escaped && (byte == '\r' || byte == '\n'));
-            }
-            else
-            {
-              ender_found = (!escaped && ((!string_is_char && byte == '"') || (string_is_char && byte == '\'')));
-              ender_pad += 1;
-            }
-          }break;
-          case TXT_TokenKind_Symbol:
-          {
-            ender_found = (byte != '~' && byte != '!' &&
-                           byte != '%' && byte != '^' &&
-                           byte != '&' && byte != '*' &&
-                           byte != '(' && byte != ')' &&
-                           byte != '-' && byte != '=' &&
-                           byte != '+' && byte != '[' &&
-                           byte != ']' && byte != '{' &&
-                           byte != '}' && byte != ':' &&
-                           byte != ';' && byte != ',' &&
-                           byte != '.' && byte != '<' &&
-                           byte != '>' && byte != '/' &&
-                           byte != '?' && byte != '|' &&
-                           byte != 'c');
-          }break;
-          case TXT_TokenKind_Comment:
-          {
-            ender_found = (!escaped && (byte == '\r' || byte == '\n'));
-          }break;
-        }
-      }
-      
-      // rjf: next byte is ender => emit token
-      if(ender_found)
-      {
-        TXT_Token token = {active_token_kind, r1u64(active_token_start_idx, idx+ender_pad)};
-        active_token_kind = TXT_TokenKind_Null;
-        
-        // rjf: identifier -> keyword in special cases
-        if(token.kind == TXT_TokenKind_Identifier)
-        {
-          read_only local_persist String8 zig_keywords[] =
-          {
-            str8_lit_comp("addrspace"),
-            str8_lit_comp("align"),
-            str8_lit_comp("allowzero"),
-            str8_lit_comp("and"),
-            str8_lit_comp("anyframe"),
-            str8_lit_comp("anytype"),
-            str8_lit_comp("asm"),
-            str8_lit_comp("async"),
-            str8_lit_comp("await"),
-            str8_lit_comp("break"),
-            str8_lit_comp("callconv"),
-            str8_lit_comp("catch"),
-            str8_lit_comp("comptime"),
-            str8_lit_comp("const"),
-            str8_lit_comp("continue"),
-            str8_lit_comp("defer"),
-            str8_lit_comp("else"),
-            str8_lit_comp("enum"),
-            str8_lit_comp("errdefer"),
-            str8_lit_comp("error"),
-            str8_lit_comp("export"),
-            str8_lit_comp("extern"),
-            str8_lit_comp("fn"),
-            str8_lit_comp("for"),
-            str8_lit_comp("if"),
-            str8_lit_comp("inline"),
-            str8_lit_comp("noalias"),
-            str8_lit_comp("nosuspend"),
-            str8_lit_comp("noinline"),
-            str8_lit_comp("opaque"),
-            str8_lit_comp("or"),
-            str8_lit_comp("orelse"),
-            str8_lit_comp("packed"),
-            str8_lit_comp("pub"),
-            str8_lit_comp("resume"),
-            str8_lit_comp("return"),
-            str8_lit_comp("linksection"),
-            str8_lit_comp("struct"),
-            str8_lit_comp("suspend"),
-            str8_lit_comp("switch"),
-            str8_lit_comp("test"),
-            str8_lit_comp("threadlocal"),
-            str8_lit_comp("try"),
-            str8_lit_comp("union"),
-            str8_lit_comp("unreachable"),
-            str8_lit_comp("usingnamespace"),
-            str8_lit_comp("var"),
-            str8_lit_comp("volatile"),
-            str8_lit_comp("while"),
-          };
-          String8 token_string = str8_substr(string, r1u64(active_token_start_idx, idx+ender_pad));
-          for(U64 keyword_idx = 0; keyword_idx < ArrayCount(zig_keywords); keyword_idx += 1)
-          {
-            if(str8_match(zig_keywords[keyword_idx], token_string, 0))
-            {
-              token.kind = TXT_TokenKind_Keyword;
-              break;
-            }
-          }
-        }
-        
-        // rjf: push
-        txt_token_chunk_list_push(scratch.arena, &tokens, 4096, &token);
-        
-        // rjf: increment by ender padding
-        idx += ender_pad;
-      }
-      
-      // rjf: advance by 1 byte if we haven't found an ender
-      if(!ender_found)
-      {
-        idx += 1;
-      }
-      escaped = next_escaped;
-    }
-  }
-  
-  //- rjf: token list -> token array
-  TXT_TokenArray result = txt_token_array_from_chunk_list(arena, &tokens);
-  scratch_end(scratch);
-  return result;
-}
-
-internal TXT_TokenArray
-txt_token_array_from_string__disasm_x64_intel(Arena *arena, U64 *bytes_processed_counter, String8 string)
-{
-  Temp scratch = scratch_begin(&arena, 1);
-  
-  //- rjf: parse tokens
-  TXT_TokenChunkList tokens = {0};
-  {
-    TXT_TokenKind active_token_kind = TXT_TokenKind_Null;
-    U64 active_token_start_off = 0;
-    U64 off = 0;
-    B32 escaped = 0;
-    B32 string_is_char = 0;
-    S32 brace_nest = 0;
-    S32 paren_nest = 0;
-    for(U64 advance = 0; off <= string.size; off += advance)
-    {
-      U8 byte      = (off+0 < string.size) ? string.str[off+0] : 0;
-      U8 next_byte = (off+1 < string.size) ? string.str[off+1] : 0;
-      B32 ender_found = 0;
-      advance = (active_token_kind != TXT_TokenKind_Null ? 1 : 0);
-      if(off == string.size && active_token_kind != TXT_TokenKind_Null)
+      U8 byte      = (off+0 < string.size) ? string.str[off+0] : 0;
+      U8 next_byte = (off+1 < string.size) ? string.str[off+1] : 0;
+      B32 ender_found = 0;
+      advance = (active_token_kind != TXT_TokenKind_Null ? 1 : 0);
+      if(off == string.size && active_token_kind != TXT_TokenKind_Null)
       {
         ender_found = 1;
         advance = 1;
@@ -1315,75 +732,662 @@ txt_token_array_from_string__disasm_x64_intel(Arena *arena, U64 *bytes_processed
           advance = 1;
         }break;
       }
-      if(ender_found != 0)
+      if(ender_found != 0)
+      {
+        if(brace_nest != 0 && active_token_kind == TXT_TokenKind_Keyword)
+        {
+          active_token_kind = TXT_TokenKind_Numeric;
+        }
+        if(paren_nest != 0 && active_token_kind == TXT_TokenKind_Keyword)
+        {
+          active_token_kind = TXT_TokenKind_Identifier;
+        }
+        TXT_Token token = {active_token_kind, r1u64(active_token_start_off, off+advance)};
+        txt_token_chunk_list_push(arena, &tokens, 1024, &token);
+        active_token_kind = TXT_TokenKind_Null;
+        active_token_start_off = token.range.max;
+      }
+    }
+  }
+  
+  //- rjf: token list -> token array
+  TXT_TokenArray result = txt_token_array_from_chunk_list(arena, &tokens);
+  scratch_end(scratch);
+  return result;
+}
+
+////////////////////////////////
+//~ rjf: Line Scanning Functions
+
+internal void
+txt_line_end_masks_from_block(U8 *block, U64 size, U64 *lf_mask_out, U64 *cr_mask_out)
+{
+  U64 lf_mask = 0;
+  U64 cr_mask = 0;
+#if ARCH_X64
+  if(size == TXT_LINE_SCAN_BLOCK_SIZE)
+  {
+    __m128i lf = _mm_set1_epi8('\n');
+    __m128i cr = _mm_set1_epi8('\r');
+    for(U64 lane_idx = 0; lane_idx < TXT_LINE_SCAN_BLOCK_SIZE/16; lane_idx += 1)
+    {
+      __m128i bytes = _mm_loadu_si128((__m128i *)(block + lane_idx*16));
+      lf_mask |= (U64)(U32)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, lf)) << (lane_idx*16);
+      cr_mask |= (U64)(U32)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, cr)) << (lane_idx*16);
+    }
+  }
+  else
+#endif
+  {
+    for(U64 idx = 0; idx < size; idx += 1)
+    {
+      lf_mask |= (U64)(block[idx] == '\n') << idx;
+      cr_mask |= (U64)(block[idx] == '\r') << idx;
+    }
+  }
+  *lf_mask_out = lf_mask;
+  *cr_mask_out = cr_mask;
+}
+
+internal TXT_LineEndCounts
+txt_line_end_counts_from_data(U64 *bytes_processed_counter, String8 data)
+{
+  U64 lf_count = 0;
+  U64 cr_count = 0;
+  U64 crlf_count = 0;
+  U64 cr_carry = 0;
+  U64 progress_off = 0;
+  for(U64 off = 0; off < data.size; off += TXT_LINE_SCAN_BLOCK_SIZE)
+  {
+    U64 lf_mask = 0;
+    U64 cr_mask = 0;
+    txt_line_end_masks_from_block(data.str + off, Min(data.size - off, TXT_LINE_SCAN_BLOCK_SIZE), &lf_mask, &cr_mask);
+    lf_count   += count_bits_set64(lf_mask);
+    cr_count   += count_bits_set64(cr_mask);
+    crlf_count += count_bits_set64(((cr_mask << 1) | cr_carry) & lf_mask);
+    cr_carry = cr_mask >> 63;
+    if(bytes_processed_counter != 0 && off - progress_off >= TXT_LINE_SCAN_PROGRESS_GRANULARITY)
+    {
+      ins_atomic_u64_add_eval(bytes_processed_counter, off - progress_off);
+      progress_off = off;
+    }
+  }
+  if(bytes_processed_counter != 0)
+  {
+    ins_atomic_u64_add_eval(bytes_processed_counter, data.size - progress_off);
+  }
+  TXT_LineEndCounts counts = {lf_count - crlf_count, crlf_count, cr_count - crlf_count};
+  return counts;
+}
+
+internal TXT_LineEndKind
+txt_line_end_kind_from_counts(TXT_LineEndCounts counts)
+{
+  TXT_LineEndKind kind = TXT_LineEndKind_Null;
+  if(counts.crlf_count > counts.lf_count)
+  {
+    kind = TXT_LineEndKind_CRLF;
+  }
+  else if(counts.lf_count != 0)
+  {
+    kind = TXT_LineEndKind_LF;
+  }
+  return kind;
+}
+
+internal U64
+txt_line_count_from_line_end_counts(TXT_LineEndCounts counts)
+{
+  U64 result = 1 + counts.lf_count + counts.crlf_count + counts.cr_count;
+  return result;
+}
+
+internal U64
+txt_line_ranges_from_data(U64 *bytes_processed_counter, String8 data, Rng1U64 *lines_out, U64 lines_count)
+{
+  U64 lines_max_size = 0;
+  U64 line_idx = 0;
+  U64 line_start_off = 0;
+  U64 cr_carry = 0;
+  U64 progress_off = 0;
+  for(U64 off = 0; off < data.size && line_idx+1 < lines_count; off += TXT_LINE_SCAN_BLOCK_SIZE)
+  {
+    //- rjf: block -> mask of line ending starts; the \n of a \r\n is skipped
+    U64 lf_mask = 0;
+    U64 cr_mask = 0;
+    txt_line_end_masks_from_block(data.str + off, Min(data.size - off, TXT_LINE_SCAN_BLOCK_SIZE), &lf_mask, &cr_mask);
+    U64 crlf_lf_mask = ((cr_mask << 1) | cr_carry) & lf_mask;
+    U64 break_mask = (lf_mask | cr_mask) & ~crlf_lf_mask;
+    cr_carry = cr_mask >> 63;
+    
+    //- rjf: visit line endings
+    for(;break_mask != 0 && line_idx+1 < lines_count; break_mask &= break_mask-1)
+    {
+      U64 break_off = off + ctz64(break_mask);
+      Rng1U64 line_range = r1u64(line_start_off, break_off);
+      lines_out[line_idx] = line_range;
+      lines_max_size = Max(lines_max_size, dim_1u64(line_range));
+      line_idx += 1;
+      line_start_off = break_off+1;
+      if(data.str[break_off] == '\r' && break_off+1 < data.size && data.str[break_off+1] == '\n')
+      {
+        line_start_off += 1;
+      }
+    }
+    
+    //- rjf: bump progress
+    if(bytes_processed_counter != 0 && off - progress_off >= TXT_LINE_SCAN_PROGRESS_GRANULARITY)
+    {
+      ins_atomic_u64_add_eval(bytes_processed_counter, off - progress_off);
+      progress_off = off;
+    }
+  }
+  
+  //- rjf: last line runs to the end of the data
+  if(line_idx < lines_count)
+  {
+    Rng1U64 line_range = r1u64(Min(line_start_off, data.size), data.size);
+    lines_out[line_idx] = line_range;
+    lines_max_size = Max(lines_max_size, dim_1u64(line_range));
+  }
+  if(bytes_processed_counter != 0)
+  {
+    ins_atomic_u64_add_eval(bytes_processed_counter, data.size - progress_off);
+  }
+  return lines_max_size;
+}
+
+////////////////////////////////
+//~ rjf: Parallel Lexing
+
+internal U64 *
+txt_lex_split_offs_from_data(Arena *arena, String8 data, U64 split_count_max, U64 *split_count_out)
+{
+  // NOTE(rjf): this only approximates the lexers - enough to pick line starts
+  // which are likely outside of comments & strings. splits are verified later.
+  U64 *splits = push_array_no_zero(arena, U64, split_count_max);
+  U64 split_count = 0;
+  U64 piece_size = data.size/(split_count_max+1);
+  U64 next_split_min = piece_size;
+  B32 in_block_comment = 0;
+  B32 in_line_comment = 0;
+  U8 string_quote = 0;
+  for(U64 idx = 0; idx < data.size && split_count < split_count_max; idx += 1)
+  {
+    U8 byte      = data.str[idx];
+    U8 next_byte = (idx+1 < data.size) ? data.str[idx+1] : 0;
+    if(in_block_comment)
+    {
+      if(byte == '*' && next_byte == '/')
       {
-        if(brace_nest != 0 && active_token_kind == TXT_TokenKind_Keyword)
+        in_block_comment = 0;
+        idx += 1;
+      }
+    }
+    else if(string_quote != 0)
+    {
+      if(byte == '\\')
+      {
+        idx += 1;
+      }
+      else if(byte == string_quote)
+      {
+        string_quote = 0;
+      }
+    }
+    else if(byte == '\\')
+    {
+      idx += 1;
+    }
+    else if(byte == '\n' || byte == '\r')
+    {
+      // rjf: line start -> take split if this is far enough along
+      in_line_comment = 0;
+      U64 line_start_off = idx+1;
+      if(byte == '\r' && next_byte == '\n')
+      {
+        line_start_off += 1;
+      }
+      if(line_start_off >= next_split_min && line_start_off < data.size &&
+         !char_is_space(data.str[line_start_off]) && data.str[line_start_off] != '\\')
+      {
+        splits[split_count] = line_start_off;
+        split_count += 1;
+        next_split_min = line_start_off + piece_size;
+      }
+    }
+    else if(!in_line_comment)
+    {
+      if(byte == '/' && next_byte == '*')
+      {
+        in_block_comment = 1;
+        idx += 1;
+      }
+      else if(byte == '/' && next_byte == '/')
+      {
+        in_line_comment = 1;
+        idx += 1;
+      }
+      else if(byte == '"' || (byte == '\'' && (idx == 0 || (!char_is_alpha(data.str[idx-1]) && !char_is_digit(data.str[idx-1], 10)))))
+      {
+        string_quote = byte;
+      }
+    }
+  }
+  *split_count_out = split_count;
+  return splits;
+}
+
+internal void
+txt_lex_shared_release(TXT_LexShared *shared)
+{
+  if(ins_atomic_u64_dec_eval(&shared->ref_count) == 0)
+  {
+    arena_release(shared->arena);
+  }
+}
+
+internal B32
+txt_lex_do_work(TXT_LexShared *shared)
+{
+  U64 piece_idx = ins_atomic_u64_inc_eval(&shared->piece_claim_gen) - 1;
+  B32 result = (piece_idx < shared->piece_count);
+  if(result)
+  {
+    TXT_LexPiece *piece = &shared->pieces[piece_idx];
+    piece->arena = arena_alloc();
+    piece->tokens = shared->lex_function(piece->arena, shared->bytes_processed_counter, str8_substr(shared->data, piece->range));
+    ins_atomic_u64_inc_eval(&shared->piece_done_count);
+  }
+  return result;
+}
+
+internal TS_TASK_FUNCTION_DEF(txt_lex_task__entry_point)
+{
+  TXT_LexShared *shared = (TXT_LexShared *)p;
+  ProfScope("lex helper") for(;txt_lex_do_work(shared);){}
+  txt_lex_shared_release(shared);
+  return 0;
+}
+
+internal TXT_TokenArray
+txt_token_array_from_data_lang__parallel(Arena *arena, U64 *bytes_processed_counter, String8 data, TXT_LangKind lang)
+{
+  ProfBeginFunction();
+  TXT_TokenArray result = {0};
+  TXT_LangLexFunctionType *lex_function = txt_lex_function_from_lang_kind(lang);
+  U64 piece_count_max = (ts_shared && ts_thread_count() != 0) ? (ts_thread_count()+1)*2 : 1;
+  U64 piece_count = Clamp(1, data.size/TXT_PARALLEL_LEX_PIECE_SIZE, piece_count_max);
+  
+  //- rjf: small files, lexers which cannot be resumed mid-file, or no task
+  // threads -> lex on this thread
+  if(lex_function != 0 && (data.size < TXT_PARALLEL_LEX_MIN_SIZE || piece_count <= 1 || !txt_lang_kind_is_relexable(lang)))
+  {
+    result = lex_function(arena, bytes_processed_counter, data);
+  }
+  
+  //- rjf: large files -> split, & lex pieces across task threads
+  else if(lex_function != 0)
+  {
+    Temp scratch = scratch_begin(&arena, 1);
+    
+    //- rjf: pick splits
+    U64 split_count = 0;
+    U64 *splits = 0;
+    ProfScope("pick splits") splits = txt_lex_split_offs_from_data(scratch.arena, data, piece_count-1, &split_count);
+    piece_count = split_count+1;
+    
+    //- rjf: set up pieces; each is lexed one byte into the next
+    Arena *shared_arena = arena_alloc();
+    TXT_LexShared *shared = push_array(shared_arena, TXT_LexShared, 1);
+    shared->arena = shared_arena;
+    shared->lex_function = lex_function;
+    shared->data = data;
+    shared->bytes_processed_counter = bytes_processed_counter;
+    shared->piece_count = piece_count;
+    shared->pieces = push_array(shared_arena, TXT_LexPiece, piece_count);
+    for(U64 idx = 0; idx < piece_count; idx += 1)
+    {
+      U64 min = (idx == 0) ? 0 : splits[idx-1];
+      U64 max = (idx+1 == piece_count) ? data.size : splits[idx]+1;
+      shared->pieces[idx].range = r1u64(min, max);
+    }
+    
+    //- rjf: lex pieces
+    U64 helper_count = Min(ts_thread_count(), piece_count-1);
+    shared->ref_count = helper_count+1;
+    for(U64 idx = 0; idx < helper_count; idx += 1)
+    {
+      ts_kickoff_detached(txt_lex_task__entry_point, 0, shared);
+    }
+    ProfScope("lex") for(;txt_lex_do_work(shared);){}
+    ProfScope("wait for helpers") for(;ins_atomic_u64_eval(&shared->piece_done_count) < shared->piece_count;)
+    {
+      os_sleep_milliseconds(0);
+    }
+    
+    //- rjf: stitch pieces. keep each piece's tokens up to the one which starts
+    // at the next piece's start - if there is no such token, then the split
+    // was not at a token boundary, so relex through the next piece instead.
+    TXT_LexPiece *segments = push_array(scratch.arena, TXT_LexPiece, piece_count);
+    U64 segment_count = 0;
+    U64 total_count = 0;
+    ProfScope("stitch") for(U64 piece_idx = 0; piece_idx < piece_count;)
+    {
+      U64 segment_min = shared->pieces[piece_idx].range.min;
+      TXT_TokenArray tokens = shared->pieces[piece_idx].tokens;
+      U64 next_piece_idx = piece_idx+1;
+      U64 keep_count = tokens.count;
+      for(;next_piece_idx < piece_count;)
+      {
+        U64 split_off = shared->pieces[next_piece_idx].range.min - segment_min;
+        U64 split_token_idx = txt_token_idx_upper_bound_from_off(tokens.v, tokens.count, split_off);
+        if(split_token_idx != 0 && tokens.v[split_token_idx-1].range.min == split_off)
         {
-          active_token_kind = TXT_TokenKind_Numeric;
+          keep_count = split_token_idx-1;
+          break;
         }
-        if(paren_nest != 0 && active_token_kind == TXT_TokenKind_Keyword)
+        next_piece_idx += 1;
+        U64 segment_max = shared->pieces[next_piece_idx-1].range.max;
+        tokens = lex_function(scratch.arena, 0, str8_substr(data, r1u64(segment_min, segment_max)));
+        keep_count = tokens.count;
+      }
+      segments[segment_count].range        = r1u64(segment_min, shared->pieces[next_piece_idx-1].range.max);
+      segments[segment_count].tokens.v     = tokens.v;
+      segments[segment_count].tokens.count = keep_count;
+      segment_count += 1;
+      total_count += keep_count;
+      piece_idx = next_piece_idx;
+    }
+    
+    //- rjf: segments -> token array
+    result.count = total_count;
+    result.v = push_array_no_zero(arena, TXT_Token, result.count);
+    {
+      U64 token_idx = 0;
+      for(U64 segment_idx = 0; segment_idx < segment_count; segment_idx += 1)
+      {
+        TXT_LexPiece *segment = &segments[segment_idx];
+        U64 off = segment->range.min;
+        for(U64 idx = 0; idx < segment->tokens.count; idx += 1, token_idx += 1)
         {
-          active_token_kind = TXT_TokenKind_Identifier;
+          result.v[token_idx].kind  = segment->tokens.v[idx].kind;
+          result.v[token_idx].range = r1u64(off + segment->tokens.v[idx].range.min, off + segment->tokens.v[idx].range.max);
         }
-        TXT_Token token = {active_token_kind, r1u64(active_token_start_off, off+advance)};
-        txt_token_chunk_list_push(arena, &tokens, 1024, &token);
-        active_token_kind = TXT_TokenKind_Null;
-        active_token_start_off = token.range.max;
       }
     }
+    
+    //- rjf: release pieces
+    for(U64 idx = 0; idx < piece_count; idx += 1)
+    {
+      arena_release(shared->pieces[idx].arena);
+    }
+    txt_lex_shared_release(shared);
+    scratch_end(scratch);
   }
-  
-  //- rjf: token list -> token array
-  TXT_TokenArray result = txt_token_array_from_chunk_list(arena, &tokens);
-  scratch_end(scratch);
+  ProfEnd();
   return result;
 }
 
 ////////////////////////////////
-//~ rjf: Main Layer Initialization
+//~ rjf: Search Functions
 
-internal void
-txt_init(void)
+internal B32
+txt_search_needle_matches_data_off(String8 data, U64 off, String8 needle, TXT_SearchFlags flags)
 {
-  Arena *arena = arena_alloc();
-  txt_shared = push_array(arena, TXT_Shared, 1);
-  txt_shared->arena = arena;
-  txt_shared->slots_count = 1024;
-  txt_shared->slots = push_array(arena, TXT_Slot, txt_shared->slots_count);
-  txt_shared->stripes_count = Min(txt_shared->slots_count, os_logical_core_count());
-  txt_shared->stripes = push_array(arena, TXT_Stripe, txt_shared->stripes_count);
-  txt_shared->stripes_free_nodes = push_array(arena, TXT_Node *, txt_shared->stripes_count);
-  for(U64 idx = 0; idx < txt_shared->stripes_count; idx += 1)
+  B32 result = (needle.size != 0 && off <= data.size && needle.size <= data.size - off);
+  if(result)
+  {
+    StringMatchFlags match_flags = (flags & TXT_SearchFlag_CaseInsensitive) ? StringMatchFlag_CaseInsensitive : 0;
+    result = str8_match(str8(data.str + off, needle.size), needle, match_flags);
+  }
+  if(result && flags & TXT_SearchFlag_WholeWord)
+  {
+    U8 before = (off != 0) ? data.str[off-1] : ' ';
+    U8 after = (off + needle.size < data.size) ? data.str[off + needle.size] : ' ';
+    B32 before_is_word = (char_is_alpha(before) || char_is_digit(before, 10) || before == '_');
+    B32 after_is_word = (char_is_alpha(after) || char_is_digit(after, 10) || after == '_');
+    result = (!before_is_word && !after_is_word);
+  }
+  return result;
+}
+
+internal U64
+txt_search_match_off_from_data_range_needle_flags(String8 data, Rng1U64 range, String8 needle, TXT_SearchFlags flags)
+{
+  U64 result = data.size;
+  if(needle.size != 0 && needle.size <= data.size)
+  {
+    //- rjf: candidates must leave room for the whole needle
+    U64 off = range.min;
+    U64 opl = Min(range.max, data.size - needle.size + 1);
+    
+    //- rjf: case-insensitive -> compare letters with their lowercase bit set;
+    // no other byte maps onto a lowercase letter this way
+    B32 case_insensitive = !!(flags & TXT_SearchFlag_CaseInsensitive);
+    U8 first = needle.str[0];
+    U8 last = needle.str[needle.size-1];
+    U8 first_fold = (case_insensitive && char_is_alpha(first)) ? 0x20 : 0;
+    U8 last_fold = (case_insensitive && char_is_alpha(last)) ? 0x20 : 0;
+    first |= first_fold;
+    last |= last_fold;
+    
+    //- rjf: find candidates 16 at a time, by the needle's first & last bytes
+#if ARCH_X64
+    {
+      __m128i first_v = _mm_set1_epi8((char)first);
+      __m128i last_v = _mm_set1_epi8((char)last);
+      __m128i first_fold_v = _mm_set1_epi8((char)first_fold);
+      __m128i last_fold_v = _mm_set1_epi8((char)last_fold);
+      for(; off + 16 <= opl && result == data.size; off += 16)
+      {
+        __m128i first_bytes = _mm_or_si128(_mm_loadu_si128((__m128i *)(data.str + off)), first_fold_v);
+        __m128i last_bytes = _mm_or_si128(_mm_loadu_si128((__m128i *)(data.str + off + needle.size - 1)), last_fold_v);
+        U32 candidate_mask = (U32)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(first_bytes, first_v),
+                                                                  _mm_cmpeq_epi8(last_bytes, last_v)));
+        for(; candidate_mask != 0; candidate_mask &= candidate_mask-1)
+        {
+          U64 candidate_off = off + ctz32(candidate_mask);
+          if(txt_search_needle_matches_data_off(data, candidate_off, needle, flags))
+          {
+            result = candidate_off;
+            break;
+          }
+        }
+      }
+    }
+#endif
+    
+    //- rjf: find remaining candidates one at a time
+    for(; off < opl && result == data.size; off += 1)
+    {
+      if((data.str[off] | first_fold) == first &&
+         (data.str[off + needle.size - 1] | last_fold) == last &&
+         txt_search_needle_matches_data_off(data, off, needle, flags))
+      {
+        result = off;
+      }
+    }
+  }
+  return result;
+}
+
+internal U64
+txt_search_last_match_off_from_data_range_needle_flags(String8 data, Rng1U64 range, String8 needle, TXT_SearchFlags flags)
+{
+  U64 result = data.size;
+  for(U64 off = range.min; off < range.max;)
   {
-    txt_shared->stripes[idx].arena = arena_alloc();
-    txt_shared->stripes[idx].rw_mutex = os_rw_mutex_alloc();
-    txt_shared->stripes[idx].cv = os_condition_variable_alloc();
+    U64 match_off = txt_search_match_off_from_data_range_needle_flags(data, r1u64(off, range.max), needle, flags);
+    if(match_off >= data.size)
+    {
+      break;
+    }
+    result = match_off;
+    off = match_off+1;
   }
-  txt_shared->u2p_ring_size = KB(64);
-  txt_shared->u2p_ring_base = push_array_no_zero(arena, U8, txt_shared->u2p_ring_size);
-  txt_shared->u2p_ring_cv = os_condition_variable_alloc();
-  txt_shared->u2p_ring_mutex = os_mutex_alloc();
-  txt_shared->parse_thread_count = Clamp(1, os_logical_core_count()-1, 4);
-  txt_shared->parse_threads = push_array(arena, OS_Handle, txt_shared->parse_thread_count);
-  for(U64 idx = 0; idx < txt_shared->parse_thread_count; idx += 1)
+  return result;
+}
+
+internal String8
+txt_search_params_from_needle_flags(Arena *arena, String8 needle, TXT_SearchFlags flags)
+{
+  String8 params = {0};
+  params.size = sizeof(flags) + needle.size;
+  params.str = push_array_no_zero(arena, U8, params.size);
+  MemoryCopy(params.str, &flags, sizeof(flags));
+  MemoryCopy(params.str + sizeof(flags), needle.str, needle.size);
+  return params;
+}
+
+internal U64
+txt_search_match_idx_upper_bound_from_results_off(TXT_SearchResults *results, U64 off)
+{
+  U64 lo = 0;
+  U64 hi = results->matches_count;
+  for(;lo < hi;)
   {
-    txt_shared->parse_threads[idx] = os_launch_thread(txt_parse_thread__entry_point, (void *)idx, 0);
+    U64 mid = lo + (hi-lo)/2;
+    if(results->matches[mid].min <= off)
+    {
+      lo = mid+1;
+    }
+    else
+    {
+      hi = mid;
+    }
   }
-  txt_shared->evictor_thread = os_launch_thread(txt_evictor_thread__entry_point, 0, 0);
+  return lo;
 }
 
 ////////////////////////////////
-//~ rjf: Thread Context Initialization
+//~ rjf: Artifact Cache Helpers
 
-internal void
-txt_tctx_ensure_inited(void)
+internal U128
+txt_artifact_key_from_hash_lang(U128 hash, TXT_LangKind lang)
+{
+  U64 params[] =
+  {
+    (U64)lang,
+    sizeof(Rng1U64),
+    TXT_PACKED_RANGE_BLOCK_SIZE,
+  };
+  U128 key = ac_key_from_kind_hash_params(AC_Kind_TextInfo, TXT_ARTIFACT_VERSION, hash, str8((U8 *)params, sizeof(params)));
+  return key;
+}
+
+internal B32
+txt_text_info_from_artifact(String8 artifact, TXT_TextInfo *info_out)
 {
-  if(txt_tctx == 0)
+  B32 result = 0;
+  if(artifact.size >= sizeof(TXT_TextInfoArtifactHeader))
   {
-    Arena *arena = arena_alloc();
-    txt_tctx = push_array(arena, TXT_TCTX, 1);
-    txt_tctx->arena = arena;
+    TXT_TextInfoArtifactHeader *header = (TXT_TextInfoArtifactHeader *)artifact.str;
+    U64 lines_blocks_count  = (header->lines_count + TXT_PACKED_RANGE_BLOCK_SIZE-1)/TXT_PACKED_RANGE_BLOCK_SIZE;
+    U64 tokens_blocks_count = (header->tokens_count + TXT_PACKED_RANGE_BLOCK_SIZE-1)/TXT_PACKED_RANGE_BLOCK_SIZE;
+    U64 lines_block_base_offs_off  = sizeof(*header);
+    U64 lines_overflow_idxs_off    = lines_block_base_offs_off  + lines_blocks_count*sizeof(U64);
+    U64 lines_overflow_ranges_off  = lines_overflow_idxs_off    + header->lines_overflow_count*sizeof(U64);
+    U64 tokens_block_base_offs_off = lines_overflow_ranges_off  + header->lines_overflow_count*sizeof(Rng1U64);
+    U64 tokens_overflow_idxs_off   = tokens_block_base_offs_off + tokens_blocks_count*sizeof(U64);
+    U64 tokens_overflow_ranges_off = tokens_overflow_idxs_off   + header->tokens_overflow_count*sizeof(U64);
+    U64 lines_offs_off             = tokens_overflow_ranges_off + header->tokens_overflow_count*sizeof(Rng1U64);
+    U64 tokens_offs_off            = lines_offs_off             + header->lines_count*sizeof(U32);
+    U64 lines_sizes_off            = tokens_offs_off            + header->tokens_count*sizeof(U32);
+    U64 tokens_sizes_off           = lines_sizes_off            + header->lines_count*sizeof(U16);
+    U64 tokens_kinds_off           = tokens_sizes_off           + header->tokens_count*sizeof(U16);
+    U64 end_off                    = tokens_kinds_off           + header->tokens_count*sizeof(U8);
+    if(header->lines_count != 0 && end_off == artifact.size && header->line_end_kind < TXT_LineEndKind_COUNT &&
+       header->lines_overflow_count <= header->lines_count && header->tokens_overflow_count <= header->tokens_count)
+    {
+      result = 1;
+      MemoryZeroStruct(info_out);
+      info_out->lines_count                   = header->lines_count;
+      info_out->lines.count                   = header->lines_count;
+      info_out->lines.block_base_offs         = (U64 *)(artifact.str + lines_block_base_offs_off);
+      info_out->lines.offs                    = (U32 *)(artifact.str + lines_offs_off);
+      info_out->lines.sizes                   = (U16 *)(artifact.str + lines_sizes_off);
+      info_out->lines.overflow_count          = header->lines_overflow_count;
+      info_out->lines.overflow_idxs           = (U64 *)(artifact.str + lines_overflow_idxs_off);
+      info_out->lines.overflow_ranges         = (Rng1U64 *)(artifact.str + lines_overflow_ranges_off);
+      info_out->lines_max_size                = header->lines_max_size;
+      info_out->line_end_kind                 = (TXT_LineEndKind)header->line_end_kind;
+      info_out->line_end_counts               = header->line_end_counts;
+      info_out->tokens.ranges.count           = header->tokens_count;
+      info_out->tokens.ranges.block_base_offs = (U64 *)(artifact.str + tokens_block_base_offs_off);
+      info_out->tokens.ranges.offs            = (U32 *)(artifact.str + tokens_offs_off);
+      info_out->tokens.ranges.sizes           = (U16 *)(artifact.str + tokens_sizes_off);
+      info_out->tokens.ranges.overflow_count  = header->tokens_overflow_count;
+      info_out->tokens.ranges.overflow_idxs   = (U64 *)(artifact.str + tokens_overflow_idxs_off);
+      info_out->tokens.ranges.overflow_ranges = (Rng1U64 *)(artifact.str + tokens_overflow_ranges_off);
+      info_out->tokens.kinds                  = (U8 *)(artifact.str + tokens_kinds_off);
+      info_out->bytes_processed               = header->bytes_to_process;
+      info_out->bytes_to_process              = header->bytes_to_process;
+    }
   }
+  return result;
+}
+
+internal void
+txt_artifact_submit(U128 key, TXT_TextInfo *info)
+{
+  Temp scratch = scratch_begin(0, 0);
+  TXT_PackedRangeArray *lines = &info->lines;
+  TXT_PackedRangeArray *tokens = &info->tokens.ranges;
+  TXT_TextInfoArtifactHeader *header = push_array(scratch.arena, TXT_TextInfoArtifactHeader, 1);
+  header->lines_count           = info->lines_count;
+  header->lines_max_size        = info->lines_max_size;
+  header->line_end_kind         = (U64)info->line_end_kind;
+  header->line_end_counts       = info->line_end_counts;
+  header->lines_overflow_count  = lines->overflow_count;
+  header->tokens_count          = tokens->count;
+  header->tokens_overflow_count = tokens->overflow_count;
+  header->bytes_to_process      = info->bytes_to_process;
+  U64 lines_blocks_count  = (lines->count + TXT_PACKED_RANGE_BLOCK_SIZE-1)/TXT_PACKED_RANGE_BLOCK_SIZE;
+  U64 tokens_blocks_count = (tokens->count + TXT_PACKED_RANGE_BLOCK_SIZE-1)/TXT_PACKED_RANGE_BLOCK_SIZE;
+  String8List parts = {0};
+  str8_list_push(scratch.arena, &parts, str8((U8 *)header, sizeof(*header)));
+  str8_list_push(scratch.arena, &parts, str8((U8 *)lines->block_base_offs, lines_blocks_count*sizeof(U64)));
+  str8_list_push(scratch.arena, &parts, str8((U8 *)lines->overflow_idxs, lines->overflow_count*sizeof(U64)));
+  str8_list_push(scratch.arena, &parts, str8((U8 *)lines->overflow_ranges, lines->overflow_count*sizeof(Rng1U64)));
+  str8_list_push(scratch.arena, &parts, str8((U8 *)tokens->block_base_offs, tokens_blocks_count*sizeof(U64)));
+  str8_list_push(scratch.arena, &parts, str8((U8 *)tokens->overflow_idxs, tokens->overflow_count*sizeof(U64)));
+  str8_list_push(scratch.arena, &parts, str8((U8 *)tokens->overflow_ranges, tokens->overflow_count*sizeof(Rng1U64)));
+  str8_list_push(scratch.arena, &parts, str8((U8 *)lines->offs, lines->count*sizeof(U32)));
+  str8_list_push(scratch.arena, &parts, str8((U8 *)tokens->offs, tokens->count*sizeof(U32)));
+  str8_list_push(scratch.arena, &parts, str8((U8 *)lines->sizes, lines->count*sizeof(U16)));
+  str8_list_push(scratch.arena, &parts, str8((U8 *)tokens->sizes, tokens->count*sizeof(U16)));
+  str8_list_push(scratch.arena, &parts, str8((U8 *)info->tokens.kinds, tokens->count*sizeof(U8)));
+  ac_submit_data(key, &parts);
+  scratch_end(scratch);
+}
+
+////////////////////////////////
+//~ rjf: Main Layer Initialization
+
+internal void
+txt_init(void)
+{
+  Arena *arena = arena_alloc();
+  txt_shared = push_array(arena, TXT_Shared, 1);
+  txt_shared->arena = arena;
+  CE_CacheParams params = {0};
+  params.name                = str8_lit("txt");
+  params.val_size            = sizeof(TXT_Value);
+  params.slots_count         = 1024;
+  params.worker_thread_count = Clamp(1, os_logical_core_count()-1, 4);
+  params.compute             = txt_text_info_compute;
+  params.release             = txt_text_info_release;
+  txt_shared->cache = ce_cache_alloc(&params);
+  CE_CacheParams search_params = {0};
+  search_params.name                = str8_lit("txt_search");
+  search_params.val_size            = sizeof(TXT_SearchValue);
+  search_params.slots_count         = 256;
+  search_params.worker_thread_count = Clamp(1, os_logical_core_count()-1, 2);
+  search_params.compute             = txt_search_compute;
+  search_params.release             = txt_search_release;
+  txt_shared->search_cache = ce_cache_alloc(&search_params);
+  txt_shared->visible_hints_mutex = os_mutex_alloc();
 }
 
 ////////////////////////////////
@@ -1392,13 +1396,14 @@ txt_tctx_ensure_inited(void)
 internal void
 txt_user_clock_tick(void)
 {
-  ins_atomic_u64_inc_eval(&txt_shared->user_clock_idx);
+  ce_cache_user_clock_tick(txt_shared->cache);
+  ce_cache_user_clock_tick(txt_shared->search_cache);
 }
 
 internal U64
 txt_user_clock_idx(void)
 {
-  return ins_atomic_u64_eval(&txt_shared->user_clock_idx);
+  return ce_cache_user_clock_idx(txt_shared->cache);
 }
 
 ////////////////////////////////
@@ -1407,66 +1412,135 @@ txt_user_clock_idx(void)
 internal TXT_Scope *
 txt_scope_open(void)
 {
-  txt_tctx_ensure_inited();
-  TXT_Scope *scope = txt_tctx->free_scope;
-  if(scope)
+  return ce_scope_open();
+}
+
+internal void
+txt_scope_close(TXT_Scope *scope)
+{
+  ce_scope_close(scope);
+}
+
+////////////////////////////////
+//~ rjf: Visible Line Range Hints
+
+internal void
+txt_push_visible_line_range(Rng1S64 line_range)
+{
+  if(txt_tctx.visible_line_range_stack_count < TXT_VISIBLE_LINE_RANGE_STACK_CAP)
   {
-    SLLStackPop(txt_tctx->free_scope);
+    txt_tctx.visible_line_range_stack[txt_tctx.visible_line_range_stack_count] = line_range;
   }
-  else
+  txt_tctx.visible_line_range_stack_count += 1;
+}
+
+internal void
+txt_pop_visible_line_range(void)
+{
+  if(txt_tctx.visible_line_range_stack_count > 0)
+  {
+    txt_tctx.visible_line_range_stack_count -= 1;
+  }
+}
+
+internal Rng1S64
+txt_top_visible_line_range(void)
+{
+  Rng1S64 result = {0};
+  if(txt_tctx.visible_line_range_stack_count > 0)
   {
-    scope = push_array_no_zero(txt_tctx->arena, TXT_Scope, 1);
+    result = txt_tctx.visible_line_range_stack[Min(txt_tctx.visible_line_range_stack_count, TXT_VISIBLE_LINE_RANGE_STACK_CAP)-1];
+  }
+  return result;
+}
+
+internal void
+txt_visible_hint_store(U128 hash, TXT_LangKind lang, Rng1S64 line_range)
+{
+  OS_MutexScope(txt_shared->visible_hints_mutex)
+  {
+    //- rjf: find this hash & lang's hint, or the least recently stored one
+    TXT_VisibleHint *hint = 0;
+    TXT_VisibleHint *oldest_hint = &txt_shared->visible_hints[0];
+    for(U64 idx = 0; idx < TXT_VISIBLE_HINT_SLOTS_COUNT; idx += 1)
+    {
+      TXT_VisibleHint *h = &txt_shared->visible_hints[idx];
+      if(u128_match(h->hash, hash) && h->lang == lang)
+      {
+        hint = h;
+        break;
+      }
+      if(h->touch_idx < oldest_hint->touch_idx)
+      {
+        oldest_hint = h;
+      }
+    }
+    if(hint == 0)
+    {
+      hint = oldest_hint;
+    }
+    
+    //- rjf: store
+    txt_shared->visible_hints_touch_idx += 1;
+    hint->hash       = hash;
+    hint->lang       = lang;
+    hint->line_range = line_range;
+    hint->touch_idx  = txt_shared->visible_hints_touch_idx;
   }
-  MemoryZeroStruct(scope);
-  return scope;
 }
 
-internal void
-txt_scope_close(TXT_Scope *scope)
+internal Rng1S64
+txt_visible_line_range_from_hash_lang(U128 hash, TXT_LangKind lang)
 {
-  for(TXT_Touch *touch = scope->top_touch, *next = 0; touch != 0; touch = next)
+  Rng1S64 result = {0};
+  OS_MutexScope(txt_shared->visible_hints_mutex)
   {
-    U128 hash = touch->hash;
-    next = touch->next;
-    U64 slot_idx = hash.u64[1]%txt_shared->slots_count;
-    U64 stripe_idx = slot_idx%txt_shared->stripes_count;
-    TXT_Slot *slot = &txt_shared->slots[slot_idx];
-    TXT_Stripe *stripe = &txt_shared->stripes[stripe_idx];
-    OS_MutexScopeR(stripe->rw_mutex)
+    for(U64 idx = 0; idx < TXT_VISIBLE_HINT_SLOTS_COUNT; idx += 1)
     {
-      for(TXT_Node *n = slot->first; n != 0; n = n->next)
+      TXT_VisibleHint *h = &txt_shared->visible_hints[idx];
+      if(u128_match(h->hash, hash) && h->lang == lang)
       {
-        if(u128_match(hash, n->hash) && touch->lang == n->lang)
-        {
-          ins_atomic_u64_dec_eval(&n->scope_ref_count);
-          break;
-        }
+        result = h->line_range;
+        break;
       }
     }
-    SLLStackPush(txt_tctx->free_touch, touch);
   }
-  SLLStackPush(txt_tctx->free_scope, scope);
+  return result;
 }
 
-internal void
-txt_scope_touch_node__stripe_r_guarded(TXT_Scope *scope, TXT_Node *node)
+////////////////////////////////
+//~ rjf: Viewport-First Lexing
+
+internal U64
+txt_lex_resume_off_from_data_off(String8 data, U64 off)
 {
-  TXT_Touch *touch = txt_tctx->free_touch;
-  ins_atomic_u64_inc_eval(&node->scope_ref_count);
-  ins_atomic_u64_eval_assign(&node->last_time_touched_us, os_now_microseconds());
-  ins_atomic_u64_eval_assign(&node->last_user_clock_idx_touched, txt_user_clock_idx());
-  if(touch != 0)
-  {
-    SLLStackPop(txt_tctx->free_touch);
-  }
-  else
+  Temp scratch = scratch_begin(0, 0);
+  String8 prefix = str8_prefix(data, off+1);
+  U64 split_count = 0;
+  U64 *splits = txt_lex_split_offs_from_data(scratch.arena, prefix, prefix.size/TXT_VIEWPORT_LEX_RESUME_SPACING, &split_count);
+  U64 result = (split_count != 0) ? splits[split_count-1] : 0;
+  scratch_end(scratch);
+  return result;
+}
+
+internal TXT_TokenArray
+txt_token_array_from_data_lang_line_range(Arena *arena, String8 data, TXT_LangKind lang, TXT_TextInfo *info, Rng1S64 line_range)
+{
+  TXT_TokenArray result = {0};
+  TXT_LangLexFunctionType *lex_function = txt_lex_function_from_lang_kind(lang);
+  if(lex_function != 0 && info->lines_count != 0)
   {
-    touch = push_array_no_zero(txt_tctx->arena, TXT_Touch, 1);
+    Rng1S64 line_range_clamped = r1s64(Clamp(1, line_range.min, (S64)info->lines_count), Clamp(1, line_range.max, (S64)info->lines_count));
+    U64 resume_off = txt_lex_resume_off_from_data_off(data, txt_line_range_from_info_line_num(info, line_range_clamped.min).min);
+    U64 opl_off = txt_line_range_from_info_line_num(info, line_range_clamped.max).max;
+    result = lex_function(arena, 0, str8_substr(data, r1u64(resume_off, opl_off)));
+    for(U64 idx = 0; idx < result.count; idx += 1)
+    {
+      result.v[idx].range.min += resume_off;
+      result.v[idx].range.max += resume_off;
+    }
   }
-  MemoryZeroStruct(touch);
-  touch->hash = node->hash;
-  touch->lang = node->lang;
-  SLLStackPush(scope->top_touch, touch);
+  return result;
 }
 
 ////////////////////////////////
@@ -1475,66 +1549,21 @@ txt_scope_touch_node__stripe_r_guarded(TXT_Scope *scope, TXT_Node *node)
 internal TXT_TextInfo
 txt_text_info_from_hash_lang(TXT_Scope *scope, U128 hash, TXT_LangKind lang)
 {
-  TXT_TextInfo info = {0};
-  if(!u128_match(hash, u128_zero()))
-  {
-    U64 slot_idx = hash.u64[1]%txt_shared->slots_count;
-    U64 stripe_idx = slot_idx%txt_shared->stripes_count;
-    TXT_Slot *slot = &txt_shared->slots[slot_idx];
-    TXT_Stripe *stripe = &txt_shared->stripes[stripe_idx];
-    B32 found = 0;
-    OS_MutexScopeR(stripe->rw_mutex)
-    {
-      for(TXT_Node *n = slot->first; n != 0; n = n->next)
-      {
-        if(u128_match(hash, n->hash) && n->lang == lang)
-        {
-          MemoryCopyStruct(&info, &n->info);
-          info.bytes_processed = ins_atomic_u64_eval(&n->info.bytes_processed);
-          info.bytes_to_process = ins_atomic_u64_eval(&n->info.bytes_to_process);
-          found = 1;
-          txt_scope_touch_node__stripe_r_guarded(scope, n);
-          break;
-        }
-      }
-    }
-    B32 node_is_new = 0;
-    if(!found)
-    {
-      OS_MutexScopeW(stripe->rw_mutex)
-      {
-        TXT_Node *node = 0;
-        for(TXT_Node *n = slot->first; n != 0; n = n->next)
-        {
-          if(u128_match(hash, n->hash) && n->lang == lang)
-          {
-            node = n;
-            break;
-          }
-        }
-        if(node == 0)
-        {
-          node = txt_shared->stripes_free_nodes[stripe_idx];
-          if(node)
-          {
-            SLLStackPop(txt_shared->stripes_free_nodes[stripe_idx]);
-          }
-          else
-          {
-            node = push_array_no_zero(stripe->arena, TXT_Node, 1);
-          }
-          MemoryZeroStruct(node);
-          DLLPushBack(slot->first, slot->last, node);
-          node->hash = hash;
-          node->lang = lang;
-          node_is_new = 1;
-        }
-      }
-    }
-    if(node_is_new)
-    {
-      txt_u2p_enqueue_req(hash, lang, max_U64);
-    }
+  TXT_Value val = {0};
+  CE_Lookup lookup = ce_val_from_hash_params(scope, txt_shared->cache, hash, str8_struct(&lang), &val);
+  TXT_TextInfo info = val.info;
+  if(!lookup.is_loaded)
+  {
+    info.bytes_processed = lookup.progress_done;
+    info.bytes_to_process = lookup.progress_total;
+  }
+  
+  //- rjf: not yet fully lexed -> leave the lines this thread is about to
+  // show as a hint, so that they are lexed first
+  Rng1S64 visible_line_range = txt_top_visible_line_range();
+  if((!lookup.is_loaded || info.tokens_are_partial) && visible_line_range.min != 0 && !u128_match(hash, u128_zero()))
+  {
+    txt_visible_hint_store(hash, lang, visible_line_range);
   }
   return info;
 }
@@ -1559,62 +1588,108 @@ txt_text_info_from_key_lang(TXT_Scope *scope, U128 key, TXT_LangKind lang, U128
   return result;
 }
 
+internal TXT_SearchResults
+txt_search_results_from_hash_needle_flags(TXT_Scope *scope, U128 hash, String8 needle, TXT_SearchFlags flags)
+{
+  TXT_SearchResults results = {0};
+  if(needle.size != 0)
+  {
+    Temp scratch = scratch_begin(0, 0);
+    String8 params = txt_search_params_from_needle_flags(scratch.arena, needle, flags);
+    TXT_SearchValue val = {0};
+    CE_Lookup lookup = ce_val_from_hash_params(scope, txt_shared->search_cache, hash, params, &val);
+    results = val.results;
+    if(!lookup.is_loaded && !results.is_complete)
+    {
+      results.bytes_searched = Max(results.bytes_searched, lookup.progress_done);
+      results.bytes_to_search = lookup.progress_total;
+    }
+    scratch_end(scratch);
+  }
+  return results;
+}
+
 ////////////////////////////////
 //~ rjf: Text Info Extractor Helpers
 
+internal Rng1U64
+txt_line_range_from_info_line_num(TXT_TextInfo *info, S64 line_num)
+{
+  Rng1U64 result = {0};
+  if(1 <= line_num && line_num <= info->lines_count)
+  {
+    result = txt_range_from_packed_range_array_idx(&info->lines, (U64)(line_num-1));
+  }
+  return result;
+}
+
+internal TXT_Token
+txt_token_from_info_idx(TXT_TextInfo *info, U64 idx)
+{
+  return txt_token_from_packed_token_array_idx(&info->tokens, idx);
+}
+
 internal U64
 txt_off_from_info_pt(TXT_TextInfo *info, TxtPt pt)
 {
   U64 off = 0;
   if(1 <= pt.line && pt.line <= info->lines_count)
   {
-    Rng1U64 line_range = info->lines_ranges[pt.line-1];
+    Rng1U64 line_range = txt_line_range_from_info_line_num(info, pt.line);
     off = line_range.min + (pt.column-1);
   }
   return off;
 }
 
 internal TxtPt
-txt_pt_from_info_off__linear_scan(TXT_TextInfo *info, U64 off)
+txt_pt_from_info_off(TXT_TextInfo *info, U64 off)
 {
   TxtPt pt = {0};
+  U64 line_idx = txt_idx_upper_bound_from_packed_range_array_off(&info->lines, off);
+  Rng1U64 line_range = txt_line_range_from_info_line_num(info, (S64)line_idx);
+  if(line_idx != 0 && contains_1u64(line_range, off))
   {
-    for(U64 line_idx = 0; line_idx < info->lines_count; line_idx += 1)
-    {
-      if(contains_1u64(info->lines_ranges[line_idx], off))
-      {
-        pt.line = (S64)line_idx + 1;
-        pt.column = (S64)(off - info->lines_ranges[line_idx].min) + 1;
-      }
-    }
+    pt.line = (S64)line_idx;
+    pt.column = (S64)(off - line_range.min) + 1;
   }
   return pt;
 }
 
 internal TXT_TokenArray
-txt_token_array_from_info_line_num__linear_scan(TXT_TextInfo *info, S64 line_num)
+txt_token_array_from_info_line_num(Arena *arena, TXT_TextInfo *info, S64 line_num)
 {
   TXT_TokenArray line_tokens = {0};
   if(1 <= line_num && line_num <= info->lines_count)
   {
-    Rng1U64 line_range = info->lines_ranges[line_num-1];
-    for(U64 token_idx = 0; token_idx < info->tokens.count; token_idx += 1)
+    //- rjf: find the first token ending past the line's start - the token
+    // before the first one starting past it, or that one
+    Rng1U64 line_range = txt_line_range_from_info_line_num(info, line_num);
+    U64 token_idx = txt_idx_upper_bound_from_packed_range_array_off(&info->tokens.ranges, line_range.min);
+    if(token_idx != 0 && txt_token_from_info_idx(info, token_idx-1).range.max > line_range.min)
+    {
+      token_idx -= 1;
+    }
+    
+    //- rjf: take the run of tokens which overlap the line
+    Rng1U64 line_tokens_idx_range = r1u64(token_idx, token_idx);
+    for(;token_idx < info->tokens.ranges.count; token_idx += 1)
     {
-      Rng1U64 token_range = info->tokens.v[token_idx].range;
+      Rng1U64 token_range = txt_token_from_info_idx(info, token_idx).range;
       Rng1U64 token_x_line = intersect_1u64(token_range, line_range);
       if(token_x_line.max > token_x_line.min)
       {
-        if(line_tokens.v == 0)
+        if(line_tokens_idx_range.max == line_tokens_idx_range.min)
         {
-          line_tokens.v = info->tokens.v+token_idx;
+          line_tokens_idx_range.min = token_idx;
         }
-        line_tokens.count += 1;
+        line_tokens_idx_range.max = token_idx+1;
       }
-      else if(line_tokens.v != 0)
+      else if(line_tokens_idx_range.max != line_tokens_idx_range.min || token_range.min >= line_range.max)
       {
         break;
       }
     }
+    line_tokens = txt_token_array_from_packed_token_array_idx_range(arena, &info->tokens, line_tokens_idx_range);
   }
   return line_tokens;
 }
@@ -1730,7 +1805,7 @@ txt_expr_off_range_from_info_data_pt(TXT_TextInfo *info, String8 data, TxtPt pt)
   if(1 <= pt.line && pt.line <= info->lines_count)
   {
     // rjf: unpack line info
-    Rng1U64 line_range = info->lines_ranges[pt.line-1];
+    Rng1U64 line_range = txt_line_range_from_info_line_num(info, pt.line);
     String8 line_text = str8_substr(data, line_range);
     TXT_LineTokensSlice line_tokens_slice = txt_line_tokens_slice_from_info_data_line_range(scratch.arena, info, data, r1s64(pt.line, pt.line));
     TXT_TokenArray line_tokens = line_tokens_slice.line_tokens[0];
@@ -1759,7 +1834,7 @@ txt_string_from_info_data_line_num(TXT_TextInfo *info, String8 data, S64 line_nu
   String8 result = {0};
   if(1 <= line_num && line_num <= info->lines_count)
   {
-    result = str8_substr(data, info->lines_ranges[line_num-1]);
+    result = str8_substr(data, txt_line_range_from_info_line_num(info, line_num));
   }
   return result;
 }
@@ -1768,7 +1843,6 @@ internal TXT_LineTokensSlice
 txt_line_tokens_slice_from_info_data_line_range(Arena *arena, TXT_TextInfo *info, String8 data, Rng1S64 line_range)
 {
   TXT_LineTokensSlice result = {0};
-  Temp scratch = scratch_begin(&arena, 1);
   if(info->lines_count != 0)
   {
     Rng1S64 line_range_clamped = r1s64(Clamp(1, line_range.min, (S64)info->lines_count), Clamp(1, line_range.max, (S64)info->lines_count));
@@ -1777,386 +1851,471 @@ txt_line_tokens_slice_from_info_data_line_range(Arena *arena, TXT_TextInfo *info
     // rjf: allocate output arrays
     result.line_tokens = push_array(arena, TXT_TokenArray, line_count);
     
-    // rjf: binary search to find first token
-    TXT_Token *tokens_first = 0;
+    // rjf: binary search to find first token - the first one ending past the
+    // slice's start
+    Rng1U64 first_line_range = txt_line_range_from_info_line_num(info, line_range_clamped.min);
+    U64 token_idx = 0;
     ProfScope("binary search to find first token")
     {
-      Rng1U64 slice_range = r1u64(info->lines_ranges[line_range_clamped.min-1].min, info->lines_ranges[line_range_clamped.max-1].max);
-      U64 min_idx = 0;
-      U64 opl_idx = info->tokens.count;
-      for(;;)
+      token_idx = txt_idx_upper_bound_from_packed_range_array_off(&info->tokens.ranges, first_line_range.min);
+      for(;token_idx != 0 && txt_range_from_packed_range_array_idx(&info->tokens.ranges, token_idx-1).max > first_line_range.min;)
       {
-        U64 mid_idx = (opl_idx+min_idx)/2;
-        if(mid_idx >= opl_idx)
-        {
-          break;
-        }
-        TXT_Token *mid_token = &info->tokens.v[mid_idx];
-        if(mid_token->range.min > slice_range.max)
-        {
-          opl_idx = mid_idx;
-        }
-        else if(mid_token->range.max < slice_range.min)
-        {
-          min_idx = mid_idx;
-        }
-        else if(tokens_first == 0 || mid_token->range.min < tokens_first->range.min)
-        {
-          tokens_first = mid_token;
-          opl_idx = mid_idx;
-        }
-        if(mid_idx == min_idx && mid_idx+1 == opl_idx)
-        {
-          break;
-        }
+        token_idx -= 1;
       }
     }
     
-    // rjf: grab per-line tokens
-    TXT_TokenList *line_tokens_lists = push_array(scratch.arena, TXT_TokenList, line_count);
-    if(tokens_first != 0) ProfScope("grab per-line tokens")
+    // rjf: grab per-line tokens - each line's tokens are the run which starts
+    // with the first token ending past the line's start, & ends with the last
+    // one starting before its end. tokens spanning lines start the next run.
+    ProfScope("grab per-line tokens")
     {
-      TXT_Token *tokens_opl = info->tokens.v+info->tokens.count;
-      U64 line_slice_idx = 0;
-      for(TXT_Token *token = tokens_first; token < tokens_opl && line_slice_idx < line_count;)
+      TXT_PackedRangeArray *tokens_ranges = &info->tokens.ranges;
+      for(U64 line_slice_idx = 0; line_slice_idx < line_count; line_slice_idx += 1)
       {
-        if(token->range.min < info->lines_ranges[line_slice_idx+line_range.min-1].max)
+        Rng1U64 line = txt_line_range_from_info_line_num(info, line_range_clamped.min + (S64)line_slice_idx);
+        for(;token_idx < tokens_ranges->count && txt_range_from_packed_range_array_idx(tokens_ranges, token_idx).max <= line.min;)
         {
-          if(token->range.max > info->lines_ranges[line_slice_idx+line_range.min-1].min)
-          {
-            txt_token_list_push(scratch.arena, &line_tokens_lists[line_slice_idx], token);
-          }
-          B32 need_token_advance = 0;
-          B32 need_line_advance = 0;
-          if(token->range.max >= info->lines_ranges[line_slice_idx+line_range.min-1].max)
-          {
-            need_line_advance = 1;
-          }
-          if(token->range.max <= info->lines_ranges[line_slice_idx+line_range.min-1].max)
-          {
-            need_token_advance += 1;
-          }
-          if(need_line_advance) { line_slice_idx += 1; }
-          if(need_token_advance) { token += 1; }
+          token_idx += 1;
         }
-        else
+        U64 opl_token_idx = token_idx;
+        for(;opl_token_idx < tokens_ranges->count && txt_range_from_packed_range_array_idx(tokens_ranges, opl_token_idx).min < line.max;)
+        {
+          opl_token_idx += 1;
+        }
+        result.line_tokens[line_slice_idx] = txt_token_array_from_packed_token_array_idx_range(arena, &info->tokens, r1u64(token_idx, opl_token_idx));
+        if(opl_token_idx != token_idx)
         {
-          line_slice_idx += 1;
+          token_idx = opl_token_idx-1;
         }
       }
     }
-    
-    // rjf: bake per-line tokens to arrays
-    for(U64 line_slice_idx = 0; line_slice_idx < line_count; line_slice_idx += 1)
-    {
-      result.line_tokens[line_slice_idx] = txt_token_array_from_list(arena, &line_tokens_lists[line_slice_idx]);
-    }
   }
-  scratch_end(scratch);
   return result;
 }
 
+
 ////////////////////////////////
-//~ rjf: Transfer Threads
+//~ rjf: Incremental Text Info
 
-internal B32
-txt_u2p_enqueue_req(U128 hash, TXT_LangKind lang, U64 endt_us)
+internal U64
+txt_token_idx_upper_bound_from_off(TXT_Token *tokens, U64 tokens_count, U64 off)
 {
-  B32 good = 0;
-  OS_MutexScope(txt_shared->u2p_ring_mutex) for(;;)
+  U64 lo = 0;
+  U64 hi = tokens_count;
+  for(;lo < hi;)
   {
-    U64 unconsumed_size = txt_shared->u2p_ring_write_pos - txt_shared->u2p_ring_read_pos;
-    U64 available_size = txt_shared->u2p_ring_size - unconsumed_size;
-    if(available_size >= sizeof(hash)+sizeof(lang))
+    U64 mid = lo + (hi-lo)/2;
+    if(tokens[mid].range.min <= off)
     {
-      good = 1;
-      txt_shared->u2p_ring_write_pos += ring_write_struct(txt_shared->u2p_ring_base, txt_shared->u2p_ring_size, txt_shared->u2p_ring_write_pos, &hash);
-      txt_shared->u2p_ring_write_pos += ring_write_struct(txt_shared->u2p_ring_base, txt_shared->u2p_ring_size, txt_shared->u2p_ring_write_pos, &lang);
-      break;
+      lo = mid+1;
     }
-    if(os_now_microseconds() >= endt_us)
+    else
     {
-      break;
+      hi = mid;
     }
-    os_condition_variable_wait(txt_shared->u2p_ring_cv, txt_shared->u2p_ring_mutex, endt_us);
-  }
-  if(good)
-  {
-    os_condition_variable_broadcast(txt_shared->u2p_ring_cv);
   }
-  return good;
+  return lo;
 }
 
-internal void
-txt_u2p_dequeue_req(U128 *hash_out, TXT_LangKind *lang_out)
+internal B32
+txt_text_info_from_data_base_diff(Arena *arena, String8 data, TXT_LangKind lang, TXT_TextInfo *base, HS_Diff *diff, TXT_TextInfo *info_out)
 {
-  OS_MutexScope(txt_shared->u2p_ring_mutex) for(;;)
+  B32 result = 0;
+  TXT_LangLexFunctionType *lex_function = txt_lex_function_from_lang_kind(lang);
+  if(base->lines_count != 0 &&
+     diff->prefix_size + diff->suffix_size != 0 &&
+     diff->prefix_size + diff->suffix_size <= Min(data.size, diff->base_size) &&
+     txt_lang_kind_is_relexable(lang))
   {
-    U64 unconsumed_size = txt_shared->u2p_ring_write_pos - txt_shared->u2p_ring_read_pos;
-    if(unconsumed_size >= sizeof(*hash_out) + sizeof(*lang_out))
+    Temp scratch = scratch_begin(&arena, 1);
+    S64 delta = (S64)data.size - (S64)diff->base_size;
+    U64 suffix_min = data.size - diff->suffix_size;
+    
+    //- rjf: reuse lines which end, terminators included, within the unchanged
+    // prefix - rescan from the start of the first line which does not. a \r
+    // ending the prefix may now be the first half of a \r\n, so its line is
+    // rescanned too.
+    U64 prefix_probe_off = diff->prefix_size;
+    if(prefix_probe_off != 0 && data.str[prefix_probe_off-1] == '\r')
     {
-      txt_shared->u2p_ring_read_pos += ring_read_struct(txt_shared->u2p_ring_base, txt_shared->u2p_ring_size, txt_shared->u2p_ring_read_pos, hash_out);
-      txt_shared->u2p_ring_read_pos += ring_read_struct(txt_shared->u2p_ring_base, txt_shared->u2p_ring_size, txt_shared->u2p_ring_read_pos, lang_out);
-      break;
+      prefix_probe_off -= 1;
     }
-    os_condition_variable_wait(txt_shared->u2p_ring_cv, txt_shared->u2p_ring_mutex, max_U64);
-  }
-  os_condition_variable_broadcast(txt_shared->u2p_ring_cv);
-}
-
-internal void
-txt_parse_thread__entry_point(void *p)
-{
-  for(;;)
-  {
-    //- rjf: get next key
-    U128 hash = {0};
-    TXT_LangKind lang = TXT_LangKind_Null;
-    txt_u2p_dequeue_req(&hash, &lang);
-    HS_Scope *scope = hs_scope_open();
-    
-    //- rjf: unpack hash
-    U64 slot_idx = hash.u64[1]%txt_shared->slots_count;
-    U64 stripe_idx = slot_idx%txt_shared->stripes_count;
-    TXT_Slot *slot = &txt_shared->slots[slot_idx];
-    TXT_Stripe *stripe = &txt_shared->stripes[stripe_idx];
+    U64 prefix_lines_count = txt_idx_upper_bound_from_packed_range_array_off(&base->lines, prefix_probe_off) - 1;
+    U64 rescan_off = txt_range_from_packed_range_array_idx(&base->lines, prefix_lines_count).min;
     
-    //- rjf: take task
-    B32 got_task = 0;
-    OS_MutexScopeR(stripe->rw_mutex)
+    //- rjf: count rescanned lines, until one starts within the unchanged
+    // suffix, at the (shifted) start of a base line. scanning only depends on
+    // the bytes following a line start, so all later lines are unchanged.
+    U64 mid_lines_count = 0;
+    U64 suffix_lines_base_idx = base->lines_count;
+    for(U64 idx = rescan_off; idx <= data.size; idx += 1)
     {
-      for(TXT_Node *n = slot->first; n != 0; n = n->next)
+      if(idx == data.size || data.str[idx] == '\n' || data.str[idx] == '\r')
       {
-        if(u128_match(n->hash, hash) && n->lang == lang)
+        mid_lines_count += 1;
+        U64 line_start_off = idx+1;
+        if(idx+1 < data.size && data.str[idx] == '\r' && data.str[idx+1] == '\n')
         {
-          got_task = !ins_atomic_u32_eval_cond_assign(&n->is_working, 1, 0);
-          break;
+          line_start_off += 1;
+          idx += 1;
+        }
+        if(suffix_min <= line_start_off && line_start_off <= data.size)
+        {
+          U64 base_off = (U64)((S64)line_start_off - delta);
+          U64 base_line_idx = txt_idx_upper_bound_from_packed_range_array_off(&base->lines, base_off) - 1;
+          if(txt_range_from_packed_range_array_idx(&base->lines, base_line_idx).min == base_off)
+          {
+            suffix_lines_base_idx = base_line_idx;
+            break;
+          }
         }
       }
     }
     
-    //- rjf: hash -> data
-    String8 data = {0};
-    if(got_task)
+    //- rjf: build line ranges - prefix, rescanned middle, shifted suffix
+    U64 suffix_lines_count = base->lines_count - suffix_lines_base_idx;
+    U64 lines_count = prefix_lines_count + mid_lines_count + suffix_lines_count;
+    Rng1U64 *lines_ranges = push_array_no_zero(scratch.arena, Rng1U64, lines_count);
+    for(U64 idx = 0; idx < prefix_lines_count; idx += 1)
     {
-      data = hs_data_from_hash(scope, hash);
+      lines_ranges[idx] = txt_range_from_packed_range_array_idx(&base->lines, idx);
     }
-    
-    //- rjf: data -> text info
-    Arena *info_arena = 0;
-    TXT_TextInfo info = {0};
-    if(got_task && data.size != 0)
     {
-      info_arena = arena_alloc();
-      
-      //- rjf: grab pointers to working counters
-      U64 *bytes_processed_ptr = 0;
-      U64 *bytes_to_process_ptr = 0;
-      OS_MutexScopeR(stripe->rw_mutex)
+      Rng1U64 *mid_lines = lines_ranges + prefix_lines_count;
+      U64 line_idx = 0;
+      U64 line_start_off = rescan_off;
+      for(U64 idx = rescan_off; idx <= data.size && line_idx < mid_lines_count; idx += 1)
       {
-        for(TXT_Node *n = slot->first; n != 0; n = n->next)
+        if(idx == data.size || data.str[idx] == '\n' || data.str[idx] == '\r')
         {
-          if(u128_match(n->hash, hash) && n->lang == lang)
+          mid_lines[line_idx] = r1u64(line_start_off, idx);
+          line_idx += 1;
+          line_start_off = idx+1;
+          if(idx+1 < data.size && data.str[idx] == '\r' && data.str[idx+1] == '\n')
           {
-            bytes_processed_ptr = &n->info.bytes_processed;
-            bytes_to_process_ptr = &n->info.bytes_to_process;
+            line_start_off += 1;
+            idx += 1;
           }
         }
       }
-      
-      //- rjf: set # of bytes to process
-      if(bytes_to_process_ptr)
-      {
-        //                                               (line ending calc)     (line counting)    (line measuring)   (lexing)
-        ins_atomic_u64_eval_assign(bytes_to_process_ptr, Min(data.size, 1024) + data.size        + data.size        + data.size*(lang != TXT_LangKind_Null));
-      }
-      
-      //- rjf: detect line end kind
-      TXT_LineEndKind line_end_kind = TXT_LineEndKind_Null;
+    }
+    for(U64 idx = 0; idx < suffix_lines_count; idx += 1)
+    {
+      Rng1U64 base_range = txt_range_from_packed_range_array_idx(&base->lines, suffix_lines_base_idx + idx);
+      lines_ranges[prefix_lines_count + mid_lines_count + idx] = r1u64((U64)((S64)base_range.min + delta), (U64)((S64)base_range.max + delta));
+    }
+    info_out->lines_count = lines_count;
+    info_out->lines = txt_packed_range_array_from_rng1u64s(arena, lines_ranges, lines_count);
+    info_out->lines_max_size = 0;
+    for(U64 idx = 0; idx < lines_count; idx += 1)
+    {
+      info_out->lines_max_size = Max(info_out->lines_max_size, dim_1u64(lines_ranges[idx]));
+    }
+    
+    //- rjf: lex
+    MemoryZeroStruct(&info_out->tokens);
+    if(lex_function != 0)
+    {
+      //- rjf: reuse tokens which end within the unchanged prefix, short of the
+      // byte examined to end them. relex from the end of the last one, which
+      // must not leave an escape pending.
+      U64 prefix_tokens_count = txt_idx_upper_bound_from_packed_range_array_off(&base->tokens.ranges, diff->prefix_size);
+      for(;prefix_tokens_count != 0; prefix_tokens_count -= 1)
       {
-        U64 lf_count = 0;
-        U64 cr_count = 0;
-        for(U64 idx = 0; idx < data.size && idx < 1024; idx += 1)
-        {
-          if(data.str[idx] == '\r')
-          {
-            cr_count += 1;
-          }
-          if(data.str[idx] == '\n')
-          {
-            lf_count += 1;
-          }
-        }
-        if(cr_count >= lf_count/2 && lf_count >= 1)
-        {
-          line_end_kind = TXT_LineEndKind_CRLF;
-        }
-        else if(lf_count >= 1)
+        U64 end_off = txt_range_from_packed_range_array_idx(&base->tokens.ranges, prefix_tokens_count-1).max;
+        U8 end_byte = data.str[end_off-1];
+        if(end_off < diff->prefix_size && end_byte != '\\' && end_byte != '\r' && end_byte != '\n')
         {
-          line_end_kind = TXT_LineEndKind_LF;
+          break;
         }
-        info.line_end_kind = line_end_kind;
-      }
-      
-      //- rjf: bump progress
-      if(bytes_processed_ptr)
-      {
-        ins_atomic_u64_eval_assign(bytes_processed_ptr, Min(data.size, 1024));
       }
+      U64 relex_off = (prefix_tokens_count != 0 ? txt_range_from_packed_range_array_idx(&base->tokens.ranges, prefix_tokens_count-1).max : 0);
       
-      //- rjf: count # of lines
-      U64 line_count = 1;
-      U64 byte_process_start_idx = 0;
-      for(U64 idx = 0; idx < data.size; idx += 1)
+      //- rjf: relex up to a window into the unchanged suffix, & look for a
+      // token which starts, with no escape pending, at the (shifted) start of
+      // a base token - the lexers carry no other state between tokens, so
+      // from there on, tokens are unchanged
+      U64 window_end = Min(data.size, Max(suffix_min, relex_off) + TXT_RELEX_WINDOW_SIZE);
+      TXT_TokenArray mid_tokens = lex_function(scratch.arena, 0, str8_substr(data, r1u64(relex_off, window_end)));
+      U64 mid_tokens_count = mid_tokens.count;
+      U64 suffix_tokens_base_idx = base->tokens.ranges.count;
+      for(U64 idx = 1; idx < mid_tokens.count; idx += 1)
       {
-        if(data.str[idx] == '\n' || data.str[idx] == '\r')
+        U64 start_off = relex_off + mid_tokens.v[idx].range.min;
+        U8 start_byte = data.str[start_off-1];
+        if(start_off > suffix_min && start_byte != '\\' && start_byte != '\r' && start_byte != '\n')
         {
-          line_count += 1;
-          if(data.str[idx] == '\r')
+          U64 base_off = (U64)((S64)start_off - delta);
+          U64 base_token_idx = txt_idx_upper_bound_from_packed_range_array_off(&base->tokens.ranges, base_off);
+          if(base_token_idx != 0 && txt_range_from_packed_range_array_idx(&base->tokens.ranges, base_token_idx-1).min == base_off)
           {
-            idx += 1;
+            mid_tokens_count = idx;
+            suffix_tokens_base_idx = base_token_idx-1;
+            break;
           }
         }
-        if(idx && idx%1000 == 0)
-        {
-          ins_atomic_u64_add_eval(bytes_processed_ptr, 1000);
-        }
       }
       
-      //- rjf: bump progress
-      if(bytes_processed_ptr)
+      //- rjf: no resync within the window -> relex the rest
+      if(suffix_tokens_base_idx == base->tokens.ranges.count && window_end < data.size)
       {
-        ins_atomic_u64_eval_assign(bytes_processed_ptr, Min(data.size, 1024) + data.size);
+        mid_tokens = lex_function(scratch.arena, 0, str8_substr(data, r1u64(relex_off, data.size)));
+        mid_tokens_count = mid_tokens.count;
       }
       
-      //- rjf: allocate & store line ranges
-      info.lines_count = line_count;
-      info.lines_ranges = push_array_no_zero(info_arena, Rng1U64, info.lines_count);
-      U64 line_idx = 0;
-      U64 line_start_idx = 0;
-      for(U64 idx = 0; idx <= data.size; idx += 1)
+      //- rjf: build tokens - prefix, relexed middle, shifted suffix
+      U64 suffix_tokens_count = base->tokens.ranges.count - suffix_tokens_base_idx;
+      TXT_TokenArray tokens = {0};
+      tokens.count = prefix_tokens_count + mid_tokens_count + suffix_tokens_count;
+      tokens.v = push_array_no_zero(scratch.arena, TXT_Token, tokens.count);
+      for(U64 idx = 0; idx < prefix_tokens_count; idx += 1)
       {
-        if(idx == data.size || data.str[idx] == '\n' || data.str[idx] == '\r')
-        {
-          Rng1U64 line_range = r1u64(line_start_idx, idx);
-          U64 line_size = dim_1u64(line_range);
-          info.lines_ranges[line_idx] = line_range;
-          info.lines_max_size = Max(info.lines_max_size, line_size);
-          line_idx += 1;
-          line_start_idx = idx+1;
-          if(idx < data.size && data.str[idx] == '\r')
-          {
-            line_start_idx += 1;
-            idx += 1;
-          }
-        }
-        if(idx && idx%1000 == 0)
-        {
-          ins_atomic_u64_add_eval(bytes_processed_ptr, 1000);
-        }
+        tokens.v[idx] = txt_token_from_packed_token_array_idx(&base->tokens, idx);
       }
-      
-      //- rjf: bump progress
-      if(bytes_processed_ptr)
+      for(U64 idx = 0; idx < mid_tokens_count; idx += 1)
       {
-        ins_atomic_u64_eval_assign(bytes_processed_ptr, Min(data.size, 1024) + data.size + data.size);
+        TXT_Token *dst = &tokens.v[prefix_tokens_count + idx];
+        dst->kind  = mid_tokens.v[idx].kind;
+        dst->range = r1u64(relex_off + mid_tokens.v[idx].range.min, relex_off + mid_tokens.v[idx].range.max);
       }
-      
-      //- rjf: lang -> lex function
-      TXT_LangLexFunctionType *lex_function = txt_lex_function_from_lang_kind(lang);
-      
-      //- rjf: lex function * data -> tokens
-      TXT_TokenArray tokens = {0};
-      if(lex_function != 0)
+      for(U64 idx = 0; idx < suffix_tokens_count; idx += 1)
       {
-        tokens = lex_function(info_arena, bytes_processed_ptr, data);
+        TXT_Token src = txt_token_from_packed_token_array_idx(&base->tokens, suffix_tokens_base_idx + idx);
+        TXT_Token *dst = &tokens.v[prefix_tokens_count + mid_tokens_count + idx];
+        dst->kind  = src.kind;
+        dst->range = r1u64((U64)((S64)src.range.min + delta), (U64)((S64)src.range.max + delta));
       }
-      info.tokens = tokens;
-      
-      //- rjf: bump progress
-      if(bytes_processed_ptr)
+      info_out->tokens = txt_packed_token_array_from_token_array(arena, &tokens);
+    }
+    
+    scratch_end(scratch);
+    result = 1;
+  }
+  return result;
+}
+
+////////////////////////////////
+//~ rjf: Cache Callbacks
+
+internal CE_COMPUTE_FUNCTION_DEF(txt_text_info_compute)
+{
+  HS_Scope *scope = hs_scope_open();
+  
+  //- rjf: unpack key
+  U128 hash = task->hash;
+  TXT_LangKind lang = TXT_LangKind_Null;
+  MemoryCopy(&lang, task->params.str, Min(sizeof(lang), task->params.size));
+  U64 *bytes_processed_ptr = task->progress_done;
+  U64 *bytes_to_process_ptr = task->progress_total;
+  
+  //- rjf: hash -> data
+  String8 data = hs_data_from_hash(scope, hash);
+  
+  //- rjf: try to skip work: hash * lang -> artifact -> text info. results
+  // from the mapped pack are used in-place, & need no arena.
+  Arena *info_arena = 0;
+  TXT_TextInfo info = {0};
+  U128 artifact_key = {0};
+  B32 got_artifact = 0;
+  if(data.size != 0)
+  {
+    info_arena = arena_alloc();
+    artifact_key = txt_artifact_key_from_hash_lang(hash, lang);
+    String8 artifact = ac_data_from_key(info_arena, artifact_key);
+    got_artifact = txt_text_info_from_artifact(artifact, &info);
+    if(got_artifact && ac_data_is_persistent(artifact))
+    {
+      arena_release(info_arena);
+      info_arena = 0;
+    }
+  }
+  
+  //- rjf: data -> text info
+  if(data.size != 0 && !got_artifact)
+  {
+    //- rjf: set # of bytes to process
+    //                                               (line ending counting)  (line measuring)   (lexing)
+    ins_atomic_u64_eval_assign(bytes_to_process_ptr, data.size             + data.size        + data.size*(lang != TXT_LangKind_Null));
+    
+    //- rjf: count line endings of each kind, & pick the line end kind from
+    // all of them
+    info.line_end_counts = txt_line_end_counts_from_data(bytes_processed_ptr, data);
+    info.line_end_kind = txt_line_end_kind_from_counts(info.line_end_counts);
+    
+    //- rjf: bump progress
+    ins_atomic_u64_eval_assign(bytes_processed_ptr, data.size);
+    
+    //- rjf: lang -> lex function
+    TXT_LangLexFunctionType *lex_function = txt_lex_function_from_lang_kind(lang);
+    
+    //- rjf: the previous version of this data has text info, & an unchanged
+    // prefix or suffix -> reuse its lines & tokens, & only rebuild the middle
+    B32 got_incremental = 0;
+    {
+      HS_Diff diff = hs_diff_from_hash(hash);
+      if(diff.prefix_size + diff.suffix_size != 0)
       {
-        ins_atomic_u64_eval_assign(bytes_processed_ptr, Min(data.size, 1024) + data.size + data.size + data.size*(lex_function != 0));
+        CE_Scope *ce_scope = ce_scope_open();
+        TXT_Value base_val = {0};
+        if(ce_peek_val_from_hash_params(ce_scope, txt_shared->cache, diff.base_hash, task->params, &base_val) &&
+           !base_val.info.tokens_are_partial)
+        {
+          got_incremental = txt_text_info_from_data_base_diff(info_arena, data, lang, &base_val.info, &diff, &info);
+        }
+        ce_scope_close(ce_scope);
       }
     }
     
-    //- rjf: commit results to cache
-    if(got_task) OS_MutexScopeW(stripe->rw_mutex)
+    //- rjf: otherwise, build from scratch
+    if(!got_incremental)
     {
-      for(TXT_Node *n = slot->first; n != 0; n = n->next)
+      Temp scratch = scratch_begin(&info_arena, 1);
+      
+      //- rjf: measure & pack line ranges
+      info.lines_count = txt_line_count_from_line_end_counts(info.line_end_counts);
+      Rng1U64 *lines_ranges = push_array_no_zero(scratch.arena, Rng1U64, info.lines_count);
+      info.lines_max_size = txt_line_ranges_from_data(bytes_processed_ptr, data, lines_ranges, info.lines_count);
+      info.lines = txt_packed_range_array_from_rng1u64s(info_arena, lines_ranges, info.lines_count);
+      
+      //- rjf: bump progress
+      ins_atomic_u64_eval_assign(bytes_processed_ptr, data.size + data.size);
+      
+      //- rjf: large data -> publish line ranges, then tokens for the visible
+      // lines, before lexing everything. both share this task's line ranges.
+      if(data.size >= TXT_VIEWPORT_LEX_MIN_SIZE && lex_function != 0 && txt_lang_kind_is_relexable(lang))
       {
-        if(u128_match(n->hash, hash) && n->lang == lang)
+        TXT_Value partial_val = {0};
+        partial_val.info = info;
+        partial_val.info.tokens_are_partial = 1;
+        partial_val.info.bytes_processed    = data.size + data.size;
+        partial_val.info.bytes_to_process   = data.size + data.size + data.size;
+        ce_task_publish_val(task, &partial_val);
+        Rng1S64 visible_line_range = txt_visible_line_range_from_hash_lang(hash, lang);
+        if(visible_line_range.min == 0)
         {
-          n->arena = info_arena;
-          info.bytes_processed = n->info.bytes_processed;
-          info.bytes_to_process = n->info.bytes_to_process;
-          MemoryCopyStruct(&n->info, &info);
-          ins_atomic_u32_eval_assign(&n->is_working, 0);
-          ins_atomic_u64_inc_eval(&n->load_count);
-          break;
+          visible_line_range = r1s64(1, TXT_VIEWPORT_LEX_DEFAULT_LINE_COUNT);
         }
+        visible_line_range.min -= TXT_VIEWPORT_LEX_PAD_LINE_COUNT;
+        visible_line_range.max += TXT_VIEWPORT_LEX_PAD_LINE_COUNT;
+        partial_val.arena = arena_alloc();
+        TXT_TokenArray visible_tokens = txt_token_array_from_data_lang_line_range(scratch.arena, data, lang, &info, visible_line_range);
+        partial_val.info.tokens = txt_packed_token_array_from_token_array(partial_val.arena, &visible_tokens);
+        ce_task_publish_val(task, &partial_val);
       }
+      
+      //- rjf: lex function * data -> tokens
+      TXT_TokenArray tokens = txt_token_array_from_data_lang__parallel(scratch.arena, bytes_processed_ptr, data, lang);
+      info.tokens = txt_packed_token_array_from_token_array(info_arena, &tokens);
+      
+      scratch_end(scratch);
     }
     
-    hs_scope_close(scope);
+    //- rjf: bump progress
+    ins_atomic_u64_eval_assign(bytes_processed_ptr, data.size + data.size + data.size*(lex_function != 0));
+    
+    //- rjf: persist
+    info.bytes_to_process = data.size + data.size + data.size*(lex_function != 0);
+    info.bytes_processed = info.bytes_to_process;
+    txt_artifact_submit(artifact_key, &info);
   }
+  
+  //- rjf: fill value
+  TXT_Value *val = (TXT_Value *)val_out;
+  val->arena = info_arena;
+  MemoryCopyStruct(&val->info, &info);
+  
+  hs_scope_close(scope);
 }
 
-////////////////////////////////
-//~ rjf: Evictor Threads
+internal CE_RELEASE_FUNCTION_DEF(txt_text_info_release)
+{
+  TXT_Value *v = (TXT_Value *)val;
+  if(v->arena != 0)
+  {
+    arena_release(v->arena);
+  }
+}
 
-internal void
-txt_evictor_thread__entry_point(void *p)
+internal CE_COMPUTE_FUNCTION_DEF(txt_search_compute)
 {
-  for(;;)
+  HS_Scope *scope = hs_scope_open();
+  Temp scratch = scratch_begin(0, 0);
+  
+  //- rjf: unpack key
+  U128 hash = task->hash;
+  TXT_SearchFlags flags = 0;
+  MemoryCopy(&flags, task->params.str, Min(sizeof(flags), task->params.size));
+  String8 needle = str8_skip(task->params, sizeof(flags));
+  
+  //- rjf: hash -> data
+  String8 data = hs_data_from_hash(scope, hash);
+  ins_atomic_u64_eval_assign(task->progress_total, data.size);
+  
+  //- rjf: search in stages, each twice the size of the last. all stages but
+  // the last publish a copy of the matches found so far.
+  U64 matches_count = 0;
+  U64 matches_cap = 0;
+  Rng1U64 *matches = 0;
+  U64 stage_size = TXT_SEARCH_FIRST_STAGE_SIZE;
+  for(U64 off = 0, stage_max = 0; stage_max < data.size && needle.size != 0; stage_size *= 2)
   {
-    U64 check_time_us = os_now_microseconds();
-    U64 check_time_user_clocks = txt_user_clock_idx();
-    U64 evict_threshold_us = 10*1000000;
-    U64 evict_threshold_user_clocks = 10;
-    for(U64 slot_idx = 0; slot_idx < txt_shared->slots_count; slot_idx += 1)
+    //- rjf: find all matches starting within this stage
+    stage_max = Min(data.size, stage_max + stage_size);
+    for(;off < stage_max;)
     {
-      U64 stripe_idx = slot_idx%txt_shared->stripes_count;
-      TXT_Slot *slot = &txt_shared->slots[slot_idx];
-      TXT_Stripe *stripe = &txt_shared->stripes[stripe_idx];
-      B32 slot_has_work = 0;
-      OS_MutexScopeR(stripe->rw_mutex)
+      U64 match_off = txt_search_match_off_from_data_range_needle_flags(data, r1u64(off, stage_max), needle, flags);
+      if(match_off >= stage_max)
       {
-        for(TXT_Node *n = slot->first; n != 0; n = n->next)
-        {
-          if(n->scope_ref_count == 0 &&
-             n->last_time_touched_us+evict_threshold_us <= check_time_us &&
-             n->last_user_clock_idx_touched+evict_threshold_user_clocks <= check_time_user_clocks &&
-             n->load_count != 0 &&
-             n->is_working == 0)
-          {
-            slot_has_work = 1;
-            break;
-          }
-        }
+        off = stage_max;
+        break;
       }
-      if(slot_has_work) OS_MutexScopeW(stripe->rw_mutex)
+      if(matches_count == matches_cap)
       {
-        for(TXT_Node *n = slot->first, *next = 0; n != 0; n = next)
-        {
-          next = n->next;
-          if(n->scope_ref_count == 0 &&
-             n->last_time_touched_us+evict_threshold_us <= check_time_us &&
-             n->last_user_clock_idx_touched+evict_threshold_user_clocks <= check_time_user_clocks &&
-             n->load_count != 0 &&
-             n->is_working == 0)
-          {
-            DLLRemove(slot->first, slot->last, n);
-            if(n->arena != 0)
-            {
-              arena_release(n->arena);
-            }
-            SLLStackPush(txt_shared->stripes_free_nodes[stripe_idx], n);
-          }
-        }
+        U64 new_matches_cap = Max(matches_cap*2, 256);
+        Rng1U64 *new_matches = push_array_no_zero(scratch.arena, Rng1U64, new_matches_cap);
+        MemoryCopy(new_matches, matches, sizeof(Rng1U64)*matches_count);
+        matches = new_matches;
+        matches_cap = new_matches_cap;
       }
-      os_sleep_milliseconds(5);
+      matches[matches_count] = r1u64(match_off, match_off + needle.size);
+      matches_count += 1;
+      off = match_off + 1;
+    }
+    ins_atomic_u64_eval_assign(task->progress_done, stage_max);
+    
+    //- rjf: more to search -> publish partial results
+    if(stage_max < data.size)
+    {
+      TXT_SearchValue partial_val = {0};
+      partial_val.arena = arena_alloc();
+      partial_val.results.matches_count   = matches_count;
+      partial_val.results.matches         = push_array_no_zero(partial_val.arena, Rng1U64, matches_count);
+      partial_val.results.bytes_searched  = stage_max;
+      partial_val.results.bytes_to_search = data.size;
+      MemoryCopy(partial_val.results.matches, matches, sizeof(Rng1U64)*matches_count);
+      ce_task_publish_val(task, &partial_val);
     }
-    os_sleep_milliseconds(1000);
+  }
+  
+  //- rjf: fill value
+  TXT_SearchValue *val = (TXT_SearchValue *)val_out;
+  val->arena = arena_alloc();
+  val->results.matches_count   = matches_count;
+  val->results.matches         = push_array_no_zero(val->arena, Rng1U64, matches_count);
+  val->results.bytes_searched  = data.size;
+  val->results.bytes_to_search = data.size;
+  val->results.is_complete     = 1;
+  MemoryCopy(val->results.matches, matches, sizeof(Rng1U64)*matches_count);
+  
+  scratch_end(scratch);
+  hs_scope_close(scope);
+}
+
+internal CE_RELEASE_FUNCTION_DEF(txt_search_release)
+{
+  TXT_SearchValue *v = (TXT_SearchValue *)val;
+  if(v->arena != 0)
+  {
+    arena_release(v->arena);
   }
 }
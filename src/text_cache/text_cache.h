@@ -4,6 +4,13 @@
 #ifndef TEXT_CACHE_H
 #define TEXT_CACHE_H
 
+////////////////////////////////
+//~ rjf: Foreign Includes
+
+#if ARCH_X64
+# include <emmintrin.h>
+#endif
+
 ////////////////////////////////
 //~ rjf: Value Types
 
@@ -16,6 +23,14 @@ typedef enum TXT_LineEndKind
 }
 TXT_LineEndKind;
 
+typedef struct TXT_LineEndCounts TXT_LineEndCounts;
+struct TXT_LineEndCounts
+{
+  U64 lf_count;   // bare \n
+  U64 crlf_count; // \r\n
+  U64 cr_count;   // bare \r
+};
+
 typedef enum TXT_TokenKind
 {
   TXT_TokenKind_Null,
@@ -86,14 +101,52 @@ struct TXT_TokenArrayArray
   TXT_TokenArray *v;
 };
 
+////////////////////////////////
+//~ rjf: Packed Range Types
+//
+// Text info keeps its line & token ranges packed, as separate arrays: each
+// range is a 32-bit offset from the start of its block of
+// TXT_PACKED_RANGE_BLOCK_SIZE ranges, & a 16-bit size. Ranges which fit in
+// neither - very long lines or tokens, or ones starting over 4GB into their
+// block - store TXT_PACKED_RANGE_SIZE_OVERFLOW as their size, & are kept in
+// full in a side table, sorted by index. Ranges must be sorted by their
+// starts, so that they can be searched by offset.
+
+#define TXT_PACKED_RANGE_BLOCK_SIZE    256
+#define TXT_PACKED_RANGE_SIZE_OVERFLOW max_U16
+
+typedef struct TXT_PackedRangeArray TXT_PackedRangeArray;
+struct TXT_PackedRangeArray
+{
+  U64 count;
+  U64 *block_base_offs;
+  U32 *offs;
+  U16 *sizes;
+  U64 overflow_count;
+  U64 *overflow_idxs;
+  Rng1U64 *overflow_ranges;
+};
+
+typedef struct TXT_PackedTokenArray TXT_PackedTokenArray;
+struct TXT_PackedTokenArray
+{
+  TXT_PackedRangeArray ranges;
+  U8 *kinds;
+};
+
+////////////////////////////////
+//~ rjf: Text Info Types
+
 typedef struct TXT_TextInfo TXT_TextInfo;
 struct TXT_TextInfo
 {
   U64 lines_count;
-  Rng1U64 *lines_ranges;
+  TXT_PackedRangeArray lines;
   U64 lines_max_size;
   TXT_LineEndKind line_end_kind;
-  TXT_TokenArray tokens;
+  TXT_LineEndCounts line_end_counts;
+  TXT_PackedTokenArray tokens;
+  B32 tokens_are_partial;
   U64 bytes_processed;
   U64 bytes_to_process;
 };
@@ -123,75 +176,230 @@ TXT_LangKind;
 typedef TXT_TokenArray TXT_LangLexFunctionType(Arena *arena, U64 *bytes_processed_counter, String8 string);
 
 ////////////////////////////////
-//~ rjf: Cache Types
+//~ rjf: Lexer Rule Types
+//
+// The C/C++, Odin, Jai, & Zig lexers are one table-driven lexer, parameterized
+// by TXT_LexRules which are generated from text_cache.mdesk. Each byte maps to
+// the set of roles it can play in starting or continuing a token.
+
+typedef U8 TXT_ByteClassFlags;
+enum
+{
+  TXT_ByteClassFlag_Whitespace      = (1<<0),
+  TXT_ByteClassFlag_IdentStart      = (1<<1),
+  TXT_ByteClassFlag_IdentContinue   = (1<<2),
+  TXT_ByteClassFlag_Digit           = (1<<3),
+  TXT_ByteClassFlag_NumericContinue = (1<<4),
+  TXT_ByteClassFlag_Symbol          = (1<<5),
+  TXT_ByteClassFlag_SymbolContinue  = (1<<6),
+  TXT_ByteClassFlag_Meta            = (1<<7),
+};
 
-typedef struct TXT_Node TXT_Node;
-struct TXT_Node
+typedef U32 TXT_LexRuleFlags;
+enum
 {
-  // rjf: links
-  TXT_Node *next;
-  TXT_Node *prev;
-  
-  // rjf: key
-  U128 hash;
-  TXT_LangKind lang;
-  
-  // rjf: artifacts
-  Arena *arena;
-  TXT_TextInfo info;
-  
-  // rjf: metadata
-  B32 is_working;
-  U64 scope_ref_count;
-  U64 last_time_touched_us;
-  U64 last_user_clock_idx_touched;
-  U64 load_count;
+  TXT_LexRuleFlag_BlockComments = (1<<0), // /* */ comments
+  TXT_LexRuleFlag_LineStrings   = (1<<1), // \\ strings, running to the end of the line
+  TXT_LexRuleFlag_MetaSpansLine = (1<<2), // meta tokens run to the end of the (unescaped) line, rather than the end of the word
 };
 
-typedef struct TXT_Slot TXT_Slot;
-struct TXT_Slot
+typedef B32 TXT_KeywordMatchFunctionType(String8 string);
+
+typedef struct TXT_LexRules TXT_LexRules;
+struct TXT_LexRules
 {
-  TXT_Node *first;
-  TXT_Node *last;
+  TXT_ByteClassFlags *byte_classes;
+  TXT_KeywordMatchFunctionType *keyword_match;
+  TXT_LexRuleFlags flags;
 };
 
-typedef struct TXT_Stripe TXT_Stripe;
-struct TXT_Stripe
+////////////////////////////////
+//~ rjf: Generated Code
+
+#include "text_cache/generated/text_cache.meta.h"
+
+////////////////////////////////
+//~ rjf: Artifact Cache Types
+//
+// Text info is persisted in the artifact cache as this header, followed by
+// the packed line & token arrays, ordered by alignment: the block base offsets
+// & overflow tables (lines, then tokens), then offsets, then sizes, then token
+// kinds. Bump the version whenever line measurement, any lexer, or any of
+// these layouts change.
+
+#define TXT_ARTIFACT_VERSION 4
+
+typedef struct TXT_TextInfoArtifactHeader TXT_TextInfoArtifactHeader;
+struct TXT_TextInfoArtifactHeader
 {
-  Arena *arena;
-  OS_Handle rw_mutex;
-  OS_Handle cv;
+  U64 lines_count;
+  U64 lines_max_size;
+  U64 line_end_kind;
+  TXT_LineEndCounts line_end_counts;
+  U64 lines_overflow_count;
+  U64 tokens_count;
+  U64 tokens_overflow_count;
+  U64 bytes_to_process;
 };
 
 ////////////////////////////////
-//~ rjf: Scoped Access
+//~ rjf: Line Scanning Types
+//
+// Line ranges are built in two passes over the data, each of which works on
+// 64-byte blocks: a block's bytes are compared against `\n` and `\r` (four
+// 16-byte SSE2 compares on x64, a byte loop elsewhere), producing one bit per
+// byte for each. The first pass popcounts those masks to count every kind of
+// line ending - which sizes the line range array, & picks the file's line end
+// kind from all of its endings - and the second visits only the set bits of
+// the masks to write the line ranges.
+//
+// A `\r\n` pair is one line ending; a `\n` is folded into a `\r` in the
+// previous byte by shifting the `\r` mask up by one, carrying its top bit
+// into the next block.
+
+#define TXT_LINE_SCAN_BLOCK_SIZE 64
+#define TXT_LINE_SCAN_PROGRESS_GRANULARITY KB(64)
+
+////////////////////////////////
+//~ rjf: Incremental Text Info Constants
+//
+// Data which replaced a previous version of the same key carries a hash store
+// diff - the sizes of its unchanged prefix & suffix. If the previous version's
+// text info is still cached, its lines & tokens within those are reused, & the
+// middle is rescanned & relexed only until both are back in sync, within this
+// window past the start of the unchanged suffix.
+
+#define TXT_RELEX_WINDOW_SIZE KB(4)
 
-typedef struct TXT_Touch TXT_Touch;
-struct TXT_Touch
+////////////////////////////////
+//~ rjf: Parallel Lexing Types
+//
+// Large files are split into pieces, which are lexed on task threads. Each
+// piece starts at a line start which a cheap pre-scan judged to be outside of
+// comments & strings, & is lexed one byte into the next piece - so a piece's
+// tokens show whether one really starts at the next piece's start. That split
+// is kept only if so; otherwise, the pieces on either side are relexed as one.
+
+#define TXT_PARALLEL_LEX_MIN_SIZE   MB(1)
+#define TXT_PARALLEL_LEX_PIECE_SIZE KB(256)
+
+typedef struct TXT_LexPiece TXT_LexPiece;
+struct TXT_LexPiece
 {
-  TXT_Touch *next;
-  U128 hash;
-  TXT_LangKind lang;
+  Arena *arena;
+  Rng1U64 range;
+  TXT_TokenArray tokens;
 };
 
-typedef struct TXT_Scope TXT_Scope;
-struct TXT_Scope
+typedef struct TXT_LexShared TXT_LexShared;
+struct TXT_LexShared
 {
-  TXT_Scope *next;
-  TXT_Touch *top_touch;
+  Arena *arena;
+  U64 ref_count;
+  TXT_LangLexFunctionType *lex_function;
+  String8 data;
+  U64 *bytes_processed_counter;
+  TXT_LexPiece *pieces;
+  U64 piece_count;
+  U64 piece_claim_gen;
+  U64 piece_done_count;
 };
 
 ////////////////////////////////
-//~ rjf: Thread Context
+//~ rjf: Viewport-First Lexing Types
+//
+// Large files are published in stages, so that they can be shown long before
+// they are fully lexed: first with only line ranges, then with tokens for the
+// lines which are on screen, & finally with all tokens. Later stages share
+// the first stage's line ranges.
+//
+// Which lines are on screen is not part of a text info's key. Instead, the
+// thread doing a lookup may describe the lines it is about to show, with
+// `TXT_VisibleLineRangeScope`; lookups of text info which is not yet fully
+// lexed leave that range as a hint for the text info's task. Visible lines
+// are lexed from the last line start before them which the parallel lexer's
+// pre-scan would split at, so they may be briefly mis-lexed (e.g. if that
+// pre-scan misjudges a string) until the final stage replaces them.
+
+#define TXT_VIEWPORT_LEX_MIN_SIZE           MB(1)
+#define TXT_VIEWPORT_LEX_DEFAULT_LINE_COUNT 256
+#define TXT_VIEWPORT_LEX_PAD_LINE_COUNT     64
+#define TXT_VIEWPORT_LEX_RESUME_SPACING     KB(16)
+#define TXT_VISIBLE_LINE_RANGE_STACK_CAP    16
+#define TXT_VISIBLE_HINT_SLOTS_COUNT        64
+
+typedef struct TXT_VisibleHint TXT_VisibleHint;
+struct TXT_VisibleHint
+{
+  U128 hash;
+  TXT_LangKind lang;
+  Rng1S64 line_range;
+  U64 touch_idx;
+};
 
 typedef struct TXT_TCTX TXT_TCTX;
 struct TXT_TCTX
+{
+  Rng1S64 visible_line_range_stack[TXT_VISIBLE_LINE_RANGE_STACK_CAP];
+  U64 visible_line_range_stack_count;
+};
+
+////////////////////////////////
+//~ rjf: Search Types
+//
+// Searches for a needle within some data are done on the search cache's
+// worker threads, & keyed by the data's hash, the needle, & search flags.
+// Candidate offsets are found 16 bytes at a time, by comparing against the
+// needle's first & last bytes, & are then checked in full. Every offset at
+// which the needle matches is recorded, so matches may overlap (e.g. "aa" in
+// "aaaa" matches at 0, 1, & 2), just as a byte-by-byte search would find.
+//
+// Matches are published in stages, each covering twice the bytes of the last,
+// so that the first matches in large data are available long before all of
+// it is searched. A partial result holds every match which starts before
+// `bytes_searched`.
+
+#define TXT_SEARCH_FIRST_STAGE_SIZE MB(1)
+
+typedef U32 TXT_SearchFlags;
+enum
+{
+  TXT_SearchFlag_CaseInsensitive = (1<<0),
+  TXT_SearchFlag_WholeWord       = (1<<1),
+};
+
+typedef struct TXT_SearchResults TXT_SearchResults;
+struct TXT_SearchResults
+{
+  U64 matches_count;
+  Rng1U64 *matches;
+  U64 bytes_searched;
+  U64 bytes_to_search;
+  B32 is_complete;
+};
+
+////////////////////////////////
+//~ rjf: Cache Value Type
+
+typedef struct TXT_Value TXT_Value;
+struct TXT_Value
 {
   Arena *arena;
-  TXT_Scope *free_scope;
-  TXT_Touch *free_touch;
+  TXT_TextInfo info;
 };
 
+typedef struct TXT_SearchValue TXT_SearchValue;
+struct TXT_SearchValue
+{
+  Arena *arena;
+  TXT_SearchResults results;
+};
+
+////////////////////////////////
+//~ rjf: Scoped Access
+
+typedef CE_Scope TXT_Scope;
+
 ////////////////////////////////
 //~ rjf: Shared State
 
@@ -200,37 +408,23 @@ struct TXT_Shared
 {
   Arena *arena;
   
-  // rjf: user clock
-  U64 user_clock_idx;
-  
-  // rjf: cache
-  U64 slots_count;
-  U64 stripes_count;
-  TXT_Slot *slots;
-  TXT_Stripe *stripes;
-  TXT_Node **stripes_free_nodes;
-  
-  // rjf: user -> parse thread
-  U64 u2p_ring_size;
-  U8 *u2p_ring_base;
-  U64 u2p_ring_write_pos;
-  U64 u2p_ring_read_pos;
-  OS_Handle u2p_ring_cv;
-  OS_Handle u2p_ring_mutex;
+  // rjf: hash * lang -> text info cache
+  CE_Cache *cache;
   
-  // rjf: parse threads
-  U64 parse_thread_count;
-  OS_Handle *parse_threads;
+  // rjf: hash * needle * flags -> search results cache
+  CE_Cache *search_cache;
   
-  // rjf: evictor thread
-  OS_Handle evictor_thread;
+  // rjf: visible line range hints, for text info which is still being lexed
+  OS_Handle visible_hints_mutex;
+  TXT_VisibleHint visible_hints[TXT_VISIBLE_HINT_SLOTS_COUNT];
+  U64 visible_hints_touch_idx;
 };
 
 ////////////////////////////////
 //~ rjf: Globals
 
-thread_static TXT_TCTX *txt_tctx = 0;
 global TXT_Shared *txt_shared = 0;
+thread_static TXT_TCTX txt_tctx = {0};
 
 ////////////////////////////////
 //~ rjf: Basic Helpers
@@ -239,6 +433,7 @@ internal TXT_LangKind txt_lang_kind_from_extension(String8 extension);
 internal String8 txt_extension_from_lang_kind(TXT_LangKind kind);
 internal TXT_LangKind txt_lang_kind_from_architecture(Architecture arch);
 internal TXT_LangLexFunctionType *txt_lex_function_from_lang_kind(TXT_LangKind kind);
+internal B32 txt_lang_kind_is_relexable(TXT_LangKind kind);
 
 ////////////////////////////////
 //~ rjf: Token Type Functions
@@ -248,9 +443,21 @@ internal void txt_token_list_push(Arena *arena, TXT_TokenList *list, TXT_Token *
 internal TXT_TokenArray txt_token_array_from_chunk_list(Arena *arena, TXT_TokenChunkList *list);
 internal TXT_TokenArray txt_token_array_from_list(Arena *arena, TXT_TokenList *list);
 
+////////////////////////////////
+//~ rjf: Packed Range Functions
+
+internal TXT_PackedRangeArray txt_packed_range_array_from_rng1u64s__stride(Arena *arena, Rng1U64 *first, U64 stride, U64 count);
+internal TXT_PackedRangeArray txt_packed_range_array_from_rng1u64s(Arena *arena, Rng1U64 *ranges, U64 count);
+internal TXT_PackedTokenArray txt_packed_token_array_from_token_array(Arena *arena, TXT_TokenArray *tokens);
+internal Rng1U64 txt_range_from_packed_range_array_idx(TXT_PackedRangeArray *array, U64 idx);
+internal U64 txt_idx_upper_bound_from_packed_range_array_off(TXT_PackedRangeArray *array, U64 off);
+internal TXT_Token txt_token_from_packed_token_array_idx(TXT_PackedTokenArray *tokens, U64 idx);
+internal TXT_TokenArray txt_token_array_from_packed_token_array_idx_range(Arena *arena, TXT_PackedTokenArray *tokens, Rng1U64 idx_range);
+
 ////////////////////////////////
 //~ rjf: Lexing Functions
 
+internal TXT_TokenArray txt_token_array_from_string__rules(Arena *arena, U64 *bytes_processed_counter, String8 string, TXT_LexRules *rules);
 internal TXT_TokenArray txt_token_array_from_string__c_cpp(Arena *arena, U64 *bytes_processed_counter, String8 string);
 internal TXT_TokenArray txt_token_array_from_string__odin(Arena *arena, U64 *bytes_processed_counter, String8 string);
 internal TXT_TokenArray txt_token_array_from_string__jai(Arena *arena, U64 *bytes_processed_counter, String8 string);
@@ -258,14 +465,49 @@ internal TXT_TokenArray txt_token_array_from_string__zig(Arena *arena, U64 *byte
 internal TXT_TokenArray txt_token_array_from_string__disasm_x64_intel(Arena *arena, U64 *bytes_processed_counter, String8 string);
 
 ////////////////////////////////
-//~ rjf: Main Layer Initialization
+//~ rjf: Line Scanning Functions
 
-internal void txt_init(void);
+internal void txt_line_end_masks_from_block(U8 *block, U64 size, U64 *lf_mask_out, U64 *cr_mask_out);
+internal TXT_LineEndCounts txt_line_end_counts_from_data(U64 *bytes_processed_counter, String8 data);
+internal TXT_LineEndKind txt_line_end_kind_from_counts(TXT_LineEndCounts counts);
+internal U64 txt_line_count_from_line_end_counts(TXT_LineEndCounts counts);
+internal U64 txt_line_ranges_from_data(U64 *bytes_processed_counter, String8 data, Rng1U64 *lines_out, U64 lines_count);
 
 ////////////////////////////////
-//~ rjf: Thread Context Initialization
+//~ rjf: Parallel Lexing
 
-internal void txt_tctx_ensure_inited(void);
+internal U64 *txt_lex_split_offs_from_data(Arena *arena, String8 data, U64 split_count_max, U64 *split_count_out);
+internal void txt_lex_shared_release(TXT_LexShared *shared);
+internal B32 txt_lex_do_work(TXT_LexShared *shared);
+internal TS_TASK_FUNCTION_DEF(txt_lex_task__entry_point);
+internal TXT_TokenArray txt_token_array_from_data_lang__parallel(Arena *arena, U64 *bytes_processed_counter, String8 data, TXT_LangKind lang);
+
+////////////////////////////////
+//~ rjf: Search Functions
+
+internal B32 txt_search_needle_matches_data_off(String8 data, U64 off, String8 needle, TXT_SearchFlags flags);
+internal U64 txt_search_match_off_from_data_range_needle_flags(String8 data, Rng1U64 range, String8 needle, TXT_SearchFlags flags);
+internal U64 txt_search_last_match_off_from_data_range_needle_flags(String8 data, Rng1U64 range, String8 needle, TXT_SearchFlags flags);
+internal String8 txt_search_params_from_needle_flags(Arena *arena, String8 needle, TXT_SearchFlags flags);
+internal U64 txt_search_match_idx_upper_bound_from_results_off(TXT_SearchResults *results, U64 off);
+
+////////////////////////////////
+//~ rjf: Artifact Cache Helpers
+
+internal U128 txt_artifact_key_from_hash_lang(U128 hash, TXT_LangKind lang);
+internal B32 txt_text_info_from_artifact(String8 artifact, TXT_TextInfo *info_out);
+internal void txt_artifact_submit(U128 key, TXT_TextInfo *info);
+
+////////////////////////////////
+//~ rjf: Incremental Text Info
+
+internal U64 txt_token_idx_upper_bound_from_off(TXT_Token *tokens, U64 tokens_count, U64 off);
+internal B32 txt_text_info_from_data_base_diff(Arena *arena, String8 data, TXT_LangKind lang, TXT_TextInfo *base, HS_Diff *diff, TXT_TextInfo *info_out);
+
+////////////////////////////////
+//~ rjf: Main Layer Initialization
+
+internal void txt_init(void);
 
 ////////////////////////////////
 //~ rjf: User Clock
@@ -278,20 +520,38 @@ internal U64 txt_user_clock_idx(void);
 
 internal TXT_Scope *txt_scope_open(void);
 internal void txt_scope_close(TXT_Scope *scope);
-internal void txt_scope_touch_node__stripe_r_guarded(TXT_Scope *scope, TXT_Node *node);
+
+////////////////////////////////
+//~ rjf: Visible Line Range Hints
+
+internal void txt_push_visible_line_range(Rng1S64 line_range);
+internal void txt_pop_visible_line_range(void);
+internal Rng1S64 txt_top_visible_line_range(void);
+#define TXT_VisibleLineRangeScope(line_range) DeferLoop(txt_push_visible_line_range(line_range), txt_pop_visible_line_range())
+internal void txt_visible_hint_store(U128 hash, TXT_LangKind lang, Rng1S64 line_range);
+internal Rng1S64 txt_visible_line_range_from_hash_lang(U128 hash, TXT_LangKind lang);
+
+////////////////////////////////
+//~ rjf: Viewport-First Lexing
+
+internal U64 txt_lex_resume_off_from_data_off(String8 data, U64 off);
+internal TXT_TokenArray txt_token_array_from_data_lang_line_range(Arena *arena, String8 data, TXT_LangKind lang, TXT_TextInfo *info, Rng1S64 line_range);
 
 ////////////////////////////////
 //~ rjf: Cache Lookups
 
 internal TXT_TextInfo txt_text_info_from_hash_lang(TXT_Scope *scope, U128 hash, TXT_LangKind lang);
 internal TXT_TextInfo txt_text_info_from_key_lang(TXT_Scope *scope, U128 key, TXT_LangKind lang, U128 *hash_out);
+internal TXT_SearchResults txt_search_results_from_hash_needle_flags(TXT_Scope *scope, U128 hash, String8 needle, TXT_SearchFlags flags);
 
 ////////////////////////////////
 //~ rjf: Text Info Extractor Helpers
 
 internal U64 txt_off_from_info_pt(TXT_TextInfo *info, TxtPt pt);
-internal TxtPt txt_pt_from_info_off__linear_scan(TXT_TextInfo *info, U64 off);
-internal TXT_TokenArray txt_token_array_from_info_line_num__linear_scan(TXT_TextInfo *info, S64 line_num);
+internal TxtPt txt_pt_from_info_off(TXT_TextInfo *info, U64 off);
+internal Rng1U64 txt_line_range_from_info_line_num(TXT_TextInfo *info, S64 line_num);
+internal TXT_Token txt_token_from_info_idx(TXT_TextInfo *info, U64 idx);
+internal TXT_TokenArray txt_token_array_from_info_line_num(Arena *arena, TXT_TextInfo *info, S64 line_num);
 internal Rng1U64 txt_expr_off_range_from_line_off_range_string_tokens(U64 off, Rng1U64 line_range, String8 line_text, TXT_TokenArray *line_tokens);
 internal Rng1U64 txt_expr_off_range_from_info_data_pt(TXT_TextInfo *info, String8 data, TxtPt pt);
 internal String8 txt_string_from_info_data_txt_rng(TXT_TextInfo *info, String8 data, TxtRng rng);
@@ -299,15 +559,11 @@ internal String8 txt_string_from_info_data_line_num(TXT_TextInfo *info, String8
 internal TXT_LineTokensSlice txt_line_tokens_slice_from_info_data_line_range(Arena *arena, TXT_TextInfo *info, String8 data, Rng1S64 line_range);
 
 ////////////////////////////////
-//~ rjf: Parse Threads
-
-internal B32 txt_u2p_enqueue_req(U128 hash, TXT_LangKind lang, U64 endt_us);
-internal void txt_u2p_dequeue_req(U128 *hash_out, TXT_LangKind *lang_out);
-internal void txt_parse_thread__entry_point(void *p);
-
-////////////////////////////////
-//~ rjf: Evictor Threads
+//~ rjf: Cache Callbacks
 
-internal void txt_evictor_thread__entry_point(void *p);
+internal CE_COMPUTE_FUNCTION_DEF(txt_text_info_compute);
+internal CE_RELEASE_FUNCTION_DEF(txt_text_info_release);
+internal CE_COMPUTE_FUNCTION_DEF(txt_search_compute);
+internal CE_RELEASE_FUNCTION_DEF(txt_search_release);
 
 #endif // TEXT_CACHE_H
@@ -90,6 +90,378 @@ txti_msg_list_deep_copy(Arena *arena, TXTI_MsgList *src)
   return dst;
 }
 
+////////////////////////////////
+//~ rjf: Buffer Chunk Functions
+
+internal void *
+txti_array_reserve(Arena *arena, void *v, U64 count, U64 *cap, U64 needed_cap, U64 element_size)
+{
+  void *result = v;
+  if(*cap < needed_cap)
+  {
+    U64 new_cap = Max(*cap*2, needed_cap);
+    result = push_array_no_zero(arena, U8, new_cap*element_size);
+    MemoryCopy(result, v, count*element_size);
+    *cap = new_cap;
+  }
+  return result;
+}
+
+internal TXTI_Chunk *
+txti_buffer_push_chunk(TXTI_Buffer *buffer)
+{
+  // rjf: full, & at least half of the chunks were trimmed -> rotate trimmed
+  // chunks to the end, so that their storage can be reused
+  if(buffer->chunks_count == buffer->chunks_cap && buffer->chunks_first_idx*2 >= buffer->chunks_count && buffer->chunks_first_idx != 0)
+  {
+    Temp scratch = scratch_begin(0, 0);
+    U64 trimmed_count = buffer->chunks_first_idx;
+    U64 live_count = buffer->chunks_count - buffer->chunks_first_idx;
+    TXTI_Chunk *trimmed = push_array_no_zero(scratch.arena, TXTI_Chunk, trimmed_count);
+    MemoryCopyTyped(trimmed, buffer->chunks, trimmed_count);
+    MemoryCopyTyped(buffer->chunks, buffer->chunks + trimmed_count, live_count);
+    MemoryCopyTyped(buffer->chunks + live_count, trimmed, trimmed_count);
+    buffer->chunks_first_idx = 0;
+    buffer->chunks_count = live_count;
+    scratch_end(scratch);
+  }
+  
+  // rjf: full -> grow
+  if(buffer->chunks_count == buffer->chunks_cap)
+  {
+    U64 new_cap = Max(16, buffer->chunks_cap*2);
+    TXTI_Chunk *new_chunks = push_array(buffer->analysis_arena, TXTI_Chunk, new_cap);
+    MemoryCopyTyped(new_chunks, buffer->chunks, buffer->chunks_count);
+    buffer->chunks = new_chunks;
+    buffer->chunks_cap = new_cap;
+  }
+  
+  // rjf: push chunk, keeping storage of trimmed chunk in this slot
+  TXTI_Chunk *chunk = &buffer->chunks[buffer->chunks_count];
+  {
+    TXTI_Chunk old = *chunk;
+    MemoryZeroStruct(chunk);
+    chunk->data.str     = old.data.str;
+    chunk->data_cap     = old.data_cap;
+    chunk->lines_ranges = old.lines_ranges;
+    chunk->lines_cap    = old.lines_cap;
+    chunk->tokens.v     = old.tokens.v;
+    chunk->tokens_cap   = old.tokens_cap;
+  }
+  if(buffer->chunks_count != 0)
+  {
+    TXTI_Chunk *prev = &buffer->chunks[buffer->chunks_count-1];
+    chunk->off           = prev->off + prev->data.size;
+    chunk->line_idx_base = prev->line_idx_base + prev->lines_count;
+  }
+  buffer->chunks_count += 1;
+  return chunk;
+}
+
+internal U64
+txti_chunk_idx_from_buffer_line_idx(TXTI_Buffer *buffer, U64 line_idx)
+{
+  U64 lo = buffer->chunks_first_idx;
+  U64 hi = buffer->chunks_count;
+  for(;lo < hi;)
+  {
+    U64 mid = lo + (hi-lo)/2;
+    if(buffer->chunks[mid].line_idx_base <= line_idx)
+    {
+      lo = mid+1;
+    }
+    else
+    {
+      hi = mid;
+    }
+  }
+  return lo > buffer->chunks_first_idx ? lo-1 : buffer->chunks_first_idx;
+}
+
+internal U64
+txti_chunk_line_idx_from_off(TXTI_Chunk *chunk, U64 off)
+{
+  U64 lo = 0;
+  U64 hi = chunk->lines_count;
+  for(;lo < hi;)
+  {
+    U64 mid = lo + (hi-lo)/2;
+    if(chunk->lines_ranges[mid].min <= off)
+    {
+      lo = mid+1;
+    }
+    else
+    {
+      hi = mid;
+    }
+  }
+  return lo > 0 ? lo-1 : 0;
+}
+
+internal void
+txti_chunk_measure_lines(TXTI_Buffer *buffer, TXTI_Chunk *chunk, U64 *bytes_processed_counter)
+{
+  // NOTE(rjf): only the chunk's last two lines can change when data is
+  // appended - the last one grows, & the one before it may have ended in a
+  // '\r' which now continues with a '\n' - so measuring restarts there.
+  U64 rescan_line_idx = chunk->lines_count > 2 ? chunk->lines_count-2 : 0;
+  U64 rescan_off = rescan_line_idx < chunk->lines_count ? chunk->lines_ranges[rescan_line_idx].min : 0;
+  String8 rescan_data = str8_skip(chunk->data, rescan_off);
+  TXT_LineEndCounts line_end_counts = txt_line_end_counts_from_data(bytes_processed_counter, rescan_data);
+  U64 rescan_lines_count = txt_line_count_from_line_end_counts(line_end_counts);
+  chunk->lines_ranges = (Rng1U64 *)txti_array_reserve(buffer->analysis_arena, chunk->lines_ranges, rescan_line_idx, &chunk->lines_cap, rescan_line_idx+rescan_lines_count, sizeof(Rng1U64));
+  U64 rescan_lines_max_size = txt_line_ranges_from_data(0, rescan_data, chunk->lines_ranges+rescan_line_idx, rescan_lines_count);
+  for(U64 idx = 0; idx < rescan_lines_count; idx += 1)
+  {
+    chunk->lines_ranges[rescan_line_idx+idx].min += rescan_off;
+    chunk->lines_ranges[rescan_line_idx+idx].max += rescan_off;
+  }
+  chunk->lines_count = rescan_line_idx+rescan_lines_count;
+  chunk->lines_max_size = Max(chunk->lines_max_size, rescan_lines_max_size);
+  buffer->lines_max_size = Max(buffer->lines_max_size, chunk->lines_max_size);
+}
+
+internal void
+txti_chunk_lex(TXTI_Buffer *buffer, TXTI_Chunk *chunk, TXT_LangLexFunctionType *lex_function)
+{
+  chunk->tokens.count = 0;
+  if(lex_function != 0)
+  {
+    Temp scratch = scratch_begin(0, 0);
+    TXT_TokenArray tokens = lex_function(scratch.arena, 0, chunk->data);
+    chunk->tokens.v = (TXT_Token *)txti_array_reserve(buffer->analysis_arena, chunk->tokens.v, 0, &chunk->tokens_cap, tokens.count, sizeof(TXT_Token));
+    MemoryCopy(chunk->tokens.v, tokens.v, sizeof(TXT_Token)*tokens.count);
+    chunk->tokens.count = tokens.count;
+    scratch_end(scratch);
+  }
+}
+
+internal void
+txti_chunk_seal(TXTI_Buffer *buffer, TXTI_Chunk *chunk, TXT_LangLexFunctionType *lex_function)
+{
+  // NOTE(rjf): sealed chunks end with a '\n' - the empty line after it is the
+  // first line of the next chunk.
+  txti_chunk_measure_lines(buffer, chunk, 0);
+  txti_chunk_lex(buffer, chunk, lex_function);
+  chunk->lines_count -= 1;
+}
+
+internal U64
+txti_chunk_spanning_token_opl_from_next_data(TXTI_Chunk *chunk, String8 next_data, TXT_LangLexFunctionType *lex_function)
+{
+  // NOTE(rjf): returns the end of the token which crosses the end of the
+  // chunk, given the data which follows it, relative to the chunk's start -
+  // or 0, if the chunk can be sealed there. only a window of the next data
+  // is lexed, so a token which runs past the window reports the window's end.
+  U64 result = 0;
+  if(lex_function != 0)
+  {
+    Temp scratch = scratch_begin(0, 0);
+    String8List parts = {0};
+    str8_list_push(scratch.arena, &parts, chunk->data);
+    str8_list_push(scratch.arena, &parts, str8_prefix(next_data, TXTI_CHUNK_SIZE_TARGET));
+    String8 data = str8_list_join(scratch.arena, &parts, 0);
+    TXT_TokenArray tokens = lex_function(scratch.arena, 0, data);
+    U64 off = chunk->data.size;
+    U64 next_token_idx = txt_token_idx_upper_bound_from_off(tokens.v, tokens.count, off);
+    if(next_token_idx != 0 && tokens.v[next_token_idx-1].range.min != off && tokens.v[next_token_idx-1].range.max > off)
+    {
+      result = Min(tokens.v[next_token_idx-1].range.max, data.size);
+    }
+    scratch_end(scratch);
+  }
+  return result;
+}
+
+internal void
+txti_buffer_append(TXTI_Buffer *buffer, String8 string, TXT_LangLexFunctionType *lex_function)
+{
+  if(buffer->chunks_count == buffer->chunks_first_idx)
+  {
+    txti_buffer_push_chunk(buffer);
+  }
+  for(String8 remaining = string; remaining.size != 0;)
+  {
+    TXTI_Chunk *tail = &buffer->chunks[buffer->chunks_count-1];
+    
+    // rjf: tail would overflow, & ends a line -> seal it & begin a new tail,
+    // unless a token crosses that line boundary, in which case the tail must
+    // stay open through the end of that token, like chunks split by reload.
+    //
+    // NOTE(rjf): an unterminated comment or string would keep the tail open
+    // forever - & every append re-lexes the whole tail - so past
+    // TXTI_CHUNK_SIZE_MAX, the tail is sealed anyways, splitting that token.
+    U64 spanning_token_opl = 0;
+    if(tail->data.size != 0 &&
+       tail->data.size + remaining.size > TXTI_CHUNK_SIZE_TARGET &&
+       tail->data.str[tail->data.size-1] == '\n')
+    {
+      if(tail->data.size < TXTI_CHUNK_SIZE_MAX)
+      {
+        spanning_token_opl = txti_chunk_spanning_token_opl_from_next_data(tail, remaining, lex_function);
+      }
+      if(spanning_token_opl == 0)
+      {
+        txti_chunk_seal(buffer, tail, lex_function);
+        tail = txti_buffer_push_chunk(buffer);
+      }
+    }
+    
+    // rjf: pick the next piece of the string - if a token is keeping the tail
+    // open, end it after the first line which ends past that token. otherwise,
+    // if it doesn't fit in the tail, end it after the last line which does, or
+    // the first line after that, so that the tail can be sealed afterwards
+    U64 room = TXTI_CHUNK_SIZE_TARGET > tail->data.size ? TXTI_CHUNK_SIZE_TARGET - tail->data.size : 0;
+    U64 piece_size = remaining.size;
+    if(spanning_token_opl != 0)
+    {
+      piece_size = spanning_token_opl - tail->data.size;
+      for(;piece_size < remaining.size && remaining.str[piece_size-1] != '\n'; piece_size += 1);
+    }
+    else if(piece_size > room)
+    {
+      piece_size = room;
+      for(;piece_size != 0 && remaining.str[piece_size-1] != '\n'; piece_size -= 1);
+      if(piece_size == 0)
+      {
+        piece_size = room;
+        for(;piece_size < remaining.size && remaining.str[piece_size] != '\n'; piece_size += 1);
+        piece_size = Min(piece_size+1, remaining.size);
+      }
+    }
+    String8 piece = str8_prefix(remaining, piece_size);
+    remaining = str8_skip(remaining, piece_size);
+    
+    // rjf: copy piece into tail
+    U8 *data_str = (U8 *)txti_array_reserve(buffer->data_arena, tail->data.str, tail->data.size, &tail->data_cap, Max(tail->data.size+piece.size, TXTI_CHUNK_SIZE_TARGET), 1);
+    MemoryCopy(data_str + tail->data.size, piece.str, piece.size);
+    tail->data.str = data_str;
+    tail->data.size += piece.size;
+  }
+  
+  // rjf: re-measure & re-lex the tail
+  TXTI_Chunk *tail = &buffer->chunks[buffer->chunks_count-1];
+  txti_chunk_measure_lines(buffer, tail, 0);
+  txti_chunk_lex(buffer, tail, lex_function);
+  
+  // rjf: bump totals
+  buffer->data_size += string.size;
+  buffer->lines_count = tail->line_idx_base + tail->lines_count - buffer->trimmed_lines_count;
+}
+
+internal void
+txti_buffer_reload(TXTI_Buffer *buffer, String8 data, TXT_LangLexFunctionType *lex_function, U64 *bytes_processed_counter)
+{
+  Temp scratch = scratch_begin(0, 0);
+  
+  //- rjf: clear old data & analysis
+  arena_clear(buffer->data_arena);
+  arena_clear(buffer->analysis_arena);
+  buffer->chunks_first_idx    = 0;
+  buffer->chunks_count        = 0;
+  buffer->chunks_cap          = 0;
+  buffer->chunks              = 0;
+  buffer->data_size           = data.size;
+  buffer->lines_count         = 0;
+  buffer->lines_max_size      = 0;
+  buffer->trimmed_data_size   = 0;
+  buffer->trimmed_lines_count = 0;
+  
+  //- rjf: copy data
+  String8 buffer_data = push_str8_copy(buffer->data_arena, data);
+  
+  //- rjf: lex whole buffer
+  TXT_TokenArray tokens = {0};
+  if(lex_function != 0) ProfScope("lex text")
+  {
+    tokens = lex_function(scratch.arena, bytes_processed_counter, buffer_data);
+  }
+  
+  //- rjf: split into chunks, ending each at the first line boundary past
+  // TXTI_CHUNK_SIZE_TARGET bytes which is not inside of a token, & measure
+  // each chunk's lines & gather its tokens
+  ProfScope("split into chunks")
+  {
+    U64 token_idx = 0;
+    for(U64 off = 0;;)
+    {
+      // rjf: find end of chunk
+      U64 opl = off + TXTI_CHUNK_SIZE_TARGET;
+      if(opl >= buffer_data.size)
+      {
+        opl = buffer_data.size;
+      }
+      for(;opl < buffer_data.size; opl += 1)
+      {
+        if(buffer_data.str[opl-1] == '\n')
+        {
+          U64 next_token_idx = txt_token_idx_upper_bound_from_off(tokens.v, tokens.count, opl);
+          if(next_token_idx == 0 || tokens.v[next_token_idx-1].range.min == opl || tokens.v[next_token_idx-1].range.max <= opl)
+          {
+            break;
+          }
+        }
+      }
+      
+      // rjf: build chunk
+      TXTI_Chunk *chunk = txti_buffer_push_chunk(buffer);
+      chunk->data = str8(buffer_data.str + off, opl - off);
+      chunk->data_cap = chunk->data.size;
+      txti_chunk_measure_lines(buffer, chunk, bytes_processed_counter);
+      
+      // rjf: gather chunk's tokens
+      U64 opl_token_idx = token_idx;
+      for(;opl_token_idx < tokens.count && tokens.v[opl_token_idx].range.min < opl; opl_token_idx += 1);
+      chunk->tokens.count = opl_token_idx - token_idx;
+      chunk->tokens_cap   = chunk->tokens.count;
+      chunk->tokens.v     = push_array_no_zero(buffer->analysis_arena, TXT_Token, chunk->tokens.count);
+      for(U64 idx = 0; idx < chunk->tokens.count; idx += 1)
+      {
+        TXT_Token *src = &tokens.v[token_idx+idx];
+        chunk->tokens.v[idx].kind  = src->kind;
+        chunk->tokens.v[idx].range = r1u64(src->range.min - off, src->range.max - off);
+      }
+      token_idx = opl_token_idx;
+      
+      // rjf: advance, sealing all chunks but the last
+      if(opl >= buffer_data.size)
+      {
+        break;
+      }
+      chunk->lines_count -= 1;
+      off = opl;
+    }
+  }
+  
+  //- rjf: fill totals
+  TXTI_Chunk *tail = &buffer->chunks[buffer->chunks_count-1];
+  buffer->lines_count = tail->line_idx_base + tail->lines_count;
+  
+  scratch_end(scratch);
+}
+
+internal void
+txti_buffer_trim(TXTI_Buffer *buffer, U64 max_data_size, U64 max_lines_count)
+{
+  // NOTE(rjf): trimming happens a whole chunk at a time, & never trims the
+  // last chunk, so buffers may stay slightly over or under their bounds.
+  for(;buffer->chunks_first_idx+1 < buffer->chunks_count;)
+  {
+    TXTI_Chunk *head = &buffer->chunks[buffer->chunks_first_idx];
+    B32 over_data_size = (max_data_size != 0 && buffer->data_size > max_data_size);
+    B32 over_lines_count = (max_lines_count != 0 && buffer->lines_count > max_lines_count);
+    if(!over_data_size && !over_lines_count)
+    {
+      break;
+    }
+    buffer->data_size           -= head->data.size;
+    buffer->lines_count         -= head->lines_count;
+    buffer->trimmed_data_size   += head->data.size;
+    buffer->trimmed_lines_count += head->lines_count;
+    buffer->chunks_first_idx    += 1;
+  }
+}
+
 ////////////////////////////////
 //~ rjf: Entities API
 
@@ -190,6 +562,7 @@ txti_buffer_info_from_handle(Arena *arena, TXTI_Handle handle)
       result.timestamp        = entity->timestamp;
       result.line_end_kind    = entity->line_end_kind;
       result.total_line_count = buffer->lines_count;
+      result.trimmed_line_count = buffer->trimmed_lines_count;
       result.max_line_size    = buffer->lines_max_size;
       result.mut_gen          = entity->mut_gen;
       result.buffer_apply_gen = entity->buffer_apply_gen;
@@ -206,7 +579,6 @@ txti_slice_from_handle_line_range(Arena *arena, TXTI_Handle handle, Rng1S64 line
 {
   ProfBeginFunction();
   TXTI_Slice result = {0};
-  Temp scratch = scratch_begin(&arena, 1);
   U64 hash = handle.u64[0];
   U64 id = handle.u64[1];
   U64 slot_idx = hash%txti_state->entity_map.slots_count;
@@ -230,104 +602,74 @@ txti_slice_from_handle_line_range(Arena *arena, TXTI_Handle handle, Rng1S64 line
       Rng1S64 line_range_clamped = r1s64(Clamp(1, line_range.min, (S64)buffer->lines_count), Clamp(1, line_range.max, (S64)buffer->lines_count));
       
       // rjf: allocate output arrays
+      result.trimmed_line_count = buffer->trimmed_lines_count;
       result.line_count = (U64)dim_1s64(line_range_clamped)+1;
       result.line_text = push_array(arena, String8, result.line_count);
       result.line_ranges = push_array(arena, Rng1U64, result.line_count);
       result.line_tokens = push_array(arena, TXT_TokenArray, result.line_count);
       
-      // rjf: fill line ranges & text
+      // rjf: fill line ranges, text, & tokens, from each chunk overlapping
+      // the range
       U64 line_slice_idx = 0;
-      U64 line_buffer_idx = line_range_clamped.min-1;
-      ProfScope("fill line ranges & text")
-        for(S64 line_num = line_range_clamped.min;
-            line_num <= line_range_clamped.max && line_buffer_idx < buffer->lines_count;
-            line_num += 1,
+      U64 line_buffer_idx = buffer->trimmed_lines_count + (U64)line_range_clamped.min-1;
+      ProfScope("fill line ranges, text, & tokens")
+        for(U64 chunk_idx = txti_chunk_idx_from_buffer_line_idx(buffer, line_buffer_idx);
+            chunk_idx < buffer->chunks_count && line_slice_idx < result.line_count;
+            chunk_idx += 1)
+      {
+        TXTI_Chunk *chunk = &buffer->chunks[chunk_idx];
+        U64 chunk_off = chunk->off - buffer->trimmed_data_size;
+        U64 chunk_line_idx = line_buffer_idx - chunk->line_idx_base;
+        if(chunk_line_idx >= chunk->lines_count)
+        {
+          continue;
+        }
+        
+        // rjf: binary search to find first token - the first one ending past
+        // the first line's start
+        U64 token_idx = txt_token_idx_upper_bound_from_off(chunk->tokens.v, chunk->tokens.count, chunk->lines_ranges[chunk_line_idx].min);
+        for(;token_idx != 0 && chunk->tokens.v[token_idx-1].range.max > chunk->lines_ranges[chunk_line_idx].min;)
+        {
+          token_idx -= 1;
+        }
+        
+        // rjf: fill lines - each line's tokens are the run which starts with
+        // the first token ending past the line's start, & ends with the last
+        // one starting before its end. tokens spanning lines start the next run.
+        for(;chunk_line_idx < chunk->lines_count && line_slice_idx < result.line_count;
+            chunk_line_idx += 1,
             line_slice_idx += 1,
             line_buffer_idx += 1)
-      {
-        Rng1U64 range = buffer->lines_ranges[line_buffer_idx];
-        String8 line_text_internal = str8_substr(buffer->data, range);
-        result.line_ranges[line_slice_idx] = range;
-        result.line_text[line_slice_idx] = push_str8_copy(arena, line_text_internal);
-      }
-      
-      // rjf: binary search to find first token
-      TXT_Token *tokens_first = 0;
-      ProfScope("binary search to find first token")
-      {
-        Rng1U64 slice_range = r1u64(result.line_ranges[0].min, result.line_ranges[result.line_count-1].max);
-        U64 min_idx = 0;
-        U64 opl_idx = buffer->tokens.count;
-        for(;;)
         {
-          U64 mid_idx = (opl_idx+min_idx)/2;
-          if(mid_idx >= opl_idx)
-          {
-            break;
-          }
-          TXT_Token *mid_token = &buffer->tokens.v[mid_idx];
-          if(mid_token->range.min > slice_range.max)
+          Rng1U64 range = chunk->lines_ranges[chunk_line_idx];
+          result.line_ranges[line_slice_idx] = r1u64(chunk_off + range.min, chunk_off + range.max);
+          result.line_text[line_slice_idx] = push_str8_copy(arena, str8_substr(chunk->data, range));
+          for(;token_idx < chunk->tokens.count && chunk->tokens.v[token_idx].range.max <= range.min;)
           {
-            opl_idx = mid_idx;
+            token_idx += 1;
           }
-          else if(mid_token->range.max < slice_range.min)
+          U64 opl_token_idx = token_idx;
+          for(;opl_token_idx < chunk->tokens.count && chunk->tokens.v[opl_token_idx].range.min < range.max;)
           {
-            min_idx = mid_idx;
+            opl_token_idx += 1;
           }
-          else if(tokens_first == 0 || mid_token->range.min < tokens_first->range.min)
+          TXT_TokenArray *line_tokens = &result.line_tokens[line_slice_idx];
+          line_tokens->count = opl_token_idx - token_idx;
+          line_tokens->v = push_array_no_zero(arena, TXT_Token, line_tokens->count);
+          for(U64 idx = 0; idx < line_tokens->count; idx += 1)
           {
-            tokens_first = mid_token;
-            opl_idx = mid_idx;
+            TXT_Token *src = &chunk->tokens.v[token_idx+idx];
+            line_tokens->v[idx].kind  = src->kind;
+            line_tokens->v[idx].range = r1u64(chunk_off + src->range.min, chunk_off + src->range.max);
           }
-          if(mid_idx == min_idx && mid_idx+1 == opl_idx)
+          if(opl_token_idx != token_idx)
           {
-            break;
+            token_idx = opl_token_idx-1;
           }
         }
       }
-      
-      // rjf: grab per-line tokens
-      TXT_TokenList *line_tokens_lists = push_array(scratch.arena, TXT_TokenList, result.line_count);
-      if(tokens_first != 0) ProfScope("grab per-line tokens")
-      {
-        TXT_Token *tokens_opl = buffer->tokens.v+buffer->tokens.count;
-        U64 line_slice_idx = 0;
-        for(TXT_Token *token = tokens_first; token < tokens_opl && line_slice_idx < result.line_count;)
-        {
-          if(token->range.min < result.line_ranges[line_slice_idx].max)
-          {
-            if(token->range.max > result.line_ranges[line_slice_idx].min)
-            {
-              txt_token_list_push(scratch.arena, &line_tokens_lists[line_slice_idx], token);
-            }
-            B32 need_token_advance = 0;
-            B32 need_line_advance = 0;
-            if(token->range.max >= result.line_ranges[line_slice_idx].max)
-            {
-              need_line_advance = 1;
-            }
-            if(token->range.max <= result.line_ranges[line_slice_idx].max)
-            {
-              need_token_advance += 1;
-            }
-            if(need_line_advance) { line_slice_idx += 1; }
-            if(need_token_advance) { token += 1; }
-          }
-          else
-          {
-            line_slice_idx += 1;
-          }
-        }
-      }
-      
-      // rjf: bake per-line tokens to arrays
-      for(U64 line_slice_idx = 0; line_slice_idx < result.line_count; line_slice_idx += 1)
-      {
-        result.line_tokens[line_slice_idx] = txt_token_array_from_list(arena, &line_tokens_lists[line_slice_idx]);
-      }
     }
   }
-  scratch_end(scratch);
   ProfEnd();
   return result;
 }
@@ -509,6 +851,100 @@ txti_expr_range_from_handle_pt(TXTI_Handle handle, TxtPt pt)
   return result;
 }
 
+internal TxtPt
+txti_match_pt_from_handle_pt_needle_flags(TXTI_Handle handle, U64 trimmed_line_count, TxtPt pt, Side side, String8 needle, TXT_SearchFlags flags)
+{
+  // NOTE(rjf): line numbers of `pt` & the result count from the first line
+  // after `trimmed_line_count` trimmed lines, so that callers can keep the
+  // numbering of the last slice they read, even if lines were trimmed since.
+  // matches never span chunks - as chunks end with a '\n', this only matters
+  // for needles which contain line breaks.
+  ProfBeginFunction();
+  TxtPt result = {0};
+  U64 hash = handle.u64[0];
+  U64 id = handle.u64[1];
+  U64 slot_idx = hash%txti_state->entity_map.slots_count;
+  U64 stripe_idx = slot_idx%txti_state->entity_map_stripes.count;
+  TXTI_EntitySlot *slot = &txti_state->entity_map.slots[slot_idx];
+  TXTI_Stripe *stripe = &txti_state->entity_map_stripes.v[stripe_idx];
+  OS_MutexScopeR(stripe->rw_mutex)
+  {
+    TXTI_Entity *entity = 0;
+    for(TXTI_Entity *e = slot->first; e != 0; e = e->next)
+    {
+      if(e->id == id)
+      {
+        entity = e;
+        break;
+      }
+    }
+    TXTI_Buffer *buffer = entity ? &entity->buffers[entity->buffer_apply_gen%TXTI_ENTITY_BUFFER_COUNT] : 0;
+    if(buffer != 0 && buffer->chunks_first_idx < buffer->chunks_count && buffer->lines_count != 0 && needle.size != 0)
+    {
+      //- rjf: find the chunk & offset of the starting point
+      U64 pt_line_idx = trimmed_line_count + (U64)ClampBot(1, pt.line) - 1;
+      pt_line_idx = Clamp(buffer->trimmed_lines_count, pt_line_idx, buffer->trimmed_lines_count + buffer->lines_count - 1);
+      U64 pt_chunk_idx = txti_chunk_idx_from_buffer_line_idx(buffer, pt_line_idx);
+      TXTI_Chunk *pt_chunk = &buffer->chunks[pt_chunk_idx];
+      Rng1U64 pt_line_range = pt_chunk->lines_ranges[pt_line_idx - pt_chunk->line_idx_base];
+      U64 pt_off = Min(pt_line_range.min + (U64)ClampBot(1, pt.column) - 1, pt_line_range.max);
+      
+      //- rjf: search each chunk, in the search direction, from the starting
+      // point - wrapping around the buffer, & back into the starting chunk.
+      // forward matches start after the starting point; backward matches end
+      // at or before it.
+      U64 chunks_count = buffer->chunks_count - buffer->chunks_first_idx;
+      for(U64 step = 0; step <= chunks_count; step += 1)
+      {
+        U64 chunk_step = (side == Side_Max) ? step : chunks_count - step;
+        U64 chunk_idx = buffer->chunks_first_idx + (pt_chunk_idx - buffer->chunks_first_idx + chunk_step) % chunks_count;
+        TXTI_Chunk *chunk = &buffer->chunks[chunk_idx];
+        String8 data = chunk->data;
+        U64 match_off = data.size;
+        if(side == Side_Max)
+        {
+          Rng1U64 range = r1u64(0, data.size);
+          if(step == 0)
+          {
+            range.min = pt_off+1;
+          }
+          if(step == chunks_count)
+          {
+            range.max = pt_off+1;
+          }
+          match_off = txt_search_match_off_from_data_range_needle_flags(data, range, needle, flags);
+        }
+        else
+        {
+          Rng1U64 range = r1u64(0, data.size);
+          if(step == 0)
+          {
+            data = str8_prefix(data, pt_off);
+            range.max = data.size;
+          }
+          if(step == chunks_count)
+          {
+            range.min = (pt_off+1 > needle.size) ? pt_off+1 - needle.size : 0;
+          }
+          match_off = txt_search_last_match_off_from_data_range_needle_flags(data, range, needle, flags);
+        }
+        if(match_off < data.size)
+        {
+          U64 line_idx = txti_chunk_line_idx_from_off(chunk, match_off);
+          S64 line_num = (S64)(chunk->line_idx_base + line_idx) - (S64)trimmed_line_count + 1;
+          if(line_num >= 1)
+          {
+            result = txt_pt(line_num, 1 + (S64)(match_off - chunk->lines_ranges[line_idx].min));
+          }
+          break;
+        }
+      }
+    }
+  }
+  ProfEnd();
+  return result;
+}
+
 //- rjf: buffer mutations
 
 internal void
@@ -551,6 +987,48 @@ txti_append(TXTI_Handle handle, String8 string)
   os_condition_variable_broadcast(mut_thread->msg_cv);
 }
 
+//- rjf: buffer bounds
+
+internal void
+txti_set_buffer_bounds(TXTI_Handle handle, U64 max_data_size, U64 max_lines_count)
+{
+  U64 hash = handle.u64[0];
+  U64 id = handle.u64[1];
+  U64 slot_idx = hash%txti_state->entity_map.slots_count;
+  U64 stripe_idx = slot_idx%txti_state->entity_map_stripes.count;
+  TXTI_EntitySlot *slot = &txti_state->entity_map.slots[slot_idx];
+  TXTI_Stripe *stripe = &txti_state->entity_map_stripes.v[stripe_idx];
+  
+  // rjf: determine if bounds are changing (shared lock)
+  B32 needs_change = 0;
+  OS_MutexScopeR(stripe->rw_mutex)
+  {
+    for(TXTI_Entity *e = slot->first; e != 0; e = e->next)
+    {
+      if(e->id == id)
+      {
+        needs_change = (e->max_data_size != max_data_size || e->max_lines_count != max_lines_count);
+        break;
+      }
+    }
+  }
+  
+  // rjf: bounds are changing -> exclusive lock & store - they apply with the
+  // next edit
+  if(needs_change) OS_MutexScopeW(stripe->rw_mutex)
+  {
+    for(TXTI_Entity *e = slot->first; e != 0; e = e->next)
+    {
+      if(e->id == id)
+      {
+        e->max_data_size = max_data_size;
+        e->max_lines_count = max_lines_count;
+        break;
+      }
+    }
+  }
+}
+
 //- rjf: buffer external change detection enabling/disabling
 
 internal void
@@ -627,31 +1105,13 @@ txti_mut_thread_entry_point(void *p)
       TXT_LineEndKind line_end_kind = TXT_LineEndKind_Null;
       if(load_valid)
       {
-        U64 lf_count = 0;
-        U64 cr_count = 0;
-        for(U64 idx = 0; idx < file_contents.size && idx < 1024; idx += 1)
-        {
-          if(file_contents.str[idx] == '\r')
-          {
-            cr_count += 1;
-          }
-          if(file_contents.str[idx] == '\n')
-          {
-            lf_count += 1;
-          }
-        }
-        if(cr_count >= lf_count/2 && lf_count >= 1)
-        {
-          line_end_kind = TXT_LineEndKind_CRLF;
-        }
-        else if(lf_count >= 1)
-        {
-          line_end_kind = TXT_LineEndKind_LF;
-        }
+        line_end_kind = txt_line_end_kind_from_counts(txt_line_end_counts_from_data(0, file_contents));
       }
       
       //- rjf: obtain initial buffer_apply_gen, reset byte processing counters
       U64 initial_buffer_apply_gen = 0;
+      U64 max_data_size = 0;
+      U64 max_lines_count = 0;
       ProfScope("obtain initial buffer_apply_gen") OS_MutexScopeR(stripe->rw_mutex)
       {
         TXTI_Entity *entity = 0;
@@ -666,6 +1126,12 @@ txti_mut_thread_entry_point(void *p)
         if(entity != 0)
         {
           initial_buffer_apply_gen = entity->buffer_apply_gen;
+          max_data_size = entity->max_data_size;
+          max_lines_count = entity->max_lines_count;
+          if(msg->kind == TXTI_MsgKind_Append)
+          {
+            lex_function = txt_lex_function_from_lang_kind(entity->lang_kind);
+          }
           if(msg->kind == TXTI_MsgKind_Reload)
           {
             ins_atomic_u64_eval_assign(&entity->bytes_processed, 0);
@@ -740,99 +1206,29 @@ txti_mut_thread_entry_point(void *p)
             {
               TXTI_Buffer *buffer = &entity->buffers[(initial_buffer_apply_gen+1+buffer_apply_idx)%TXTI_ENTITY_BUFFER_COUNT];
               
-              // rjf: clear old analysis data
-              arena_clear(buffer->analysis_arena);
-              buffer->lines_count = 0;
-              buffer->lines_ranges = 0;
-              buffer->lines_max_size = 0;
-              MemoryZeroStruct(&buffer->tokens);
-              
-              // rjf: perform edit to buffer data
+              // rjf: perform edit to buffer - appends only touch the last
+              // chunk, reloads rebuild all chunks
               switch(msg->kind)
               {
                 default:{}break;
                 
-                // rjf: replace range
+                // rjf: append to end
                 case TXTI_MsgKind_Append: ProfScope("append")
                 {
-                  U8 *append_data_buffer = push_array_no_zero(buffer->data_arena, U8, msg->string.size);
-                  MemoryCopy(append_data_buffer, msg->string.str, msg->string.size);
-                  buffer->data.size += msg->string.size;
-                  if(buffer->data.str == 0 && msg->string.size != 0)
-                  {
-                    buffer->data.str = append_data_buffer;
-                  }
+                  txti_buffer_append(buffer, msg->string, lex_function);
                 }break;
                 
                 // rjf: reload from disk
                 case TXTI_MsgKind_Reload: ProfScope("reload")
                 {
-                  arena_clear(buffer->data_arena);
-                  if(file_contents.size != 0)
-                  {
-                    buffer->data = push_str8_copy(buffer->data_arena, file_contents);
-                  }
-                  else
-                  {
-                    MemoryZeroStruct(&buffer->data);
-                  }
+                  txti_buffer_reload(buffer, file_contents, lex_function, buffer_apply_idx == 0 ? &entity->bytes_processed : 0);
                 }break;
               }
               
-              // rjf: parse & store line range info
-              ProfScope("parse & store line range info")
-              {
-                // rjf: count # of lines
-                U64 line_count = 1;
-                U64 byte_process_start_idx = 0;
-                for(U64 idx = 0; idx < buffer->data.size; idx += 1)
-                {
-                  if(buffer_apply_idx == 0 && idx-byte_process_start_idx >= 1000)
-                  {
-                    ins_atomic_u64_add_eval(&entity->bytes_processed, (idx-byte_process_start_idx));
-                    byte_process_start_idx = idx;
-                  }
-                  if(buffer->data.str[idx] == '\n' || buffer->data.str[idx] == '\r')
-                  {
-                    line_count += 1;
-                    if(buffer->data.str[idx] == '\r')
-                    {
-                      idx += 1;
-                    }
-                  }
-                }
-                
-                // rjf: allocate & store line ranges
-                ProfScope("allocate & store line ranges")
-                {
-                  buffer->lines_count = line_count;
-                  buffer->lines_ranges = push_array_no_zero(buffer->analysis_arena, Rng1U64, buffer->lines_count);
-                  U64 line_idx = 0;
-                  U64 line_start_idx = 0;
-                  for(U64 idx = 0; idx <= buffer->data.size; idx += 1)
-                  {
-                    if(idx == buffer->data.size || buffer->data.str[idx] == '\n' || buffer->data.str[idx] == '\r')
-                    {
-                      Rng1U64 line_range = r1u64(line_start_idx, idx);
-                      U64 line_size = dim_1u64(line_range);
-                      buffer->lines_ranges[line_idx] = line_range;
-                      buffer->lines_max_size = Max(buffer->lines_max_size, line_size);
-                      line_idx += 1;
-                      line_start_idx = idx+1;
-                      if(idx < buffer->data.size && buffer->data.str[idx] == '\r')
-                      {
-                        line_start_idx += 1;
-                        idx += 1;
-                      }
-                    }
-                  }
-                }
-              }
-              
-              // rjf: lex file contents
-              if(lex_function != 0) ProfScope("lex text")
+              // rjf: trim to bounds
+              if(max_data_size != 0 || max_lines_count != 0)
               {
-                buffer->tokens = lex_function(buffer->analysis_arena, buffer_apply_idx == 0 ? &entity->bytes_processed : 0, buffer->data);
+                txti_buffer_trim(buffer, max_data_size, max_lines_count);
               }
               
               // rjf: mark final process counter
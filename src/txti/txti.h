@@ -42,6 +42,22 @@
 // any edits are made to slot 0, the viewable buffer is changed to being within
 // slot *1*.
 //
+// Each buffer's text is stored as an array of chunks (`TXTI_Chunk`) -- a
+// flat rope. Every chunk but the last holds a run of whole lines, ending with
+// a '\n', & owns the line ranges & tokens for that run (relative to the
+// chunk's start). Appends only copy, measure, & lex the last chunk, sealing it
+// & beginning a new one when it grows past `TXTI_CHUNK_SIZE_TARGET` (at a line
+// boundary which no token crosses, as with reloads, unless an unterminated
+// token has kept it open past `TXTI_CHUNK_SIZE_MAX`), & slices only read the
+// chunks which overlap the requested lines.
+//
+// Entities may also be bounded to a maximum size & line count, for
+// high-volume logs, in which case they behave as ring buffers. After each
+// edit, whole chunks are trimmed from the head until the buffer fits. Chunks
+// keep their original offsets & line indices, & the buffer counts what it has
+// trimmed, so trimming never touches the remaining chunks; the trimmed line
+// count is reported so that users can keep line numbering stable.
+//
 // Importantly, entities map to a *unique* mutator thread -- it is not possible
 // for multiple mutator threads to be attempting to write to the same entity at
 // the same time, as this could not produce meaningful or coherent results.
@@ -60,6 +76,30 @@ struct TXTI_Handle
 //~ rjf: Buffer Entity Types
 
 #define TXTI_ENTITY_BUFFER_COUNT 2
+#define TXTI_CHUNK_SIZE_TARGET KB(64)
+#define TXTI_CHUNK_SIZE_MAX    (4*TXTI_CHUNK_SIZE_TARGET)
+
+typedef struct TXTI_Chunk TXTI_Chunk;
+struct TXTI_Chunk
+{
+  // rjf: placement within buffer
+  U64 off;
+  U64 line_idx_base;
+  
+  // rjf: raw textual data
+  String8 data;
+  U64 data_cap;
+  
+  // rjf: line range info (chunk-relative)
+  U64 lines_count;
+  U64 lines_cap;
+  Rng1U64 *lines_ranges;
+  U64 lines_max_size;
+  
+  // rjf: tokens (chunk-relative)
+  TXT_TokenArray tokens;
+  U64 tokens_cap;
+};
 
 typedef struct TXTI_Buffer TXTI_Buffer;
 struct TXTI_Buffer
@@ -68,16 +108,21 @@ struct TXTI_Buffer
   Arena *data_arena;
   Arena *analysis_arena;
   
-  // rjf: raw textual data
-  String8 data;
+  // rjf: chunks - [chunks_first_idx, chunks_count) are live, the rest
+  // have been trimmed, & keep their storage for reuse
+  U64 chunks_first_idx;
+  U64 chunks_count;
+  U64 chunks_cap;
+  TXTI_Chunk *chunks;
   
-  // rjf: line range info
+  // rjf: totals (live)
+  U64 data_size;
   U64 lines_count;
-  Rng1U64 *lines_ranges;
   U64 lines_max_size;
   
-  // rjf: tokens
-  TXT_TokenArray tokens;
+  // rjf: totals (trimmed from head)
+  U64 trimmed_data_size;
+  U64 trimmed_lines_count;
 };
 
 typedef struct TXTI_Entity TXTI_Entity;
@@ -97,6 +142,10 @@ struct TXTI_Entity
   U64 bytes_to_process;
   U64 working_count;
   
+  // rjf: ring buffer bounds (0 -> unbounded)
+  U64 max_data_size;
+  U64 max_lines_count;
+  
   // rjf: double-buffered mutable text buffers
   U64 buffer_apply_gen;
   TXTI_Buffer buffers[TXTI_ENTITY_BUFFER_COUNT];
@@ -145,6 +194,7 @@ struct TXTI_BufferInfo
   TXT_LineEndKind line_end_kind;
   TXT_LangKind lang_kind;
   U64 total_line_count;
+  U64 trimmed_line_count;
   U64 last_line_size;
   U64 max_line_size;
   U64 mut_gen;
@@ -156,6 +206,7 @@ struct TXTI_BufferInfo
 typedef struct TXTI_Slice TXTI_Slice;
 struct TXTI_Slice
 {
+  U64 trimmed_line_count;
   U64 line_count;
   String8 *line_text;
   Rng1U64 *line_ranges;
@@ -252,6 +303,20 @@ internal void txti_msg_list_push(Arena *arena, TXTI_MsgList *msgs, TXTI_Msg *msg
 internal void txti_msg_list_concat_in_place(TXTI_MsgList *dst, TXTI_MsgList *src);
 internal TXTI_MsgList txti_msg_list_deep_copy(Arena *arena, TXTI_MsgList *src);
 
+////////////////////////////////
+//~ rjf: Buffer Chunk Functions
+
+internal void *txti_array_reserve(Arena *arena, void *v, U64 count, U64 *cap, U64 needed_cap, U64 element_size);
+internal TXTI_Chunk *txti_buffer_push_chunk(TXTI_Buffer *buffer);
+internal U64 txti_chunk_idx_from_buffer_line_idx(TXTI_Buffer *buffer, U64 line_idx);
+internal U64 txti_chunk_line_idx_from_off(TXTI_Chunk *chunk, U64 off);
+internal void txti_chunk_measure_lines(TXTI_Buffer *buffer, TXTI_Chunk *chunk, U64 *bytes_processed_counter);
+internal void txti_chunk_lex(TXTI_Buffer *buffer, TXTI_Chunk *chunk, TXT_LangLexFunctionType *lex_function);
+internal void txti_chunk_seal(TXTI_Buffer *buffer, TXTI_Chunk *chunk, TXT_LangLexFunctionType *lex_function);
+internal void txti_buffer_append(TXTI_Buffer *buffer, String8 string, TXT_LangLexFunctionType *lex_function);
+internal void txti_buffer_reload(TXTI_Buffer *buffer, String8 data, TXT_LangLexFunctionType *lex_function, U64 *bytes_processed_counter);
+internal void txti_buffer_trim(TXTI_Buffer *buffer, U64 max_data_size, U64 max_lines_count);
+
 ////////////////////////////////
 //~ rjf: Entities API
 
@@ -265,11 +330,15 @@ internal String8 txti_string_from_handle_txt_rng(Arena *arena, TXTI_Handle handl
 internal String8 txti_string_from_handle_line_num(Arena *arena, TXTI_Handle handle, S64 line_num);
 internal Rng1U64 txti_expr_range_from_line_off_range_string_tokens(U64 off, Rng1U64 line_range, String8 line_text, TXT_TokenArray *line_tokens);
 internal TxtRng txti_expr_range_from_handle_pt(TXTI_Handle handle, TxtPt pt);
+internal TxtPt txti_match_pt_from_handle_pt_needle_flags(TXTI_Handle handle, U64 trimmed_line_count, TxtPt pt, Side side, String8 needle, TXT_SearchFlags flags);
 
 //- rjf: buffer mutations
 internal void txti_reload(TXTI_Handle handle, String8 path);
 internal void txti_append(TXTI_Handle handle, String8 string);
 
+//- rjf: buffer bounds
+internal void txti_set_buffer_bounds(TXTI_Handle handle, U64 max_data_size, U64 max_lines_count);
+
 //- rjf: buffer external change detection enabling/disabling
 internal void txti_set_external_change_detection_enabled(B32 enabled);
 